@@ -8,6 +8,8 @@
 
 #include "structural_simulation_class.h"
 
+#include <tbb/task_arena.h>
+
 ////////////////////////////////////////////////////
 /* global functions in StructuralSimulation  */
 ////////////////////////////////////////////////////
@@ -31,6 +33,16 @@ SolidBodyFromMesh::SolidBodyFromMesh(
     generateParticles<ParticleGeneratorLattice>();
 }
 
+SolidBodyFromMesh::SolidBodyFromMesh(
+    SPHSystem &system, SharedPtr<LevelSetShape> level_set_shape, Real resolution,
+    SharedPtr<SaintVenantKirchhoffSolid> material_model)
+    : SolidBody(system, level_set_shape)
+{
+    defineAdaptationRatios(1.15, system.resolution_ref_ / resolution);
+    defineParticlesWithMaterial<ElasticSolidParticles>(material_model.get());
+    generateParticles<ParticleGeneratorLattice>();
+}
+
 SolidBodyForSimulation::SolidBodyForSimulation(
     SPHSystem &system, SharedPtr<TriangleMeshShape> triangle_mesh_shape, Real resolution,
     Real physical_viscosity, SharedPtr<SaintVenantKirchhoffSolid> material_model, StdLargeVec<Vecd> &pos_0, StdLargeVec<Real> &volume)
@@ -46,6 +58,21 @@ SolidBodyForSimulation::SolidBodyForSimulation(
     std::cout << "  normal initialization done" << std::endl;
 }
 
+SolidBodyForSimulation::SolidBodyForSimulation(
+    SPHSystem &system, SharedPtr<LevelSetShape> level_set_shape, Real resolution,
+    Real physical_viscosity, SharedPtr<SaintVenantKirchhoffSolid> material_model)
+    : solid_body_from_mesh_(system, level_set_shape, resolution, material_model),
+      inner_body_relation_(solid_body_from_mesh_),
+      initial_normal_direction_(SimpleDynamics<NormalDirectionFromBodyShape>(solid_body_from_mesh_)),
+      correct_configuration_(inner_body_relation_),
+      stress_relaxation_first_half_(inner_body_relation_),
+      stress_relaxation_second_half_(inner_body_relation_),
+      damping_random_(0.2, inner_body_relation_, "Velocity", physical_viscosity)
+{
+    initial_normal_direction_.exec();
+    std::cout << "  normal initialization done" << std::endl;
+}
+
 void expandBoundingBox(BoundingBox *original, BoundingBox *additional)
 {
     for (int i = 0; i < original->first_.size(); i++)
@@ -124,6 +151,17 @@ std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>> generateAndRelaxParticlesFromMe
     return std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>>(model.getBaseParticles().pos_, model.getBaseParticles().Vol_);
 }
 
+SharedPtr<TriangleMeshShape> createBodyMeshFromStl(const std::string &relative_input_path, const StlList &stl_list,
+                                                   size_t body_index, const Vec3d &translation, Real scale_stl)
+{
+    std::string relative_input_path_copy = relative_input_path;
+#ifdef __EMSCRIPTEN__
+    return makeShared<TriangleMeshShapeSTL>(reinterpret_cast<const uint8_t *>(stl_list[body_index].ptr), translation, scale_stl, stl_list[body_index].name);
+#else
+    return makeShared<TriangleMeshShapeSTL>(relative_input_path_copy.append(stl_list[body_index]), translation, scale_stl, stl_list[body_index]);
+#endif
+}
+
 BodyPartByParticle *createBodyPartFromMesh(SPHBody &body, const StlList &stl_list, size_t body_index, SharedPtr<TriangleMeshShape> tmesh)
 {
 #ifdef __EMSCRIPTEN__
@@ -177,11 +215,65 @@ StructuralSimulationInput::StructuralSimulationInput(
     translation_solid_body_part_tuple_ = {};
 };
 
+///////////////////////////////////////////////
+/* StructuralSimulationGeometry members */
+///////////////////////////////////////////////
+
+StructuralSimulationGeometry::StructuralSimulationGeometry(const StructuralSimulationInput &input)
+    : input_(input), system_resolution_(0.0)
+{
+    // the same scaling and system resolution as in StructuralSimulation
+    for (size_t i = 0; i < input_.resolution_list_.size(); i++)
+    {
+        system_resolution_ = SMAX(system_resolution_, input_.resolution_list_[i] * input_.scale_stl_);
+    }
+    for (size_t i = 0; i < input_.imported_stl_list_.size(); i++)
+    {
+        Real resolution = input_.resolution_list_[i] * input_.scale_stl_;
+        body_mesh_list_.push_back(createBodyMeshFromStl(input_.relative_input_path_, input_.imported_stl_list_, i,
+                                                        input_.translation_list_[i] * input_.scale_stl_, input_.scale_stl_));
+        // the same adaptation as that of SolidBodyFromMesh
+        SharedPtr<SPHAdaptation> sph_adaptation = makeShared<SPHAdaptation>(system_resolution_, 1.15, system_resolution_ / resolution);
+        level_set_shape_list_.push_back(makeShared<LevelSetShape>(*body_mesh_list_[i], sph_adaptation));
+        level_set_shape_list_[i]->cleanLevelSet();
+    }
+}
+
+bool StructuralSimulationGeometry::isCompatible(const StructuralSimulationInput &input)
+{
+    if (input.imported_stl_list_.size() != input_.imported_stl_list_.size())
+        return false;
+    for (size_t i = 0; i < input.imported_stl_list_.size(); i++)
+    {
+#ifdef __EMSCRIPTEN__
+        if (input.imported_stl_list_[i].ptr != input_.imported_stl_list_[i].ptr)
+            return false;
+#else
+        if (input.imported_stl_list_[i] != input_.imported_stl_list_[i])
+            return false;
+#endif
+    }
+    return input.relative_input_path_ == input_.relative_input_path_ &&
+           input.scale_stl_ == input_.scale_stl_ &&
+           input.translation_list_ == input_.translation_list_ &&
+           input.resolution_list_ == input_.resolution_list_;
+}
+
 ///////////////////////////////////////
 /* StructuralSimulation members */
 ///////////////////////////////////////
 
 StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &input)
+    : StructuralSimulation(input, nullptr, ".") {}
+
+StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &input, StructuralSimulationGeometry &shared_geometry,
+                                           const std::string &root_folder)
+    : StructuralSimulation(input, &shared_geometry, root_folder)
+{
+}
+
+StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &input, StructuralSimulationGeometry *shared_geometry,
+                                           const std::string &root_folder)
     : // generic input
       relative_input_path_(input.relative_input_path_),
       imported_stl_list_(input.imported_stl_list_),
@@ -196,10 +288,11 @@ StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &inpu
       // default system, optional: particle relaxation, scale_system_boundaries
       particle_relaxation_list_(input.particle_relaxation_list_),
       write_particle_relaxation_data_(input.write_particle_relaxation_data_),
+      shared_geometry_(shared_geometry),
       system_resolution_(0.0),
       system_(SPHSystem(BoundingBox(Vec3d::Zero(), Vec3d::Zero()), system_resolution_)),
       scale_system_boundaries_(input.scale_system_boundaries_),
-      io_environment_(system_),
+      io_environment_(system_, root_folder, true),
 
       // optional: boundary conditions
       non_zero_gravity_(input.non_zero_gravity_),
@@ -304,15 +397,16 @@ void StructuralSimulation::calculateSystemBoundaries()
 
 void StructuralSimulation::createBodyMeshList()
 {
+    if (shared_geometry_ != nullptr)
+    {
+        body_mesh_list_ = shared_geometry_->body_mesh_list_;
+        return;
+    }
+
     body_mesh_list_ = {};
     for (size_t i = 0; i < imported_stl_list_.size(); i++)
     {
-        std::string relative_input_path_copy = relative_input_path_;
-#ifdef __EMSCRIPTEN__
-        body_mesh_list_.push_back(makeShared<TriangleMeshShapeSTL>(reinterpret_cast<const uint8_t *>(imported_stl_list_[i].ptr), translation_list_[i], scale_stl_, imported_stl_list_[i].name));
-#else
-        body_mesh_list_.push_back(makeShared<TriangleMeshShapeSTL>(relative_input_path_copy.append(imported_stl_list_[i]), translation_list_[i], scale_stl_, imported_stl_list_[i]));
-#endif
+        body_mesh_list_.push_back(createBodyMeshFromStl(relative_input_path_, imported_stl_list_, i, translation_list_[i], scale_stl_));
     }
 }
 
@@ -330,17 +424,26 @@ void StructuralSimulation::initializeElasticSolidBodies()
 #endif // __EMSCRIPTEN__
        // we delete the .stl ending
         temp_name.erase(temp_name.size() - 4);
-        // create the initial particles from the triangle mesh shape with particle relaxation option
-        std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>> particles =
-            generateAndRelaxParticlesFromMesh(body_mesh_list_[i], resolution_list_[i], particle_relaxation_list_[i], write_particle_relaxation_data_);
+        if (shared_geometry_ != nullptr)
+        {
+            // the level set is already built in the shared geometry
+            solid_body_list_.emplace_back(makeShared<SolidBodyForSimulation>(
+                system_, shared_geometry_->level_set_shape_list_[i], resolution_list_[i], physical_viscosity_[i], material_model_list_[i]));
+        }
+        else
+        {
+            // create the initial particles from the triangle mesh shape with particle relaxation option
+            std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>> particles =
+                generateAndRelaxParticlesFromMesh(body_mesh_list_[i], resolution_list_[i], particle_relaxation_list_[i], write_particle_relaxation_data_);
 
-        // get the particles' initial position and their volume
-        StdLargeVec<Vecd> &pos_0 = std::get<0>(particles);
-        StdLargeVec<Real> &volume = std::get<1>(particles);
+            // get the particles' initial position and their volume
+            StdLargeVec<Vecd> &pos_0 = std::get<0>(particles);
+            StdLargeVec<Real> &volume = std::get<1>(particles);
 
-        // create the SolidBodyForSimulation
-        solid_body_list_.emplace_back(makeShared<SolidBodyForSimulation>(
-            system_, body_mesh_list_[i], resolution_list_[i], physical_viscosity_[i], material_model_list_[i], pos_0, volume));
+            // create the SolidBodyForSimulation
+            solid_body_list_.emplace_back(makeShared<SolidBodyForSimulation>(
+                system_, body_mesh_list_[i], resolution_list_[i], physical_viscosity_[i], material_model_list_[i], pos_0, volume));
+        }
 
         // update normal direction of particles
         particle_normal_update_.emplace_back(makeShared<SimpleDynamics<solid_dynamics::UpdateElasticNormalDirection>>(*solid_body_list_[i]->getSolidBodyFromMesh()));
@@ -1004,3 +1107,144 @@ VtuStringData StructuralSimulationJS::getVtuData()
     write_states_.clear();
     return vtuData;
 }
+
+///////////////////////////////////////////////
+/* StructuralSimulationBatch members */
+///////////////////////////////////////////////
+
+StructuralSimulationBatch::StructuralSimulationBatch(const StructuralSimulationInput &geometry_input)
+    : geometry_(geometry_input)
+{
+}
+
+void StructuralSimulationBatch::addCase(const std::string &case_name, const StructuralSimulationInput &input)
+{
+    if (!geometry_.isCompatible(input))
+    {
+        std::cout << "\n Error: the geometric input of the case " << case_name << " differs from that of the batch!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    case_names_.push_back(case_name);
+    case_inputs_.push_back(input);
+}
+
+StdVec<Real> StructuralSimulationBatch::runCase(size_t case_index, Real end_time, int number_of_threads, const std::string &case_folder)
+{
+    StdVec<Real> result;
+    tbb::task_arena case_arena(number_of_threads);
+    case_arena.execute(
+        [&]()
+        {
+            TickCount t1 = TickCount::now();
+            StructuralSimulation simulation(case_inputs_[case_index], geometry_, case_folder);
+            simulation.runSimulation(end_time);
+            result.push_back((TickCount::now() - t1).seconds());
+
+            StdVec<SharedPtr<SolidBodyForSimulation>> solid_body_list = simulation.get_solid_body_list_();
+            for (size_t i = 0; i < solid_body_list.size(); i++)
+            {
+                ElasticSolidParticles *particles = solid_body_list[i]->getElasticSolidParticles();
+                result.push_back(simulation.getMaxDisplacement(i));
+                result.push_back(particles->getVonMisesStressMax());
+                result.push_back(particles->getVonMisesStrainMax());
+            }
+        });
+    return result;
+}
+
+void StructuralSimulationBatch::runCases(Real end_time, int number_of_concurrent_cases, const std::string &summary_file_name)
+{
+    int number_of_processes = SMAX(1, SMIN(number_of_concurrent_cases, int(case_inputs_.size())));
+#ifdef _WIN32
+    number_of_processes = 1; // no local processes on this platform
+#endif
+    int number_of_threads = SMAX(1, int(std::thread::hardware_concurrency()) / number_of_processes);
+    results_ = StdVec<StdVec<Real>>(case_inputs_.size());
+
+    auto run_cases = [&](BaseCommunicator &communicator) -> int
+    {
+        ByteBuffer case_results;
+        for (size_t k = communicator.Rank(); k < case_inputs_.size(); k += communicator.Size())
+        {
+            // the input, output, restart and reload folders of the case are in its own folder
+            StdVec<Real> result = runCase(k, end_time, number_of_threads, "./output/" + case_names_[k]);
+            appendToByteBuffer(case_results, k);
+            appendToByteBuffer(case_results, result.size());
+            for (Real value : result)
+                appendToByteBuffer(case_results, value);
+        }
+
+        // the results are collected on the first rank
+        StdVec<ByteBuffer> send_buffers(communicator.Size());
+        send_buffers[0] = case_results;
+        StdVec<ByteBuffer> receive_buffers;
+        communicator.exchangeBuffers(send_buffers, receive_buffers);
+        if (communicator.Rank() == 0)
+        {
+            for (const ByteBuffer &buffer : receive_buffers)
+            {
+                size_t position = 0;
+                while (position < buffer.size())
+                {
+                    size_t case_index = 0;
+                    size_t number_of_values = 0;
+                    readFromByteBuffer(buffer, position, case_index);
+                    readFromByteBuffer(buffer, position, number_of_values);
+                    results_[case_index].resize(number_of_values);
+                    for (Real &value : results_[case_index])
+                        readFromByteBuffer(buffer, position, value);
+                }
+            }
+        }
+        return 0;
+    };
+
+    if (number_of_processes > 1)
+    {
+        // the TBB worker threads, which are not copied by fork, are terminated before forking
+        tbb::task_scheduler_handle scheduler_handle{tbb::attach{}};
+        if (!tbb::finalize(scheduler_handle, std::nothrow))
+        {
+            std::cout << "\n Warning: the TBB worker threads are still in use, "
+                      << "the cases of the structural simulation batch are run one after another." << std::endl;
+            number_of_processes = 1;
+            number_of_threads = SMAX(1, int(std::thread::hardware_concurrency()));
+        }
+    }
+
+    if (number_of_processes == 1)
+    {
+        SerialCommunicator communicator;
+        run_cases(communicator);
+    }
+    else
+    {
+        if (runOnLocalProcesses(number_of_processes, run_cases) != 0)
+        {
+            std::cout << "\n Error: a case of the structural simulation batch failed!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+
+    fs::create_directories("./output");
+    std::ofstream out_file(("./output/" + summary_file_name).c_str(), std::ios::out | std::ios::trunc);
+    out_file << "case,case_name,wall_time";
+    for (size_t i = 0; i < geometry_.body_mesh_list_.size(); i++)
+    {
+        out_file << ",body_" << i << "_max_displacement"
+                 << ",body_" << i << "_max_von_mises_stress"
+                 << ",body_" << i << "_max_von_mises_strain";
+    }
+    out_file << "\n";
+    for (size_t k = 0; k < case_inputs_.size(); k++)
+    {
+        out_file << k << "," << case_names_[k];
+        for (Real value : results_[k])
+            out_file << "," << value;
+        out_file << "\n";
+    }
+    out_file.close();
+    std::cout << "The results of " << case_inputs_.size() << " cases are written to ./output/" << summary_file_name << std::endl;
+}
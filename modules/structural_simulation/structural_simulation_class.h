@@ -81,6 +81,9 @@ class SolidBodyFromMesh : public SolidBody
   public:
     SolidBodyFromMesh(SPHSystem &system, SharedPtr<TriangleMeshShape> triangle_mesh_shape, Real resolution,
                       SharedPtr<SaintVenantKirchhoffSolid> material_model, StdLargeVec<Vec3d> &pos_0, StdLargeVec<Real> &volume);
+    // with the level set shape already built, e.g. shared by the cases of a batch
+    SolidBodyFromMesh(SPHSystem &system, SharedPtr<LevelSetShape> level_set_shape, Real resolution,
+                      SharedPtr<SaintVenantKirchhoffSolid> material_model);
     ~SolidBodyFromMesh(){};
 };
 
@@ -101,6 +104,10 @@ class SolidBodyForSimulation
     SolidBodyForSimulation(
         SPHSystem &system, SharedPtr<TriangleMeshShape> triangle_mesh_shape, Real resolution,
         Real physical_viscosity, SharedPtr<SaintVenantKirchhoffSolid> material_model, StdLargeVec<Vec3d> &pos_0, StdLargeVec<Real> &volume);
+    // with the level set shape already built
+    SolidBodyForSimulation(
+        SPHSystem &system, SharedPtr<LevelSetShape> level_set_shape, Real resolution,
+        Real physical_viscosity, SharedPtr<SaintVenantKirchhoffSolid> material_model);
     ~SolidBodyForSimulation(){};
 
     SolidBodyFromMesh *getSolidBodyFromMesh() { return &solid_body_from_mesh_; };
@@ -174,6 +181,31 @@ class StructuralSimulationInput
         StdVec<IndexVector> contacting_bodies_list);
 };
 
+/**
+ * @class StructuralSimulationGeometry
+ * @brief The read-only geometric data of a structural simulation, i.e. the triangle meshes
+ * and the level sets of the bodies, which are built once
+ * and shared by the simulations with the same geometric input.
+ * As in a single simulation, the particles of the bodies are generated on lattice
+ * from the shared level sets, so that no particle relaxation is carried out here.
+ */
+class StructuralSimulationGeometry
+{
+  public:
+    explicit StructuralSimulationGeometry(const StructuralSimulationInput &input);
+    ~StructuralSimulationGeometry(){};
+
+    // same STL files, scaling, translations and resolutions
+    bool isCompatible(const StructuralSimulationInput &input);
+
+    StdVec<SharedPtr<TriangleMeshShape>> body_mesh_list_;
+    StdVec<SharedPtr<LevelSetShape>> level_set_shape_list_;
+
+  protected:
+    StructuralSimulationInput input_;
+    Real system_resolution_;
+};
+
 class StructuralSimulation
 {
   private:
@@ -197,6 +229,7 @@ class StructuralSimulation
     bool write_particle_relaxation_data_;
 
     // internal members
+    StructuralSimulationGeometry *shared_geometry_; // optional: geometry shared with other simulations
     Real system_resolution_;
     SPHSystem system_;
     Real scale_system_boundaries_;
@@ -307,8 +340,15 @@ class StructuralSimulation
 
     void runSimulationStep(Real &dt, Real &integration_time);
 
+    StructuralSimulation(const StructuralSimulationInput &input, StructuralSimulationGeometry *shared_geometry,
+                         const std::string &root_folder);
+
   public:
     explicit StructuralSimulation(const StructuralSimulationInput &input);
+    // the meshes and level sets are taken from the shared geometry,
+    // and the input, output, restart and reload folders are in the root folder
+    StructuralSimulation(const StructuralSimulationInput &input, StructuralSimulationGeometry &shared_geometry,
+                         const std::string &root_folder = ".");
     ~StructuralSimulation();
 
     StdVec<SharedPtr<SolidBodyForSimulation>> get_solid_body_list_() { return solid_body_list_; };
@@ -336,4 +376,37 @@ class StructuralSimulationJS : public StructuralSimulation
     Real dt;
 };
 
+/**
+ * @class StructuralSimulationBatch
+ * @brief Run the variants, e.g. of materials and loads, of a structural simulation with the same geometry.
+ * @details The geometry is built once before the cases are run.
+ * The cases are distributed over local processes forked after the geometry is built,
+ * so that the geometry is shared, while the global physical time and the output folders are not.
+ * If the TBB worker threads cannot be terminated before forking, the cases are run one after another.
+ * Each case runs in a TBB arena with its share of the threads,
+ * and writes its output in the folder ./output/case_name.
+ * The results of all cases are collected into one summary file.
+ */
+class StructuralSimulationBatch
+{
+  public:
+    explicit StructuralSimulationBatch(const StructuralSimulationInput &geometry_input);
+    ~StructuralSimulationBatch(){};
+
+    void addCase(const std::string &case_name, const StructuralSimulationInput &input);
+    // the number of concurrent cases is the number of local processes
+    void runCases(Real end_time, int number_of_concurrent_cases = 1,
+                  const std::string &summary_file_name = "structural_simulation_batch_summary.csv");
+    // for each case: wall time, then max displacement, von Mises stress and strain of each body
+    StdVec<StdVec<Real>> getResults() { return results_; };
+
+  protected:
+    StructuralSimulationGeometry geometry_;
+    StdVec<std::string> case_names_;
+    StdVec<StructuralSimulationInput> case_inputs_;
+    StdVec<StdVec<Real>> results_;
+
+    StdVec<Real> runCase(size_t case_index, Real end_time, int number_of_threads, const std::string &case_folder);
+};
+
 #endif // SOLID_STRUCTURAL_SIMULATION_CLASS_H
@@ -2,6 +2,7 @@
 
 #include "base_particles.hpp"
 #include "mesh_iterators.hpp"
+#include "particle_iterators.h"
 
 namespace SPH
 {
@@ -36,6 +37,7 @@ void CellLinkedList::clearCellLists()
 //=================================================================================================//
 void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
 {
+    is_stencil_data_current_.store(false, std::memory_order_relaxed);
     StdLargeVec<Vecd> &pos = base_particles.pos_;
     StdLargeVec<Real> &Vol = base_particles.Vol_;
     mesh_parallel_for(
@@ -52,6 +54,39 @@ void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
         });
 }
 //=================================================================================================//
+void CellLinkedList::updateStencilCellData()
+{
+    size_t number_of_cells = all_cells_.prod();
+    StdLargeVec<size_t> cell_sizes(number_of_cells);
+    mesh_parallel_for(MeshRange(Array2i::Zero(), all_cells_),
+                      [&](int i, int j)
+                      {
+                          cell_sizes[i * all_cells_[1] + j] = cell_data_lists_[i][j].size();
+                      });
+    stencil_cell_offsets_.resize(number_of_cells + 1);
+    size_t total_entries = particle_scan(execution::ParallelPolicy(), cell_sizes, stencil_cell_offsets_);
+    stencil_cell_offsets_[number_of_cells] = total_entries;
+
+    stencil_index_.resize(total_entries);
+    stencil_Vol_.resize(total_entries);
+    for (int d = 0; d != Dimensions; ++d)
+        stencil_position_[d].resize(total_entries);
+    mesh_parallel_for(MeshRange(Array2i::Zero(), all_cells_),
+                      [&](int i, int j)
+                      {
+                          size_t entry = stencil_cell_offsets_[i * all_cells_[1] + j];
+                          for (const ListData &list_data : cell_data_lists_[i][j])
+                          {
+                              stencil_index_[entry] = std::get<0>(list_data);
+                              for (int d = 0; d != Dimensions; ++d)
+                                  stencil_position_[d][entry] = std::get<1>(list_data)[d];
+                              stencil_Vol_[entry] = std::get<2>(list_data);
+                              ++entry;
+                          }
+                      });
+    is_stencil_data_current_.store(true, std::memory_order_relaxed);
+}
+//=================================================================================================//
 void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
 {
     // clear the data
@@ -78,6 +113,9 @@ void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &par
 void CellLinkedList ::InsertListDataEntry(
     size_t particle_index, const Vecd &particle_position, Real volumetric)
 {
+    // called concurrently, only the first insertion after a copy writes the flag
+    if (is_stencil_data_current_.load(std::memory_order_relaxed))
+        is_stencil_data_current_.store(false, std::memory_order_relaxed);
     Array2i cellpos = CellIndexFromPosition(particle_position);
     cell_data_lists_[cellpos[0]][cellpos[1]].emplace_back(
         std::make_tuple(particle_index, particle_position, volumetric));
@@ -37,6 +37,7 @@ namespace SPH
 using Arrayi = Array3i;
 using Vecd = Vec3d;
 using Matd = Mat3d;
+using NeighborVecd = NeighborVec3d;
 using AlignedBox = AlignedBox3d;
 using AngularVecd = Vec3d;
 using Rotation = Rotation3d;
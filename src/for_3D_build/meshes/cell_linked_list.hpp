@@ -28,21 +28,147 @@ void CellLinkedList::searchNeighborsByParticles(
                  [&](size_t index_i)
                  {
                      int search_depth = get_search_depth(index_i);
-                     Array3i target_cell_index = CellIndexFromPosition(pos[index_i]);
+                     Neighborhood &neighborhood = particle_configuration[index_i];
+                     size_t first_neighbor = neighborhood.current_size_;
+                     /** periodic images are found by searching from the shifted positions */
+                     PeriodicImageShifts shifts;
+                     size_t number_of_shifts =
+                         getPeriodicImageShifts(pos[index_i], Real(search_depth + 1) * grid_spacing_, shifts);
+                     for (size_t k = 0; k != number_of_shifts; ++k)
+                     {
+                         Vecd search_position = pos[index_i] + shifts[k];
+                         Array3i target_cell_index = CellIndexFromPosition(search_position);
+                         mesh_for_each(
+                             Array3i::Zero().max(target_cell_index - search_depth * Array3i::Ones()),
+                             all_cells_.min(target_cell_index + (search_depth + 1) * Array3i::Ones()),
+                             [&](int l, int m, int n)
+                             {
+                                 ListDataVector &target_particles = cell_data_lists_[l][m][n];
+                                 for (const ListData &list_data : target_particles)
+                                 {
+                                     get_neighbor_relation(neighborhood, search_position, index_i, list_data);
+                                 }
+                             });
+                     }
+                     get_neighbor_relation.evaluateKernel(neighborhood, first_neighbor);
+                 });
+}
+//=================================================================================================//
+template <class DynamicsRange, class KernelType>
+void CellLinkedList::searchInnerNeighborsByStencil(DynamicsRange &dynamics_range,
+                                                   ParticleConfiguration &particle_configuration,
+                                                   int search_depth, const KernelType &kernel)
+{
+    checkStencilCellData();
+    NeighborBuilderInnerStencil<KernelType> get_inner_neighbor(kernel);
+    const size_t *index_j = stencil_index_.data();
+    const Real *Vol_j = stencil_Vol_.data();
+    std::array<const Real *, Dimensions> position_j;
+    for (int d = 0; d != Dimensions; ++d)
+        position_j[d] = stencil_position_[d].data();
 
+    StdLargeVec<Vecd> &pos = dynamics_range.getBaseParticles().pos_;
+    particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
+                 [&](size_t index_i)
+                 {
                      Neighborhood &neighborhood = particle_configuration[index_i];
-                     mesh_for_each(
-                         Array3i::Zero().max(target_cell_index - search_depth * Array3i::Ones()),
-                         all_cells_.min(target_cell_index + (search_depth + 1) * Array3i::Ones()),
-                         [&](int l, int m, int n)
+                     forEachStencilRangeAround(
+                         pos[index_i], search_depth,
+                         [&](const Vecd &search_position, size_t begin, size_t end)
                          {
-                             ListDataVector &target_particles = cell_data_lists_[l][m][n];
-                             for (const ListData &list_data : target_particles)
-                             {
-                                 get_neighbor_relation(neighborhood, pos[index_i], index_i, list_data);
-                             }
+                             get_inner_neighbor(neighborhood, search_position, index_i, begin, end,
+                                                index_j, position_j, Vol_j);
                          });
                  });
 }
 //=================================================================================================//
+template <class DynamicsRange>
+void CellLinkedList::searchInnerNeighborIndicesByStencil(DynamicsRange &dynamics_range, int search_depth,
+                                                         Real cutoff_radius_sqr, StdLargeVec<size_t> &neighbor_offset,
+                                                         StdLargeVec<NeighborIndex> &neighbor_index)
+{
+    checkStencilCellData();
+    StdLargeVec<Vecd> &pos = dynamics_range.getBaseParticles().pos_;
+    size_t total_particles = dynamics_range.SizeOfLoopRange();
+    StdLargeVec<size_t> neighbor_counts(total_particles);
+    /** the neighbors are counted first and then written to the compressed rows */
+    auto search_indices = [&](size_t index_i, NeighborIndex *row_indices)
+    {
+        size_t count = 0;
+        forEachStencilRangeAround(
+            pos[index_i], search_depth,
+            [&](const Vecd &search_position, size_t begin, size_t end)
+            {
+                for (size_t n = begin; n != end; ++n)
+                {
+                    Real distance_sqr = 0.0;
+                    for (int d = 0; d != Dimensions; ++d)
+                    {
+                        Real displacement = search_position[d] - stencil_position_[d][n];
+                        distance_sqr += displacement * displacement;
+                    }
+                    if (distance_sqr < cutoff_radius_sqr && stencil_index_[n] != index_i)
+                    {
+                        if (row_indices != nullptr)
+                            row_indices[count] = NeighborIndex(stencil_index_[n]);
+                        ++count;
+                    }
+                }
+            });
+        return count;
+    };
+    particle_for(execution::ParallelPolicy(), total_particles,
+                 [&](size_t index_i)
+                 { neighbor_counts[index_i] = search_indices(index_i, nullptr); });
+    neighbor_offset.resize(total_particles + 1);
+    size_t total_neighbors = particle_scan(execution::ParallelPolicy(), neighbor_counts, neighbor_offset);
+    neighbor_offset[total_particles] = total_neighbors;
+    neighbor_index.resize(total_neighbors);
+    particle_for(execution::ParallelPolicy(), total_particles,
+                 [&](size_t index_i)
+                 { search_indices(index_i, neighbor_index.data() + neighbor_offset[index_i]); });
+}
+//=================================================================================================//
+template <typename FunctionOnRange>
+void CellLinkedList::forEachStencilRangeAround(const Vecd &position, int search_depth,
+                                               const FunctionOnRange &function_on_range)
+{
+    PeriodicImageShifts shifts;
+    size_t number_of_shifts = getPeriodicImageShifts(position, Real(search_depth + 1) * grid_spacing_, shifts);
+    for (size_t k = 0; k != number_of_shifts; ++k)
+    {
+        Vecd search_position = position + shifts[k];
+        Array3i target_cell_index = CellIndexFromPosition(search_position);
+        Array3i lower = Array3i::Zero().max(target_cell_index - search_depth * Array3i::Ones());
+        Array3i upper = all_cells_.min(target_cell_index + (search_depth + 1) * Array3i::Ones());
+        /** the cells along the last axis are contiguous in the stencil cell data */
+        for (int l = lower[0]; l != upper[0]; ++l)
+            for (int m = lower[1]; m != upper[1]; ++m)
+            {
+                size_t row = (l * all_cells_[1] + m) * all_cells_[2];
+                function_on_range(search_position, stencil_cell_offsets_[row + lower[2]],
+                                  stencil_cell_offsets_[row + upper[2]]);
+            }
+    }
+}
+//=================================================================================================//
+template <typename FunctionOnCell>
+void CellLinkedList::forEachCellAround(const Vecd &position, int search_depth, const FunctionOnCell &function_on_cell)
+{
+    PeriodicImageShifts shifts;
+    size_t number_of_shifts = getPeriodicImageShifts(position, Real(search_depth + 1) * grid_spacing_, shifts);
+    for (size_t k = 0; k != number_of_shifts; ++k)
+    {
+        Vecd search_position = position + shifts[k];
+        Array3i target_cell_index = CellIndexFromPosition(search_position);
+        mesh_for_each(
+            Array3i::Zero().max(target_cell_index - search_depth * Array3i::Ones()),
+            all_cells_.min(target_cell_index + (search_depth + 1) * Array3i::Ones()),
+            [&](int l, int m, int n)
+            {
+                function_on_cell(search_position, cell_data_lists_[l][m][n]);
+            });
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -21,19 +21,14 @@ namespace solid_dynamics
 //=================================================================================================//
 void UpdateElasticNormalDirection::update(size_t index_i, Real dt)
 {
-    Matd &F = F_[index_i];
-    Mat3d R;
-    Real Q[9], H[9], A[9];
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            A[i * 3 + j] = F(i, j);
-
-    polar::polar_decomposition(Q, H, A);
-    // this decomposition has the form A = Q*H, where Q is orthogonal and H is symmetric positive semi-definite.
+    // This decomposition has the form A = Q*H, where Q is orthogonal and H is symmetric positive semi-definite.
     // Ref. "An algorithm to compute the polar decomposition of a 3*3 matrix, Nicholas J. Higham et al. Numer Algor(2016) "
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            R(i, j) = Q[i * 3 + j];
+    // The decomposition uses row-major arrays, while Mat3d is stored column-major.
+    // Therefore, passing the storage of F directly gives A = F^T. With F = V*R, we have F^T = R^T*V,
+    // i.e. Q = R^T and H = V. Writing Q row-major into the column-major storage transposes it back to R,
+    // so that no copies or transposes are needed. H becomes the left stretch tensor V, which is not used.
+    Mat3d R, H;
+    polar::polar_decomposition(R.data(), H.data(), F_[index_i].data());
     n_[index_i] = R * n0_[index_i];
 }
 //=================================================================================================//
@@ -4,11 +4,14 @@
 #include "base_particles.hpp"
 #include "sph_system.h"
 
+#include "tbb/task_arena.h"
+
 namespace SPH
 {
 //=================================================================================================//
 SPHBody::SPHBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr, const std::string &body_name)
     : sph_system_(sph_system), body_name_(body_name), newly_updated_(true), base_particles_(nullptr),
+      use_workload_balancing_(false), number_of_chunks_(0),
       body_shape_(shape_ptr_keeper_.assignPtr(shape_ptr)),
       sph_adaptation_(sph_adaptation_ptr_keeper_.createPtr<SPHAdaptation>(*this)),
       base_material_(nullptr)
@@ -37,6 +40,46 @@ void SPHBody::allocateConfigurationMemoriesForBufferParticles()
     }
 }
 //=================================================================================================//
+void SPHBody::setWorkloadBalancing(size_t number_of_chunks)
+{
+    use_workload_balancing_ = true;
+    number_of_chunks_ = number_of_chunks;
+}
+//=================================================================================================//
+void SPHBody::balanceWorkload()
+{
+    size_t total_real_particles = base_particles_->total_real_particles_;
+    /** several chunks for each thread, so that the remaining imbalance is taken by task stealing */
+    size_t number_of_chunks = number_of_chunks_ != 0
+                                  ? number_of_chunks_
+                                  : 8 * size_t(tbb::this_task_arena::max_concurrency());
+    number_of_chunks = SMAX(size_t(1), SMIN(number_of_chunks, total_real_particles));
+
+    StdLargeVec<size_t> weights(total_real_particles + 1);
+    StdLargeVec<size_t> offsets(total_real_particles + 1);
+    particle_for(execution::ParallelPolicy(), total_real_particles,
+                 [&](size_t i)
+                 {
+                     size_t weight = 1;
+                     for (SPHRelation *relation : body_relations_)
+                         weight += relation->NeighborCount(i);
+                     weights[i] = weight;
+                 });
+    weights[total_real_particles] = 0;
+    size_t total_weight = particle_scan(execution::ParallelPolicy(), weights, offsets);
+
+    IndexVector &chunk_bounds = loop_range_.ChunkBounds();
+    chunk_bounds.resize(number_of_chunks + 1);
+    for (size_t k = 0; k != number_of_chunks; ++k)
+    {
+        size_t chunk_start_weight = k * total_weight / number_of_chunks;
+        chunk_bounds[k] = std::lower_bound(offsets.begin(), offsets.begin() + total_real_particles,
+                                           chunk_start_weight) -
+                          offsets.begin();
+    }
+    chunk_bounds[number_of_chunks] = total_real_particles;
+}
+//=================================================================================================//
 BoundingBox SPHBody::getBodyShapeBounds()
 {
     return body_shape_->getBounds();
@@ -99,6 +142,7 @@ BaseCellLinkedList &RealBody::getCellLinkedList()
 //=================================================================================================//
 void RealBody::updateCellLinkedList()
 {
+    base_particles_->updateBufferCapacity();
     getCellLinkedList().UpdateCellLists(*base_particles_);
     base_particles_->total_ghost_particles_ = 0;
 }
@@ -41,6 +41,7 @@
 #include "base_material.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
+#include "particle_iterators.h"
 #include "particle_sorting.h"
 #include "sph_data_containers.h"
 #include "sph_system.h"
@@ -72,6 +73,9 @@ class SPHBody
     std::string body_name_;
     bool newly_updated_;            /**< whether this body is in a newly updated state */
     BaseParticles *base_particles_; /**< Base particles for dynamic cast DataDelegate  */
+    WorkloadBalancedRange loop_range_;
+    bool use_workload_balancing_;   /**< whether the loop range is balanced after configuration updates */
+    size_t number_of_chunks_;       /**< number of workload balanced chunks, zero for a default by the threads */
 
   public:
     Shape *body_shape_;                    /**< volumetric geometry enclosing the body */
@@ -87,7 +91,7 @@ class SPHBody
     SPHSystem &getSPHSystem();
     SPHBody &getSPHBody() { return *this; };
     BaseParticles &getBaseParticles() { return *base_particles_; };
-    size_t &LoopRange() { return base_particles_->total_real_particles_; };
+    WorkloadBalancedRange &LoopRange() { return loop_range_; };
     size_t SizeOfLoopRange() { return base_particles_->total_real_particles_; };
     Real getSPHBodyResolutionRef() { return sph_adaptation_->ReferenceSpacing(); };
     void setNewlyUpdated() { newly_updated_ = true; };
@@ -96,6 +100,11 @@ class SPHBody
     BoundingBox getBodyShapeBounds();
     BoundingBox getSPHSystemBounds();
     void allocateConfigurationMemoriesForBufferParticles();
+    /** balance the loop range by the neighbor counts after each update of the configurations */
+    void setWorkloadBalancing(size_t number_of_chunks = 0);
+    bool getWorkloadBalancing() { return use_workload_balancing_; };
+    /** rebuild the workload balanced chunks with the weight of each particle given by its total neighbor count */
+    void balanceWorkload();
     //----------------------------------------------------------------------
     //		Object factory template functions
     //----------------------------------------------------------------------
@@ -131,6 +140,7 @@ class SPHBody
     {
         base_material_ = material;
         base_particles_ = base_particles_ptr_keeper_.createPtr<ParticleType>(*this, material);
+        loop_range_.setTotalRealParticles(base_particles_->total_real_particles_);
     };
 
     /** partial construct particles with material informaiton. note that particle data not initialized yet */
@@ -22,6 +22,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
     const StdLargeVec<Vecd> &pos = base_particles_->pos_;
     const StdLargeVec<Real> &Vol = base_particles_->Vol_;
     NeighborBuilderInner neighbor_relation_inner(*this);
+    size_t first_neighbor = particle_configuration[particle_id].current_size_;
     for (size_t n = 0; n != neighboring_ids.size(); ++n)
     {
         size_t index_j = neighboring_ids[n];
@@ -29,6 +30,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
         Neighborhood &neighborhood = particle_configuration[particle_id];
         neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
     }
+    neighbor_relation_inner.evaluateKernel(particle_configuration[particle_id], first_neighbor);
     /** Second branch.
      * The second branch has special parent branch, branch 0, consisting only one point.
      * The child branch are two normal branch.
@@ -89,6 +91,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
             }
         }
 
+        size_t first_neighbor = particle_configuration[particle_id].current_size_;
         for (size_t n = 0; n != neighboring_ids.size(); ++n)
         {
             size_t index_j = neighboring_ids[n];
@@ -96,6 +99,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
             Neighborhood &neighborhood = particle_configuration[particle_id];
             neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
         }
+        neighbor_relation_inner.evaluateKernel(particle_configuration[particle_id], first_neighbor);
     }
     /** Other branches.
      * They are may normal branch (fully grown, has child and parent) or non-fully grown branch
@@ -161,6 +165,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
                     }
                 }
 
+                size_t first_neighbor = particle_configuration[particle_id].current_size_;
                 for (size_t n = 0; n != neighboring_ids.size(); ++n)
                 {
                     size_t index_j = neighboring_ids[n];
@@ -168,6 +173,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
                     Neighborhood &neighborhood = particle_configuration[particle_id];
                     neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
                 }
+                neighbor_relation_inner.evaluateKernel(particle_configuration[particle_id], first_neighbor);
             }
         }
         else
@@ -199,6 +205,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
                 if (i + 2 < num_ele)
                     neighboring_ids.push_back(particle_id + 2);
 
+                size_t first_neighbor = particle_configuration[particle_id].current_size_;
                 for (size_t n = 0; n != neighboring_ids.size(); ++n)
                 {
                     size_t index_j = neighboring_ids[n];
@@ -206,6 +213,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
                     Neighborhood &neighborhood = particle_configuration[particle_id];
                     neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
                 }
+                neighbor_relation_inner.evaluateKernel(particle_configuration[particle_id], first_neighbor);
             }
         }
     }
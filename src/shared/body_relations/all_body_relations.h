@@ -33,5 +33,6 @@
 #include "complex_body_relation.h"
 #include "contact_body_relation.h"
 #include "inner_body_relation.h"
+#include "relation_manager.h"
 
 #endif // ALL_BODY_RELATIONS_H
@@ -16,7 +16,8 @@ namespace SPH
 	}
 	//=================================================================================================//
 	SPHRelation::SPHRelation(SPHBody &sph_body)
-		: sph_body_(sph_body), base_particles_(sph_body.getBaseParticles()) {}
+		: sph_body_(sph_body), configuration_update_count_(0),
+		  base_particles_(sph_body.getBaseParticles()) {}
 	//=================================================================================================//
 	BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
 		: SPHRelation(real_body), real_body_(&real_body)
@@ -61,6 +62,14 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	size_t BaseContactRelation::NeighborCount(size_t index_i)
+	{
+		size_t neighbor_count = 0;
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+			neighbor_count += contact_configuration_[k][index_i].current_size_;
+		return neighbor_count;
+	}
+	//=================================================================================================//
 	void BaseContactRelation::resetNeighborhoodCurrentSize()
 	{
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
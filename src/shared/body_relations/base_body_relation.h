@@ -95,6 +95,64 @@ struct SearchDepthAdaptiveContact
     };
 };
 
+/**
+ * @class BaseNeighborSearch
+ * @brief The neighbor search of a relation in one target cell linked list.
+ * @details Used by the fused configuration update in which the searches in the same target cell linked list
+ * are carried out one after another for all source bodies, so that the target cell data are reused in cache.
+ */
+class BaseNeighborSearch
+{
+  public:
+    CellLinkedList &target_cell_linked_list_;
+    int search_depth_;
+
+    BaseNeighborSearch(CellLinkedList &target_cell_linked_list, int search_depth)
+        : target_cell_linked_list_(target_cell_linked_list), search_depth_(search_depth){};
+    virtual ~BaseNeighborSearch(){};
+
+    /** called before each fused update */
+    virtual void setupSearch(){};
+    /** reset the neighborhood of a source particle and search its neighbors in the target cells around */
+    virtual void searchNeighbors(size_t index_i, const Vecd &pos_i) = 0;
+};
+
+/**
+ * @class NeighborSearch
+ * @brief The neighbor search with a given neighbor builder,
+ * which is called directly for the target particles in the cells around a source particle.
+ */
+template <class GetNeighborRelation>
+class NeighborSearch : public BaseNeighborSearch
+{
+  protected:
+    ParticleConfiguration &particle_configuration_;
+    GetNeighborRelation &get_neighbor_relation_;
+
+  public:
+    NeighborSearch(CellLinkedList &target_cell_linked_list, int search_depth,
+                   ParticleConfiguration &particle_configuration, GetNeighborRelation &get_neighbor_relation)
+        : BaseNeighborSearch(target_cell_linked_list, search_depth),
+          particle_configuration_(particle_configuration), get_neighbor_relation_(get_neighbor_relation){};
+    virtual ~NeighborSearch(){};
+
+    virtual void searchNeighbors(size_t index_i, const Vecd &pos_i) override
+    {
+        Neighborhood &neighborhood = particle_configuration_[index_i];
+        neighborhood.current_size_ = 0;
+        target_cell_linked_list_.forEachCellAround(
+            pos_i, search_depth_,
+            [&](const Vecd &search_position, const ListDataVector &target_particles)
+            {
+                for (const ListData &list_data : target_particles)
+                {
+                    get_neighbor_relation_(neighborhood, search_position, index_i, list_data);
+                }
+            });
+        get_neighbor_relation_.evaluateKernel(neighborhood, 0);
+    };
+};
+
 /** Transfer body parts to real bodies. **/
 RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts);
 
@@ -106,6 +164,7 @@ class SPHRelation
 {
   protected:
     SPHBody &sph_body_;
+    size_t configuration_update_count_; /**< the number of configuration updates so far */
 
   public:
     BaseParticles &base_particles_;
@@ -113,9 +172,20 @@ class SPHRelation
     explicit SPHRelation(SPHBody &sph_body);
     virtual ~SPHRelation(){};
 
+    /** called whenever the configuration is rebuilt, so that the data cached from it can be refreshed */
+    virtual void countConfigurationUpdate() { configuration_update_count_++; };
+    size_t ConfigurationUpdateCount() { return configuration_update_count_; };
+
     void subscribeToBody() { sph_body_.body_relations_.push_back(this); };
     virtual void resizeConfiguration() = 0;
     virtual void updateConfiguration() = 0;
+    /**
+     * Collect the neighbor searches over all real particles of the body for the fused configuration update.
+     * Returns false if the relation is not able to be updated in this way.
+     */
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) { return false; };
+    /** the number of neighbors of a particle in the present configuration, used as the workload estimation */
+    virtual size_t NeighborCount(size_t index_i) { return 0; };
 };
 
 /**
@@ -134,6 +204,7 @@ class BaseInnerRelation : public SPHRelation
     virtual ~BaseInnerRelation(){};
 
     virtual void resizeConfiguration() override;
+    virtual size_t NeighborCount(size_t index_i) override { return inner_configuration_[index_i].current_size_; };
 };
 
 /**
@@ -155,6 +226,7 @@ class BaseContactRelation : public SPHRelation
     virtual ~BaseContactRelation(){};
 
     virtual void resizeConfiguration() override;
+    virtual size_t NeighborCount(size_t index_i) override;
 };
 } // namespace SPH
 #endif // BASE_BODY_RELATION_H
\ No newline at end of file
@@ -65,6 +65,26 @@ void ComplexRelation::updateConfiguration()
 {
     inner_relation_.updateConfiguration();
     contact_relation_.updateConfiguration();
+    SPHRelation::countConfigurationUpdate();
+}
+//=================================================================================================//
+void ComplexRelation::countConfigurationUpdate()
+{
+    SPHRelation::countConfigurationUpdate();
+    inner_relation_.countConfigurationUpdate();
+    contact_relation_.countConfigurationUpdate();
+}
+//=================================================================================================//
+bool ComplexRelation::collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches)
+{
+    StdVec<BaseNeighborSearch *> complex_neighbor_searches;
+    if (!inner_relation_.collectNeighborSearches(complex_neighbor_searches) ||
+        !contact_relation_.collectNeighborSearches(complex_neighbor_searches))
+        return false;
+
+    neighbor_searches.insert(neighbor_searches.end(),
+                             complex_neighbor_searches.begin(), complex_neighbor_searches.end());
+    return true;
 }
 //=================================================================================================//
 } // namespace SPH
@@ -64,6 +64,9 @@ class ComplexRelation : public SPHRelation
 
     virtual void resizeConfiguration() override;
     virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override;
+    /** the inner and contact relations are counted too, as they are updated by the fused searches */
+    virtual void countConfigurationUpdate() override;
 };
 } // namespace SPH
 #endif // COMPLEX_BODY_RELATION_H
\ No newline at end of file
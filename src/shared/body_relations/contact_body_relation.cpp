@@ -4,6 +4,93 @@
 
 namespace SPH
 {
+/**
+ * @class BroadPhaseCandidates
+ * @brief The source particles found by the broad phase, used as the range for neighbor search.
+ */
+class BroadPhaseCandidates
+{
+    BaseParticles &base_particles_;
+    IndexVector &candidates_;
+
+  public:
+    BroadPhaseCandidates(BaseParticles &base_particles, IndexVector &candidates)
+        : base_particles_(base_particles), candidates_(candidates){};
+    BaseParticles &getBaseParticles() { return base_particles_; };
+    IndexVector &LoopRange() { return candidates_; };
+};
+//=================================================================================================//
+template <class DynamicsRange, class GetNeighborRelation>
+void ContactRelationCrossResolution::
+    searchNeighborsWithBroadPhase(DynamicsRange &dynamics_range,
+                                  StdVec<GetNeighborRelation *> &get_contact_neighbors)
+{
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    BoundingBox source_bounds = particle_reduce(
+        execution::ParallelPolicy(), dynamics_range.LoopRange(),
+        BoundingBox(MaxRealNumber * Vecd::Ones(), -MaxRealNumber * Vecd::Ones()),
+        [](const BoundingBox &x, const BoundingBox &y)
+        { return getUnionOfBoundingBoxes(x, y); },
+        [&](size_t i)
+        { return BoundingBox(pos[i], pos[i]); });
+
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        ParticleConfiguration &configuration = contact_configuration_[k];
+        auto reset_neighborhood = [&](size_t index_i)
+        { configuration[index_i].current_size_ = 0; };
+        bool is_candidates_current = !is_all_candidates_[k] && candidate_real_particles_ == total_real_particles;
+        is_candidates_current
+            ? particle_for(execution::ParallelPolicy(), candidate_particles_[k], reset_neighborhood)
+            : particle_for(execution::ParallelPolicy(), total_real_particles, reset_neighborhood);
+
+        CellLinkedList &target_cell_linked_list = *target_cell_linked_lists_[k];
+        /** periodic images or ghost particles are not included in the particle bounds */
+        is_all_candidates_[k] = target_cell_linked_list.hasPeriodicImages() ||
+                                contact_bodies_[k]->getBaseParticles().total_ghost_particles_ != 0;
+        if (is_all_candidates_[k])
+        {
+            target_cell_linked_list.searchNeighborsByParticles(
+                dynamics_range, configuration, *get_search_depths_[k], *get_contact_neighbors[k]);
+            continue;
+        }
+
+        Real search_range = Real(get_search_depths_[k]->search_depth_ + 1) * target_cell_linked_list.GridSpacing();
+        BoundingBox &particle_bounds = target_cell_linked_list.ParticleBounds();
+        BoundingBox target_bounds(particle_bounds.first_ - search_range * Vecd::Ones(),
+                                  particle_bounds.second_ + search_range * Vecd::Ones());
+        if (!target_bounds.checkOverlap(source_bounds))
+        {
+            candidate_particles_[k].clear();
+            continue;
+        }
+
+        if (target_bounds.checkContain(source_bounds))
+        {
+            is_all_candidates_[k] = true;
+            target_cell_linked_list.searchNeighborsByParticles(
+                dynamics_range, configuration, *get_search_depths_[k], *get_contact_neighbors[k]);
+            continue;
+        }
+
+        candidate_marks_.resize(total_real_particles);
+        particle_for(execution::ParallelPolicy(), total_real_particles,
+                     [&](size_t i)
+                     { candidate_marks_[i] = 0; });
+        particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
+                     [&](size_t i)
+                     { candidate_marks_[i] = target_bounds.checkContain(pos[i]) ? 1 : 0; });
+        particle_compact(execution::ParallelPolicy(), candidate_marks_, candidate_offsets_,
+                         candidate_particles_[k], [](size_t i)
+                         { return i; });
+
+        BroadPhaseCandidates candidates(base_particles_, candidate_particles_[k]);
+        target_cell_linked_list.searchNeighborsByParticles(
+            candidates, configuration, *get_search_depths_[k], *get_contact_neighbors[k]);
+    }
+    candidate_real_particles_ = total_real_particles;
+}
 //=================================================================================================//
 ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
     : ContactRelationCrossResolution(sph_body, contact_bodies)
@@ -14,17 +101,67 @@ ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodie
             neighbor_builder_contact_ptrs_keeper_.createPtr<NeighborBuilderContact>(
                 sph_body_, *contact_bodies_[k]));
     }
+
+    if (isContactKernelType<KernelWendlandC2>())
+    {
+        setTypedContactNeighborSearches<KernelWendlandC2>();
+    }
+    else if (isContactKernelType<KernelCubicBSpline>())
+    {
+        setTypedContactNeighborSearches<KernelCubicBSpline>();
+    }
+    else
+    {
+        setContactNeighborSearches(get_contact_neighbors_);
+    }
 }
 //=================================================================================================//
-void ContactRelation::updateConfiguration()
+template <class KernelType>
+bool ContactRelation::isContactKernelType()
 {
-    resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            sph_body_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
+        if (typeid(get_contact_neighbors_[k]->getKernel()) != typeid(KernelType))
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
+template <class KernelType>
+void ContactRelation::setTypedContactNeighborSearches()
+{
+    StdVec<NeighborBuilderContactTyped<KernelType> *> get_typed_contact_neighbors;
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        get_typed_contact_neighbors.push_back(
+            neighbor_builder_contact_ptrs_keeper_.createPtr<NeighborBuilderContactTyped<KernelType>>(
+                sph_body_, *contact_bodies_[k]));
     }
+    setContactNeighborSearches(get_typed_contact_neighbors);
+}
+//=================================================================================================//
+template <class GetNeighborRelation>
+void ContactRelation::setContactNeighborSearches(const StdVec<GetNeighborRelation *> &get_contact_neighbors)
+{
+    StdVec<GetNeighborRelation *> get_neighbor_relations = get_contact_neighbors;
+    createContactNeighborSearches(get_neighbor_relations);
+    search_contact_neighbors_ = [this, get_neighbor_relations]() mutable
+    {
+        searchNeighborsWithBroadPhase(sph_body_, get_neighbor_relations);
+    };
+}
+//=================================================================================================//
+void ContactRelation::updateConfiguration()
+{
+    search_contact_neighbors_();
+    countConfigurationUpdate();
+}
+//=================================================================================================//
+bool ContactRelation::collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches)
+{
+    neighbor_searches.insert(neighbor_searches.end(),
+                             contact_neighbor_searches_.begin(), contact_neighbor_searches_.end());
+    return true;
 }
 //=================================================================================================//
 SurfaceContactRelation::SurfaceContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
@@ -40,27 +177,10 @@ SurfaceContactRelation::SurfaceContactRelation(SPHBody &sph_body, RealBodyVector
     }
 }
 //=================================================================================================//
-void SurfaceContactRelation::resetNeighborhoodCurrentSize()
-{
-    for (size_t k = 0; k != contact_bodies_.size(); ++k)
-    {
-        particle_for(execution::ParallelPolicy(), body_part_particles_,
-                     [&](size_t index_i)
-                     {
-                         contact_configuration_[k][index_i].current_size_ = 0;
-                     });
-    }
-}
-//=================================================================================================//
 void SurfaceContactRelation::updateConfiguration()
 {
-    resetNeighborhoodCurrentSize();
-    for (size_t k = 0; k != contact_bodies_.size(); ++k)
-    {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            *body_surface_layer_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
-    }
+    searchNeighborsWithBroadPhase(*body_surface_layer_, get_contact_neighbors_);
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 ContactRelationToBodyPart::
@@ -73,17 +193,20 @@ ContactRelationToBodyPart::
             neighbor_builder_contact_ptrs_keeper_
                 .createPtr<NeighborBuilderContactBodyPart>(sph_body_, *contact_body_parts_[k]));
     }
+    createContactNeighborSearches(get_part_contact_neighbors_);
 }
 //=================================================================================================//
 void ContactRelationToBodyPart::updateConfiguration()
 {
-    resetNeighborhoodCurrentSize();
-    for (size_t k = 0; k != contact_bodies_.size(); ++k)
-    {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            sph_body_, contact_configuration_[k],
-            *get_search_depths_[k], *get_part_contact_neighbors_[k]);
-    }
+    searchNeighborsWithBroadPhase(sph_body_, get_part_contact_neighbors_);
+    countConfigurationUpdate();
+}
+//=================================================================================================//
+bool ContactRelationToBodyPart::collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches)
+{
+    neighbor_searches.insert(neighbor_searches.end(),
+                             contact_neighbor_searches_.begin(), contact_neighbor_searches_.end());
+    return true;
 }
 //=================================================================================================//
 AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
@@ -125,6 +248,7 @@ void AdaptiveContactRelation::updateConfiguration()
                 *get_multi_level_search_range_[k][l], *get_contact_neighbors_adaptive_[k][l]);
         }
     }
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 } // namespace SPH
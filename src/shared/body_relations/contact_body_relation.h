@@ -36,6 +36,30 @@
 
 namespace SPH
 {
+/**
+ * @class ContactNeighborSearch
+ * @brief The neighbor search in a contact body for the fused configuration update.
+ * As all source particles are searched, the broad phase candidates of the relation are invalidated.
+ */
+template <class GetNeighborRelation>
+class ContactNeighborSearch : public NeighborSearch<GetNeighborRelation>
+{
+  protected:
+    StdVec<bool> &is_all_candidates_;
+    size_t contact_index_;
+
+  public:
+    ContactNeighborSearch(CellLinkedList &target_cell_linked_list, int search_depth,
+                          ParticleConfiguration &particle_configuration, GetNeighborRelation &get_neighbor_relation,
+                          StdVec<bool> &is_all_candidates, size_t contact_index)
+        : NeighborSearch<GetNeighborRelation>(target_cell_linked_list, search_depth,
+                                              particle_configuration, get_neighbor_relation),
+          is_all_candidates_(is_all_candidates), contact_index_(contact_index){};
+    virtual ~ContactNeighborSearch(){};
+
+    virtual void setupSearch() override { is_all_candidates_[contact_index_] = true; };
+};
+
 /**
  * @class ContactRelationCrossResolution
  * @brief The relation between a SPH body and its contact SPH bodies
@@ -48,7 +72,7 @@ class ContactRelationCrossResolution : public BaseContactRelation
   public:
     template <typename... Args>
     ContactRelationCrossResolution(SPHBody &sph_body, Args &&...args)
-        : BaseContactRelation(sph_body, std::forward<Args>(args)...)
+        : BaseContactRelation(sph_body, std::forward<Args>(args)...), candidate_real_particles_(0)
     {
         for (size_t k = 0; k != contact_bodies_.size(); ++k)
         {
@@ -60,17 +84,68 @@ class ContactRelationCrossResolution : public BaseContactRelation
                     sph_body_, target_cell_linked_list));
         }
         resizeConfiguration();
+        candidate_particles_.resize(contact_bodies_.size());
+        is_all_candidates_.resize(contact_bodies_.size(), true);
     };
     virtual ~ContactRelationCrossResolution(){};
 
+    virtual void resizeConfiguration() override
+    {
+        BaseContactRelation::resizeConfiguration();
+        is_all_candidates_.assign(contact_bodies_.size(), true);
+    };
+
   protected:
     StdVec<CellLinkedList *> target_cell_linked_lists_;
     StdVec<SearchDepthContact *> get_search_depths_;
+    /**
+     * Source particles which may have neighbors in each contact body.
+     * Invariant: unless is_all_candidates_[k] is set, every real source particle not in candidate_particles_[k]
+     * has an empty neighborhood in contact_configuration_[k], so that only the candidates are reset before a search.
+     * The candidates are current only when the configuration has been filled by the last broad phase search
+     * with the same number of real source particles. Any other filling or resizing of the configuration,
+     * e.g. by the fused update of RelationManager, sets is_all_candidates_[k].
+     */
+    StdVec<IndexVector> candidate_particles_;
+    /** whether all source particles are candidates, e.g. when the broad phase is not applicable */
+    StdVec<bool> is_all_candidates_;
+    /** the number of real source particles when the candidates were found */
+    size_t candidate_real_particles_;
+    StdLargeVec<size_t> candidate_marks_;
+    StdLargeVec<size_t> candidate_offsets_;
+    UniquePtrsKeeper<BaseNeighborSearch> neighbor_search_ptrs_keeper_;
+    StdVec<BaseNeighborSearch *> contact_neighbor_searches_;
+
+    template <class GetNeighborRelation>
+    void createContactNeighborSearches(StdVec<GetNeighborRelation *> &get_contact_neighbors)
+    {
+        for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        {
+            contact_neighbor_searches_.push_back(
+                neighbor_search_ptrs_keeper_.createPtr<ContactNeighborSearch<GetNeighborRelation>>(
+                    *target_cell_linked_lists_[k], get_search_depths_[k]->search_depth_,
+                    contact_configuration_[k], *get_contact_neighbors[k], is_all_candidates_, k));
+        }
+    };
+
+    /**
+     * @brief Broad phase before the neighbor search.
+     * @details The bounds of the source particles are compared with those of each contact body
+     * extended by the search range. Non-overlapping body pairs are skipped entirely,
+     * and only the source particles inside the overlap region are searched.
+     * Only the neighborhoods of the previous candidates are reset if they are current,
+     * otherwise those of all real source particles.
+     */
+    template <class DynamicsRange, class GetNeighborRelation>
+    void searchNeighborsWithBroadPhase(DynamicsRange &dynamics_range,
+                                       StdVec<GetNeighborRelation *> &get_contact_neighbors);
 };
 
 /**
  * @class ContactRelation
  * @brief The relation between a SPH body and its contact SPH bodies
+ * @details If the kernels chosen for all body pairs are KernelWendlandC2 or KernelCubicBSpline,
+ * the neighbor builders with the kernel type given at compile time are used.
  */
 class ContactRelation : public ContactRelationCrossResolution
 {
@@ -81,9 +156,19 @@ class ContactRelation : public ContactRelationCrossResolution
     ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies);
     virtual ~ContactRelation(){};
     virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override;
 
   protected:
     StdVec<NeighborBuilderContact *> get_contact_neighbors_;
+    /** the search with the neighbor builders chosen by the kernel types at construction */
+    std::function<void()> search_contact_neighbors_;
+
+    template <class KernelType>
+    bool isContactKernelType();
+    template <class KernelType>
+    void setTypedContactNeighborSearches();
+    template <class GetNeighborRelation>
+    void setContactNeighborSearches(const StdVec<GetNeighborRelation *> &get_contact_neighbors);
 };
 
 /**
@@ -109,8 +194,6 @@ class SurfaceContactRelation : public ContactRelationCrossResolution
   protected:
     IndexVector &body_part_particles_;
     StdVec<NeighborBuilderSurfaceContact *> get_contact_neighbors_;
-
-    virtual void resetNeighborhoodCurrentSize() override;
 };
 
 /**
@@ -129,6 +212,7 @@ class ContactRelationToBodyPart : public ContactRelationCrossResolution
     virtual ~ContactRelationToBodyPart(){};
 
     virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override;
 };
 
 /**
@@ -8,14 +8,180 @@ namespace SPH
 //=================================================================================================//
 InnerRelation::InnerRelation(RealBody &real_body)
     : BaseInnerRelation(real_body), get_inner_neighbor_(real_body),
-      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())),
+      inner_neighbor_search_(nullptr), use_stencil_search_(false)
+{
+    Kernel &kernel = *real_body.sph_adaptation_->getKernel();
+    if (typeid(kernel) == typeid(KernelWendlandC2))
+    {
+        setInnerNeighborSearch(*typed_inner_neighbor_keeper_.createPtr<NeighborBuilderInnerTyped<KernelWendlandC2>>(real_body));
+        setStencilNeighborSearch(DynamicCast<KernelWendlandC2>(this, kernel));
+    }
+    else if (typeid(kernel) == typeid(KernelCubicBSpline))
+    {
+        setInnerNeighborSearch(*typed_inner_neighbor_keeper_.createPtr<NeighborBuilderInnerTyped<KernelCubicBSpline>>(real_body));
+        setStencilNeighborSearch(DynamicCast<KernelCubicBSpline>(this, kernel));
+    }
+    else
+    {
+        setInnerNeighborSearch(get_inner_neighbor_);
+        setStencilNeighborSearch(kernel);
+    }
+}
+//=================================================================================================//
+template <class GetNeighborRelation>
+void InnerRelation::setInnerNeighborSearch(GetNeighborRelation &get_inner_neighbor)
+{
+    GetNeighborRelation *get_neighbor_relation = &get_inner_neighbor;
+    inner_neighbor_search_ = inner_neighbor_search_keeper_.createPtr<NeighborSearch<GetNeighborRelation>>(
+        cell_linked_list_, get_single_search_depth_(0), inner_configuration_, get_inner_neighbor);
+    search_inner_neighbors_ = [this, get_neighbor_relation]()
+    {
+        cell_linked_list_.searchNeighborsByParticles(
+            sph_body_, inner_configuration_,
+            get_single_search_depth_, *get_neighbor_relation);
+    };
+}
+//=================================================================================================//
+template <class KernelType>
+void InnerRelation::setStencilNeighborSearch(KernelType &kernel)
+{
+    KernelType *typed_kernel = &kernel;
+    search_inner_neighbors_by_stencil_ = [this, typed_kernel]()
+    {
+        cell_linked_list_.searchInnerNeighborsByStencil(
+            sph_body_, inner_configuration_, get_single_search_depth_(0), *typed_kernel);
+    };
+}
 //=================================================================================================//
 void InnerRelation::updateConfiguration()
 {
     resetNeighborhoodCurrentSize();
-    cell_linked_list_.searchNeighborsByParticles(
-        sph_body_, inner_configuration_,
-        get_single_search_depth_, get_inner_neighbor_);
+    use_stencil_search_ ? search_inner_neighbors_by_stencil_() : search_inner_neighbors_();
+    countConfigurationUpdate();
+}
+//=================================================================================================//
+bool InnerRelation::collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches)
+{
+    /** the stencil search is not fused with the other relations */
+    if (use_stencil_search_)
+        return false;
+    neighbor_searches.push_back(inner_neighbor_search_);
+    return true;
+}
+//=================================================================================================//
+TotalLagrangianInnerRelation::TotalLagrangianInnerRelation(RealBody &real_body)
+    : InnerRelation(real_body), is_configuration_frozen_(false), is_gradient_packed_(false) {}
+//=================================================================================================//
+void TotalLagrangianInnerRelation::resizeConfiguration()
+{
+    InnerRelation::resizeConfiguration();
+    if (is_configuration_frozen_)
+    {
+        size_t total_neighbors = neighbor_offset_.back();
+        neighbor_offset_.resize(base_particles_.real_particles_bound_ + 1, total_neighbors);
+    }
+}
+//=================================================================================================//
+void TotalLagrangianInnerRelation::updateConfiguration()
+{
+    if (is_configuration_frozen_)
+        return;
+
+    InnerRelation::updateConfiguration();
+
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    StdLargeVec<size_t> neighbor_counts(total_real_particles);
+    particle_for(execution::ParallelPolicy(), total_real_particles,
+                 [&](size_t index_i)
+                 { neighbor_counts[index_i] = inner_configuration_[index_i].current_size_; });
+    neighbor_offset_.resize(total_real_particles + 1);
+    size_t total_neighbors = particle_scan(execution::ParallelPolicy(), neighbor_counts, neighbor_offset_);
+    neighbor_offset_[total_real_particles] = total_neighbors;
+
+    j_.resize(total_neighbors);
+    W_ij_.resize(total_neighbors);
+    dW_ijV_j_.resize(total_neighbors);
+    r_ij_.resize(total_neighbors);
+    gradW_ijV_j_.resize(total_neighbors);
+    particle_for(execution::ParallelPolicy(), total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         size_t k = neighbor_offset_[index_i] + n;
+                         j_[k] = inner_neighborhood.j_[n];
+                         W_ij_[k] = inner_neighborhood.W_ij_[n];
+                         dW_ijV_j_[k] = inner_neighborhood.dW_ijV_j_[n];
+                         r_ij_[k] = inner_neighborhood.r_ij_[n];
+                         gradW_ijV_j_[k] = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                     }
+                 });
+    /** Before the correction matrix is computed, the gradients are taken as uncorrected. */
+    B_gradW_ijV_j_ = gradW_ijV_j_;
+    is_configuration_frozen_ = true;
+}
+//=================================================================================================//
+void TotalLagrangianInnerRelation::packCorrectedGradients()
+{
+    StdLargeVec<Matd> *B = base_particles_.getVariableByName<Matd>("CorrectionMatrix");
+    if (B == nullptr || !is_configuration_frozen_)
+    {
+        std::cout << "\n Error: the correction matrix or the frozen configuration is not available!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    particle_for(execution::ParallelPolicy(), total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     Matd B_T = (*B)[index_i].transpose();
+                     for (size_t k = neighbor_offset_[index_i]; k != neighbor_offset_[index_i + 1]; ++k)
+                         B_gradW_ijV_j_[k] = B_T * gradW_ijV_j_[k];
+                 });
+    is_gradient_packed_ = true;
+}
+//=================================================================================================//
+void TotalLagrangianInnerRelation::checkCorrectedGradientsPacked()
+{
+    if (!is_gradient_packed_)
+        packCorrectedGradients();
+}
+//=================================================================================================//
+ImplicitInnerRelation::ImplicitInnerRelation(RealBody &real_body)
+    : SPHRelation(real_body), real_body_(real_body),
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())),
+      kernel_(*real_body.sph_adaptation_->getKernel())
+{
+    subscribeToBody();
+}
+//=================================================================================================//
+void ImplicitInnerRelation::resizeConfiguration()
+{
+    size_t total_neighbors = neighbor_offset_.empty() ? 0 : neighbor_offset_.back();
+    neighbor_offset_.resize(base_particles_.real_particles_bound_ + 1, total_neighbors);
+}
+//=================================================================================================//
+void ImplicitInnerRelation::updateConfiguration()
+{
+    /** checked for each update, as the number of particles may grow after the relation is created */
+    if (base_particles_.total_real_particles_ > size_t(std::numeric_limits<NeighborIndex>::max()))
+    {
+        std::cout << "\n Error: the number of particles exceeds the range of the neighbor index!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    if (cell_linked_list_.hasPeriodicImages())
+    {
+        std::cout << "\n Error: the implicit inner relation does not support periodic images!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    cell_linked_list_.searchInnerNeighborIndicesByStencil(
+        sph_body_, get_single_search_depth_(0), kernel_.CutOffRadiusSqr(), neighbor_offset_, j_);
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 AdaptiveInnerRelation::
@@ -44,6 +210,7 @@ void AdaptiveInnerRelation::updateConfiguration()
             sph_body_, inner_configuration_,
             *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor_);
     }
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 SelfSurfaceContactRelation::
@@ -69,11 +236,13 @@ void SelfSurfaceContactRelation::updateConfiguration()
     cell_linked_list_.searchNeighborsByParticles(
         body_surface_layer_, inner_configuration_,
         get_single_search_depth_, get_self_contact_neighbor_);
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 void TreeInnerRelation::updateConfiguration()
 {
     generative_tree_.buildParticleConfiguration(inner_configuration_);
+    countConfigurationUpdate();
 }
 //=================================================================================================//
 } // namespace SPH
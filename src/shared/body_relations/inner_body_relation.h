@@ -43,12 +43,112 @@ class InnerRelation : public BaseInnerRelation
     SearchDepthSingleResolution get_single_search_depth_;
     NeighborBuilderInner get_inner_neighbor_;
     CellLinkedList &cell_linked_list_;
+    UniquePtrKeeper<NeighborBuilderInner> typed_inner_neighbor_keeper_;
+    UniquePtrKeeper<BaseNeighborSearch> inner_neighbor_search_keeper_;
+    BaseNeighborSearch *inner_neighbor_search_;
+    /** the search with the neighbor builder chosen by the kernel type at construction */
+    std::function<void()> search_inner_neighbors_;
+    /** the search on the contiguous stencil cell data, used when enabled */
+    bool use_stencil_search_;
+    std::function<void()> search_inner_neighbors_by_stencil_;
+
+    template <class GetNeighborRelation>
+    void setInnerNeighborSearch(GetNeighborRelation &get_inner_neighbor);
+    template <class KernelType>
+    void setStencilNeighborSearch(KernelType &kernel);
 
   public:
     explicit InnerRelation(RealBody &real_body);
     virtual ~InnerRelation(){};
 
+    /** Use the stencil search, which gives the same neighbors with less memory traffic
+     *  but keeps a contiguous copy of the cell list data. */
+    void useStencilSearch() { use_stencil_search_ = true; };
+
+    virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override;
+};
+
+/**
+ * @class TotalLagrangianInnerRelation
+ * @brief The inner relation with frozen topology for total Lagrangian solid bodies.
+ * @details The configuration is built only once in the reference configuration.
+ * The neighbor data are then packed contiguously for each particle in compressed row layout,
+ * together with the kernel gradients pre-multiplied by the correction matrix, i.e. B_i^T gradW_ijV_j.
+ * Note that the packed data are in Real, i.e. in float when built with SPHINXSYS_USE_FLOAT.
+ */
+class TotalLagrangianInnerRelation : public InnerRelation
+{
+  protected:
+    bool is_configuration_frozen_;
+    bool is_gradient_packed_;
+
+  public:
+    StdLargeVec<size_t> neighbor_offset_; /**< offset of the packed neighbors of each particle */
+    StdLargeVec<size_t> j_;
+    StdLargeVec<Real> W_ij_, dW_ijV_j_, r_ij_;
+    StdLargeVec<Vecd> gradW_ijV_j_;   /**< dW_ijV_j e_ij */
+    StdLargeVec<Vecd> B_gradW_ijV_j_; /**< B_i^T dW_ijV_j e_ij */
+
+    explicit TotalLagrangianInnerRelation(RealBody &real_body);
+    virtual ~TotalLagrangianInnerRelation(){};
+
+    /** The packed rows of the buffer particles are kept empty. */
+    virtual void resizeConfiguration() override;
+    /** The configuration is built and packed only once. */
+    virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override { return false; };
+    /** Pack the pre-multiplied kernel gradients after the correction matrix is computed. */
+    void packCorrectedGradients();
+    /** Pack the gradients if not yet, called by the packed dynamics before their first step.
+     *  The gradients are to be packed explicitly again if the correction matrix is recomputed later. */
+    void checkCorrectedGradientsPacked();
+};
+
+/**
+ * @class ImplicitInnerRelation
+ * @brief The inner relation storing only the 32-bit neighbor indices in compressed rows.
+ * @details The pair data are recomputed from the current positions by the accessor given by getNeighborhood,
+ * which uses about 4 instead of 40-56 bytes per pair for bandwidth-bound cases.
+ * Only constant smoothing length without periodic images is supported,
+ * as the displacement is computed directly from the particle positions.
+ */
+class ImplicitInnerRelation : public SPHRelation
+{
+  protected:
+    RealBody &real_body_;
+    CellLinkedList &cell_linked_list_;
+    Kernel &kernel_;
+    SearchDepthSingleResolution get_single_search_depth_;
+
+  public:
+    StdLargeVec<size_t> neighbor_offset_; /**< offset of the neighbors of each particle */
+    StdLargeVec<NeighborIndex> j_;        /**< neighbor indices in compressed rows */
+
+    explicit ImplicitInnerRelation(RealBody &real_body);
+    virtual ~ImplicitInnerRelation(){};
+
+    /** The rows of the buffer particles are kept empty until the configuration is updated. */
+    virtual void resizeConfiguration() override;
     virtual void updateConfiguration() override;
+    /** the accessor to the neighbors of particle i, with the kernel type given at compile time if known */
+    template <class KernelType = Kernel>
+    ImplicitNeighborhood<KernelType> getNeighborhood(size_t index_i, const KernelType &kernel)
+    {
+        return ImplicitNeighborhood<KernelType>(
+            j_.data() + neighbor_offset_[index_i], neighbor_offset_[index_i + 1] - neighbor_offset_[index_i],
+            base_particles_.pos_[index_i], base_particles_.pos_, base_particles_.Vol_, kernel);
+    };
+    ImplicitNeighborhood<Kernel> getNeighborhood(size_t index_i) { return getNeighborhood(index_i, kernel_); };
+    virtual size_t NeighborCount(size_t index_i) override
+    {
+        return neighbor_offset_[index_i + 1] - neighbor_offset_[index_i];
+    };
+    /** the memory of the neighbor indices and offsets in bytes */
+    size_t MemoryFootprint()
+    {
+        return j_.capacity() * sizeof(NeighborIndex) + neighbor_offset_.capacity() * sizeof(size_t);
+    };
 };
 
 /**
@@ -111,6 +211,7 @@ class TreeInnerRelation : public InnerRelation
     virtual ~TreeInnerRelation(){};
 
     virtual void updateConfiguration() override;
+    virtual bool collectNeighborSearches(StdVec<BaseNeighborSearch *> &neighbor_searches) override { return false; };
 };
 } // namespace SPH
 #endif // INNER_BODY_RELATION_H
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "relation_manager.h"
+#include "base_particle_dynamics.h"
+#include "cell_linked_list.hpp"
+#include "sph_system.h"
+
+namespace SPH
+{
+//=================================================================================================//
+RelationManager::RelationManager(SPHSystem &sph_system)
+{
+    for (SPHBody *sph_body : sph_system.sph_bodies_)
+    {
+        for (SPHRelation *relation : sph_body->body_relations_)
+        {
+            addRelation(relation);
+        }
+    }
+}
+//=================================================================================================//
+RelationManager::RelationManager(StdVec<SPHRelation *> relations)
+{
+    for (SPHRelation *relation : relations)
+    {
+        addRelation(relation);
+    }
+}
+//=================================================================================================//
+void RelationManager::addRelation(SPHRelation *relation)
+{
+    SPHBody *sph_body = &relation->getSPHBody();
+    if (std::find(sph_bodies_.begin(), sph_bodies_.end(), sph_body) == sph_bodies_.end())
+        sph_bodies_.push_back(sph_body);
+
+    if (std::find(separate_relations_.begin(), separate_relations_.end(), relation) != separate_relations_.end() ||
+        std::find(fused_relations_.begin(), fused_relations_.end(), relation) != fused_relations_.end())
+        return;
+
+    StdVec<BaseNeighborSearch *> neighbor_searches;
+    if (!relation->collectNeighborSearches(neighbor_searches))
+    {
+        separate_relations_.push_back(relation);
+        return;
+    }
+    fused_relations_.push_back(relation);
+
+    for (BaseNeighborSearch *neighbor_search : neighbor_searches)
+    {
+        addNeighborSearch(&relation->getSPHBody(), neighbor_search);
+    }
+}
+//=================================================================================================//
+void RelationManager::addNeighborSearch(SPHBody *sph_body, BaseNeighborSearch *neighbor_search)
+{
+    /** the same search may be collected by more than one relations, e.g. by a complex relation and its inner relation */
+    if (std::find(neighbor_searches_.begin(), neighbor_searches_.end(), neighbor_search) != neighbor_searches_.end())
+        return;
+    neighbor_searches_.push_back(neighbor_search);
+
+    auto target = std::find_if(target_neighbor_searches_.begin(), target_neighbor_searches_.end(),
+                               [&](const TargetNeighborSearches &searches)
+                               { return searches.target_cell_linked_list_ == &neighbor_search->target_cell_linked_list_; });
+    if (target == target_neighbor_searches_.end())
+    {
+        target_neighbor_searches_.push_back(TargetNeighborSearches{&neighbor_search->target_cell_linked_list_, {}});
+        target = target_neighbor_searches_.end() - 1;
+    }
+
+    StdVec<SourceNeighborSearches> &source_searches = target->source_neighbor_searches_;
+    auto source = std::find_if(source_searches.begin(), source_searches.end(),
+                               [&](const SourceNeighborSearches &searches)
+                               { return searches.sph_body_ == sph_body; });
+    if (source == source_searches.end())
+    {
+        source_searches.push_back(SourceNeighborSearches{sph_body, {}});
+        source = source_searches.end() - 1;
+    }
+    source->neighbor_searches_.push_back(neighbor_search);
+}
+//=================================================================================================//
+void RelationManager::updateConfigurations()
+{
+    for (SPHRelation *relation : separate_relations_)
+    {
+        relation->updateConfiguration();
+    }
+
+    for (BaseNeighborSearch *neighbor_search : neighbor_searches_)
+    {
+        neighbor_search->setupSearch();
+    }
+
+    for (TargetNeighborSearches &target : target_neighbor_searches_)
+    {
+        for (SourceNeighborSearches &source : target.source_neighbor_searches_)
+        {
+            BaseParticles &base_particles = source.sph_body_->getBaseParticles();
+            StdLargeVec<Vecd> &pos = base_particles.pos_;
+            particle_for(execution::ParallelPolicy(), base_particles.total_real_particles_,
+                         [&](size_t index_i)
+                         {
+                             for (BaseNeighborSearch *neighbor_search : source.neighbor_searches_)
+                             {
+                                 neighbor_search->searchNeighbors(index_i, pos[index_i]);
+                             }
+                         });
+        }
+    }
+
+    for (SPHRelation *relation : fused_relations_)
+    {
+        relation->countConfigurationUpdate();
+    }
+
+    for (SPHBody *sph_body : sph_bodies_)
+    {
+        if (sph_body->getWorkloadBalancing())
+            sph_body->balanceWorkload();
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,80 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	relation_manager.h
+ * @brief 	The fused configuration update of a group of body relations.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef RELATION_MANAGER_H
+#define RELATION_MANAGER_H
+
+#include "base_body_relation.h"
+
+namespace SPH
+{
+class SPHSystem;
+/**
+ * @class RelationManager
+ * @brief Update the configurations of a group of relations together.
+ * @details The neighbor searches of the relations are grouped by their target cell linked lists
+ * and then by their source bodies. The searches in one target cell linked list are carried out
+ * one after another for all source bodies, e.g. the wall cell linked list searched by the fluid and the observers,
+ * so that the target cell data are reused in cache, and each source body is traversed once for each target.
+ * The relations not supporting the fused update are updated separately as usual.
+ * Afterwards, the workload of the bodies with workload balancing is balanced by the new configurations.
+ */
+class RelationManager
+{
+  public:
+    /** manage all relations subscribed to the bodies of the system */
+    explicit RelationManager(SPHSystem &sph_system);
+    explicit RelationManager(StdVec<SPHRelation *> relations);
+    virtual ~RelationManager(){};
+
+    void updateConfigurations();
+
+  protected:
+    struct SourceNeighborSearches
+    {
+        SPHBody *sph_body_;
+        StdVec<BaseNeighborSearch *> neighbor_searches_;
+    };
+
+    struct TargetNeighborSearches
+    {
+        CellLinkedList *target_cell_linked_list_;
+        StdVec<SourceNeighborSearches> source_neighbor_searches_;
+    };
+
+    StdVec<SPHBody *> sph_bodies_; /**< the bodies centered by the relations */
+    StdVec<SPHRelation *> separate_relations_;
+    StdVec<SPHRelation *> fused_relations_;
+    StdVec<BaseNeighborSearch *> neighbor_searches_;
+    StdVec<TargetNeighborSearches> target_neighbor_searches_;
+
+    void addRelation(SPHRelation *relation);
+    void addNeighborSearch(SPHBody *sph_body, BaseNeighborSearch *neighbor_search);
+};
+} // namespace SPH
+#endif // RELATION_MANAGER_H
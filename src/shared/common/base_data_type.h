@@ -89,6 +89,16 @@ using AlignedBox3d = Eigen::AlignedBox<Real, 3>;
 using Rotation2d = Eigen::Rotation2D<Real>;
 using Rotation3d = Eigen::AngleAxis<Real>;
 
+/** Storage type of the neighbor data, in float for the mixed-precision build,
+ *  while the particle states and the accumulations stay in Real. */
+#if SPHINXSYS_USE_MIXED_PRECISION
+using NeighborReal = float;
+#else
+using NeighborReal = Real;
+#endif
+using NeighborVec2d = Eigen::Matrix<NeighborReal, 2, 1>;
+using NeighborVec3d = Eigen::Matrix<NeighborReal, 3, 1>;
+
 /** Unified initialize to zero for all data type. */
 /**
  * NOTE: Eigen::Matrix<> constexpr constructor?
@@ -0,0 +1,65 @@
+#include "large_data_containers.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+//=================================================================================================//
+namespace SPH
+{
+//=================================================================================================//
+void *allocateLargeData(size_t bytes)
+{
+    size_t page_bytes = 4096;
+#ifdef __linux__
+    page_bytes = size_t(sysconf(_SC_PAGESIZE));
+#endif
+    bool use_huge_pages = LargeDataAllocation::use_huge_pages_;
+    size_t alignment = use_huge_pages ? LargeDataAllocation::huge_page_bytes_ : page_bytes;
+    void *pointer = scalable_aligned_malloc(bytes, alignment);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+
+#ifdef __linux__
+    if (use_huge_pages)
+    {
+        size_t aligned_bytes = (bytes + alignment - 1) / alignment * alignment;
+        static bool is_warned = false;
+        if (madvise(pointer, aligned_bytes, MADV_HUGEPAGE) != 0 && !is_warned)
+        {
+            is_warned = true;
+            std::cout << "\n Warning: transparent huge pages are not available for large data." << std::endl;
+        }
+    }
+#endif
+
+    if (LargeDataAllocation::parallel_first_touch_)
+    {
+        char *data = static_cast<char *>(pointer);
+        size_t touch_bytes = use_huge_pages ? LargeDataAllocation::huge_page_bytes_ : page_bytes;
+        size_t number_of_pages = (bytes + touch_bytes - 1) / touch_bytes;
+        parallel_for(
+            IndexRange(0, number_of_pages),
+            [&](const IndexRange &r)
+            {
+                size_t begin = r.begin() * touch_bytes;
+                size_t end = std::min(r.end() * touch_bytes, bytes);
+                std::memset(data + begin, 0, end - begin);
+            },
+            ap);
+    }
+    return pointer;
+}
+//=================================================================================================//
+void deallocateLargeData(void *pointer)
+{
+    scalable_aligned_free(pointer);
+}
+//=================================================================================================//
+} // namespace SPH
+//=================================================================================================//
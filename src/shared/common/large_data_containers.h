@@ -36,6 +36,7 @@
 #include "tbb/concurrent_vector.h"
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
+#include "tbb/parallel_scan.h"
 #include "tbb/scalable_allocator.h"
 #include "tbb/tick_count.h"
 
@@ -44,7 +45,11 @@
 namespace SPH
 {
 
-static tbb::affinity_partitioner ap;
+/** The affinity partitioner of the parallel loops, one for each thread calling them,
+ *  so that the loops called concurrently from different threads, e.g. in different task arenas,
+ *  do not share the affinity records of the partitioner.
+ *  It is shared by all translation units, also with the parallel first touch of large data. */
+inline thread_local tbb::affinity_partitioner ap;
 typedef tbb::blocked_range<size_t> IndexRange;
 typedef tbb::blocked_range2d<size_t> IndexRange2d;
 typedef tbb::blocked_range3d<size_t> IndexRange3d;
@@ -55,8 +60,59 @@ typedef tbb::tick_count::interval_t TimeInterval;
 template <typename T>
 using ConcurrentVec = tbb::concurrent_vector<T>;
 
+/**
+ * @struct LargeDataAllocation
+ * @brief The settings for allocating large data, which is off by default.
+ * 		  With the parallel first touch, the memory pages of a large data are touched
+ * 		  with the same affinity partitioner as particle_for, which splits the pages as the particles,
+ * 		  so that they are placed on the NUMA nodes of the threads working on them later.
+ * 		  Transparent huge pages are advised for the large data if required.
+ */
+struct LargeDataAllocation
+{
+    inline static bool parallel_first_touch_ = false;
+    inline static bool use_huge_pages_ = false;
+    static constexpr size_t large_data_bytes_ = size_t(1) << 21; /**< the data from this size are large data */
+    static constexpr size_t huge_page_bytes_ = size_t(1) << 21;
+};
+void *allocateLargeData(size_t bytes);
+void deallocateLargeData(void *pointer);
+/**
+ * @class LargeDataAllocator
+ * @brief The cache aligned allocator for small data and the page aligned allocator
+ * 		  with the NUMA-aware settings for large data.
+ */
+template <typename T>
+class LargeDataAllocator
+{
+  public:
+    using value_type = T;
+    LargeDataAllocator() = default;
+    template <typename U>
+    LargeDataAllocator(const LargeDataAllocator<U> &){};
+
+    T *allocate(size_t n)
+    {
+        return n * sizeof(T) < LargeDataAllocation::large_data_bytes_
+                   ? tbb::cache_aligned_allocator<T>().allocate(n)
+                   : static_cast<T *>(allocateLargeData(n * sizeof(T)));
+    };
+
+    void deallocate(T *pointer, size_t n)
+    {
+        n * sizeof(T) < LargeDataAllocation::large_data_bytes_
+            ? tbb::cache_aligned_allocator<T>().deallocate(pointer, n)
+            : deallocateLargeData(pointer);
+    };
+};
+
+template <typename T, typename U>
+bool operator==(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return true; };
+template <typename T, typename U>
+bool operator!=(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return false; };
+
 template <typename T>
-using StdLargeVec = std::vector<T, tbb::cache_aligned_allocator<T>>;
+using StdLargeVec = std::vector<T, LargeDataAllocator<T>>;
 
 template <typename T>
 using StdVec = std::vector<T>;
@@ -108,6 +108,21 @@ class BaseBoundingBox
         }
         return is_contain;
     };
+    /** Check the bounding box contain another one. */
+    bool checkContain(const BaseBoundingBox &other)
+    {
+        return checkContain(other.first_) && checkContain(other.second_);
+    };
+    /** Check the bounding box overlap with another one. */
+    bool checkOverlap(const BaseBoundingBox &other)
+    {
+        for (int i = 0; i < dimension_; ++i)
+        {
+            if (other.first_[i] > second_[i] || other.second_[i] < first_[i])
+                return false;
+        }
+        return true;
+    };
 };
 /** Operator define. */
 template <class T>
@@ -140,6 +155,13 @@ BoundingBoxType getIntersectionOfBoundingBoxes(const BoundingBoxType &bb1, const
     return bb;
 }
 
+/** Union of bounding boxes, i.e. the smallest bounding box containing both.*/
+template <class BoundingBoxType>
+BoundingBoxType getUnionOfBoundingBoxes(const BoundingBoxType &bb1, const BoundingBoxType &bb2)
+{
+    return BoundingBoxType(bb1.first_.cwiseMin(bb2.first_), bb1.second_.cwiseMax(bb2.second_));
+}
+
 /** obtain minimum dimension of a bounding box */
 template <class BoundingBoxType>
 Real MinimumDimension(const BoundingBoxType &bbox)
@@ -0,0 +1,173 @@
+#include "communicator.h"
+
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+void SerialCommunicator::exchangeBuffers(const StdVec<ByteBuffer> &send_buffers, StdVec<ByteBuffer> &receive_buffers)
+{
+    receive_buffers.resize(1);
+    receive_buffers[0] = send_buffers[0];
+}
+//=================================================================================================//
+LocalProcessCommunicator::LocalProcessCommunicator(int rank, const StdVec<int> &sockets)
+    : BaseCommunicator(rank, int(sockets.size())), sockets_(sockets) {}
+//=================================================================================================//
+LocalProcessCommunicator::~LocalProcessCommunicator()
+{
+#ifndef _WIN32
+    for (int r = 0; r != size_; ++r)
+        if (r != rank_)
+            close(sockets_[r]);
+#endif
+}
+//=================================================================================================//
+void LocalProcessCommunicator::sendBuffer(int socket, const ByteBuffer &buffer)
+{
+#ifndef _WIN32
+    size_t buffer_size = buffer.size();
+    ByteBuffer message;
+    appendToByteBuffer(message, buffer_size);
+    message.insert(message.end(), buffer.begin(), buffer.end());
+
+    size_t sent = 0;
+    while (sent < message.size())
+    {
+        ssize_t result = write(socket, message.data() + sent, message.size() - sent);
+        if (result <= 0)
+        {
+            std::cout << "\n Error: failed to send the buffer of rank " << rank_ << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        sent += size_t(result);
+    }
+#endif
+}
+//=================================================================================================//
+void LocalProcessCommunicator::receiveBuffer(int socket, ByteBuffer &buffer)
+{
+#ifndef _WIN32
+    auto receive_bytes = [&](char *data, size_t number_of_bytes)
+    {
+        size_t received = 0;
+        while (received < number_of_bytes)
+        {
+            ssize_t result = read(socket, data + received, number_of_bytes - received);
+            if (result <= 0)
+            {
+                std::cout << "\n Error: failed to receive the buffer of rank " << rank_ << "!" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+            received += size_t(result);
+        }
+    };
+
+    size_t buffer_size = 0;
+    receive_bytes(reinterpret_cast<char *>(&buffer_size), sizeof(size_t));
+    buffer.resize(buffer_size);
+    receive_bytes(buffer.data(), buffer_size);
+#endif
+}
+//=================================================================================================//
+void LocalProcessCommunicator::exchangeBuffers(const StdVec<ByteBuffer> &send_buffers, StdVec<ByteBuffer> &receive_buffers)
+{
+    receive_buffers.resize(size_);
+    receive_buffers[rank_] = send_buffers[rank_];
+    /** In each step, a rank sends to the one after and receives from the one before with the same distance.
+     *  The sending is carried out by another thread, so that large buffers do not lead to a deadlock. */
+    for (int step = 1; step < size_; ++step)
+    {
+        int destination = (rank_ + step) % size_;
+        int source = (rank_ - step + size_) % size_;
+        std::thread sender([&]()
+                           { sendBuffer(sockets_[destination], send_buffers[destination]); });
+        receiveBuffer(sockets_[source], receive_buffers[source]);
+        sender.join();
+    }
+}
+//=================================================================================================//
+int runOnLocalProcesses(int number_of_ranks, const std::function<int(BaseCommunicator &)> &function)
+{
+#ifndef _WIN32
+    /** sockets[r][s] is the end of the socket pair between rank r and s used by rank r */
+    StdVec<StdVec<int>> sockets(number_of_ranks, StdVec<int>(number_of_ranks, -1));
+    for (int r = 0; r != number_of_ranks; ++r)
+        for (int s = r + 1; s != number_of_ranks; ++s)
+        {
+            int socket_pair[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_pair) != 0)
+            {
+                std::cout << "\n Error: failed to create the sockets for the local processes!" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+            sockets[r][s] = socket_pair[0];
+            sockets[s][r] = socket_pair[1];
+        }
+
+    auto close_other_sockets = [&](int rank)
+    {
+        for (int r = 0; r != number_of_ranks; ++r)
+            if (r != rank)
+                for (int s = 0; s != number_of_ranks; ++s)
+                    if (s != r && sockets[r][s] >= 0)
+                        close(sockets[r][s]);
+    };
+
+    std::cout.flush();
+    StdVec<pid_t> children;
+    for (int rank = 1; rank != number_of_ranks; ++rank)
+    {
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            std::cout << "\n Error: failed to fork the local processes!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        if (pid == 0)
+        {
+            close_other_sockets(rank);
+            int result = 0;
+            {
+                LocalProcessCommunicator communicator(rank, sockets[rank]);
+                result = function(communicator);
+            }
+            std::cout.flush();
+            _exit(result);
+        }
+        children.push_back(pid);
+    }
+
+    close_other_sockets(0);
+    int result = 0;
+    {
+        LocalProcessCommunicator communicator(0, sockets[0]);
+        result = function(communicator);
+    }
+    for (pid_t child : children)
+    {
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            result = 1;
+    }
+    return result;
+#else
+    std::cout << "\n Error: the local processes are not supported on this platform!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+#endif
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,199 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	communicator.h
+ * @brief 	Here gives the communicators between the ranks of a distributed-memory run.
+ * @details The communicators follow the MPI style: each rank runs the same program
+ * 			and all ranks call the collective functions in the same order.
+ * 			Only an all-to-all exchange of byte buffers is required from a backend,
+ * 			from which the gathering and reduction operations are derived.
+ * 			The local process backend forks the ranks on one machine and
+ * 			connects each pair of ranks by a socket, so that it is used for testing
+ * 			without an MPI installation.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef COMMUNICATOR_H
+#define COMMUNICATOR_H
+
+#include "base_data_type.h"
+#include "sph_data_containers.h"
+
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace SPH
+{
+using ByteBuffer = StdVec<char>;
+
+/** append the bytes of a value to the buffer, which is only for trivially copyable types */
+template <typename DataType>
+void appendToByteBuffer(ByteBuffer &buffer, const DataType &value)
+{
+    static_assert(std::is_trivially_copyable<DataType>::value,
+                  "Only the trivially copyable types are appended as bytes!");
+    size_t old_size = buffer.size();
+    buffer.resize(old_size + sizeof(DataType));
+    std::memcpy(buffer.data() + old_size, reinterpret_cast<const char *>(&value), sizeof(DataType));
+};
+
+/** read a value from the buffer at the position, which is then moved forward */
+template <typename DataType>
+void readFromByteBuffer(const ByteBuffer &buffer, size_t &position, DataType &value)
+{
+    static_assert(std::is_trivially_copyable<DataType>::value,
+                  "Only the trivially copyable types are read as bytes!");
+    std::memcpy(reinterpret_cast<char *>(&value), buffer.data() + position, sizeof(DataType));
+    position += sizeof(DataType);
+};
+
+/** the vectors and matrices are appended element by element */
+template <typename ScalarType, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+void appendToByteBuffer(ByteBuffer &buffer, const Eigen::Matrix<ScalarType, Rows, Cols, Options, MaxRows, MaxCols> &value)
+{
+    for (Eigen::Index k = 0; k != value.size(); ++k)
+        appendToByteBuffer(buffer, value.data()[k]);
+};
+
+template <typename ScalarType, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+void readFromByteBuffer(const ByteBuffer &buffer, size_t &position,
+                        Eigen::Matrix<ScalarType, Rows, Cols, Options, MaxRows, MaxCols> &value)
+{
+    for (Eigen::Index k = 0; k != value.size(); ++k)
+        readFromByteBuffer(buffer, position, value.data()[k]);
+};
+
+/** the bounding boxes are appended by their lower and upper bounds */
+template <typename VecType>
+void appendToByteBuffer(ByteBuffer &buffer, const BaseBoundingBox<VecType> &value)
+{
+    appendToByteBuffer(buffer, value.first_);
+    appendToByteBuffer(buffer, value.second_);
+};
+
+template <typename VecType>
+void readFromByteBuffer(const ByteBuffer &buffer, size_t &position, BaseBoundingBox<VecType> &value)
+{
+    readFromByteBuffer(buffer, position, value.first_);
+    readFromByteBuffer(buffer, position, value.second_);
+};
+
+/**
+ * @class BaseCommunicator
+ * @brief The abstract communicator between the ranks.
+ */
+class BaseCommunicator
+{
+  public:
+    BaseCommunicator(int rank, int size) : rank_(rank), size_(size){};
+    virtual ~BaseCommunicator(){};
+
+    int Rank() { return rank_; };
+    int Size() { return size_; };
+    /** all-to-all exchange, the buffer for rank r is send_buffers[r]
+     *  and the one from rank r is given in receive_buffers[r] */
+    virtual void exchangeBuffers(const StdVec<ByteBuffer> &send_buffers, StdVec<ByteBuffer> &receive_buffers) = 0;
+    /** gather a value from all ranks in the order of the ranks */
+    template <typename DataType>
+    StdVec<DataType> allGather(const DataType &value);
+    /** reduce a value of all ranks, the result is the same on all ranks */
+    template <typename DataType, typename Operation>
+    DataType allReduce(const DataType &value, Operation &operation);
+    void barrier() { allGather(rank_); };
+
+  protected:
+    int rank_;
+    int size_;
+};
+
+/**
+ * @class SerialCommunicator
+ * @brief The communicator for a run with a single rank.
+ */
+class SerialCommunicator : public BaseCommunicator
+{
+  public:
+    SerialCommunicator() : BaseCommunicator(0, 1){};
+    virtual ~SerialCommunicator(){};
+    virtual void exchangeBuffers(const StdVec<ByteBuffer> &send_buffers, StdVec<ByteBuffer> &receive_buffers) override;
+};
+
+/**
+ * @class LocalProcessCommunicator
+ * @brief The communicator between the local processes forked by runOnLocalProcesses.
+ * 		  Each pair of ranks is connected by a socket pair.
+ */
+class LocalProcessCommunicator : public BaseCommunicator
+{
+  public:
+    /** the socket to rank r is sockets[r], the one to itself is not used */
+    LocalProcessCommunicator(int rank, const StdVec<int> &sockets);
+    virtual ~LocalProcessCommunicator();
+    virtual void exchangeBuffers(const StdVec<ByteBuffer> &send_buffers, StdVec<ByteBuffer> &receive_buffers) override;
+
+  protected:
+    StdVec<int> sockets_;
+    void sendBuffer(int socket, const ByteBuffer &buffer);
+    void receiveBuffer(int socket, ByteBuffer &buffer);
+};
+
+/**
+ * Fork the local processes as the ranks, each of which runs the function with its communicator.
+ * The calling process becomes rank 0, and zero is returned if the functions of all ranks return zero.
+ * It should be called before the parallel threads and the SPH system are created,
+ * as they are not duplicated by forking.
+ */
+int runOnLocalProcesses(int number_of_ranks, const std::function<int(BaseCommunicator &)> &function);
+//=================================================================================================//
+template <typename DataType>
+StdVec<DataType> BaseCommunicator::allGather(const DataType &value)
+{
+    ByteBuffer buffer;
+    appendToByteBuffer(buffer, value);
+    StdVec<ByteBuffer> send_buffers(size_, buffer);
+    StdVec<ByteBuffer> receive_buffers(size_);
+    exchangeBuffers(send_buffers, receive_buffers);
+
+    StdVec<DataType> values(size_);
+    for (int r = 0; r != size_; ++r)
+    {
+        size_t position = 0;
+        readFromByteBuffer(receive_buffers[r], position, values[r]);
+    }
+    return values;
+}
+//=================================================================================================//
+template <typename DataType, typename Operation>
+DataType BaseCommunicator::allReduce(const DataType &value, Operation &operation)
+{
+    StdVec<DataType> values = allGather(value);
+    /** reduced in the order of the ranks, so that the result is identical on all ranks */
+    DataType result = values[0];
+    for (int r = 1; r != size_; ++r)
+        result = operation(result, values[r]);
+    return result;
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // COMMUNICATOR_H
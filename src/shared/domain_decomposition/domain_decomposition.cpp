@@ -0,0 +1,332 @@
+#include "domain_decomposition.hpp"
+
+#include "cell_linked_list.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename DataType>
+struct packParticleData
+{
+    void operator()(ParticleData &particle_data, const IndexVector &indices, ByteBuffer &buffer) const
+    {
+        constexpr int type_index = DataTypeIndex<DataType>::value;
+        for (StdLargeVec<DataType> *variable : std::get<type_index>(particle_data))
+            for (size_t index : indices)
+                appendToByteBuffer(buffer, (*variable)[index]);
+    };
+};
+//=================================================================================================//
+template <typename DataType>
+struct unpackParticleData
+{
+    void operator()(ParticleData &particle_data, size_t first_index, size_t number_of_particles,
+                    const ByteBuffer &buffer, size_t &position) const
+    {
+        constexpr int type_index = DataTypeIndex<DataType>::value;
+        for (StdLargeVec<DataType> *variable : std::get<type_index>(particle_data))
+            for (size_t k = 0; k != number_of_particles; ++k)
+                readFromByteBuffer(buffer, position, (*variable)[first_index + k]);
+    };
+};
+//=================================================================================================//
+struct PackVariableToBuffer
+{
+    const IndexVector &indices_;
+    ByteBuffer &buffer_;
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable_data)
+    {
+        for (size_t index : indices_)
+            appendToByteBuffer(buffer_, variable_data[index]);
+    };
+};
+//=================================================================================================//
+struct UnpackVariableFromBuffer
+{
+    size_t first_index_;
+    size_t number_of_particles_;
+    const ByteBuffer &buffer_;
+    size_t &position_;
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable_data)
+    {
+        for (size_t k = 0; k != number_of_particles_; ++k)
+            readFromByteBuffer(buffer_, position_, variable_data[first_index_ + k]);
+    };
+};
+//=================================================================================================//
+DomainDecomposition::DomainDecomposition(RealBody &real_body, BaseCommunicator &communicator)
+    : real_body_(real_body), particles_(real_body.getBaseParticles()), communicator_(communicator),
+      rank_(communicator.Rank()), size_(communicator.Size()),
+      halo_width_(real_body.sph_adaptation_->getKernel()->CutOffRadius()),
+      halo_mesh_(real_body.getSPHSystemBounds(), halo_width_, 2),
+      splitters_(size_ - 1, 0), halo_sources_(size_), halo_offsets_(size_ + 1, 0),
+      first_halo_index_(0), total_halo_particles_(0)
+{
+    addVariableToExchange<Vecd>("Position");
+    addVariableToExchange<Real>("VolumetricMeasure");
+}
+//=================================================================================================//
+int DomainDecomposition::OwnerRank(size_t morton_key)
+{
+    return int(std::upper_bound(splitters_.begin(), splitters_.end(), morton_key) - splitters_.begin());
+}
+//=================================================================================================//
+StdLargeVec<size_t> &DomainDecomposition::computeMortonKeys()
+{
+    return real_body_.getCellLinkedList().computingSequence(particles_);
+}
+//=================================================================================================//
+void DomainDecomposition::updatePartition()
+{
+    size_t total_real_particles = particles_.total_real_particles_;
+    StdLargeVec<size_t> &morton_keys = computeMortonKeys();
+    StdVec<size_t> sorted_keys(morton_keys.begin(), morton_keys.begin() + total_real_particles);
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+    /** each rank contributes regular samples of its keys weighted by the number of particles they represent */
+    size_t number_of_samples = SMIN(total_real_particles, size_t(16 * size_));
+    ByteBuffer sample_buffer;
+    appendToByteBuffer(sample_buffer, number_of_samples);
+    for (size_t k = 0; k != number_of_samples; ++k)
+    {
+        appendToByteBuffer(sample_buffer, sorted_keys[(2 * k + 1) * total_real_particles / (2 * number_of_samples)]);
+        appendToByteBuffer(sample_buffer, Real(total_real_particles) / Real(number_of_samples));
+    }
+    StdVec<ByteBuffer> send_buffers(size_, sample_buffer);
+    StdVec<ByteBuffer> receive_buffers(size_);
+    communicator_.exchangeBuffers(send_buffers, receive_buffers);
+
+    StdVec<std::pair<size_t, Real>> samples;
+    for (int r = 0; r != size_; ++r)
+    {
+        size_t position = 0;
+        size_t number_of_rank_samples = 0;
+        readFromByteBuffer(receive_buffers[r], position, number_of_rank_samples);
+        for (size_t k = 0; k != number_of_rank_samples; ++k)
+        {
+            std::pair<size_t, Real> sample;
+            readFromByteBuffer(receive_buffers[r], position, sample.first);
+            readFromByteBuffer(receive_buffers[r], position, sample.second);
+            samples.push_back(sample);
+        }
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Real total_weight = 0.0;
+    for (const auto &sample : samples)
+        total_weight += sample.second;
+
+    splitters_.clear();
+    Real accumulated_weight = 0.0;
+    for (const auto &sample : samples)
+    {
+        while (int(splitters_.size()) < size_ - 1 &&
+               accumulated_weight >= Real(splitters_.size() + 1) * total_weight / Real(size_))
+            splitters_.push_back(sample.first);
+        accumulated_weight += sample.second;
+    }
+    while (int(splitters_.size()) < size_ - 1)
+        splitters_.push_back(std::numeric_limits<size_t>::max());
+}
+//=================================================================================================//
+void DomainDecomposition::keepOwnedParticles()
+{
+    StdLargeVec<size_t> &morton_keys = computeMortonKeys();
+    IndexVector not_owned;
+    for (size_t i = 0; i != particles_.total_real_particles_; ++i)
+        if (OwnerRank(morton_keys[i]) != rank_)
+            not_owned.push_back(i);
+    particles_.switchToBufferParticles(not_owned);
+}
+//=================================================================================================//
+void DomainDecomposition::migrateParticles()
+{
+    StdLargeVec<size_t> &morton_keys = computeMortonKeys();
+    StdVec<IndexVector> outgoing(size_);
+    IndexVector all_outgoing;
+    for (size_t i = 0; i != particles_.total_real_particles_; ++i)
+    {
+        int owner = OwnerRank(morton_keys[i]);
+        if (owner != rank_)
+        {
+            outgoing[owner].push_back(i);
+            all_outgoing.push_back(i);
+        }
+    }
+
+    ParticleData &all_particle_data = particles_.getAllParticleData();
+    DataAssembleOperation<packParticleData> pack_particle_data;
+    StdVec<ByteBuffer> send_buffers(size_);
+    for (int r = 0; r != size_; ++r)
+    {
+        appendToByteBuffer(send_buffers[r], outgoing[r].size());
+        pack_particle_data(all_particle_data, outgoing[r], send_buffers[r]);
+    }
+    particles_.switchToBufferParticles(all_outgoing);
+
+    StdVec<ByteBuffer> receive_buffers(size_);
+    communicator_.exchangeBuffers(send_buffers, receive_buffers);
+
+    DataAssembleOperation<unpackParticleData> unpack_particle_data;
+    for (int r = 0; r != size_; ++r)
+    {
+        size_t position = 0;
+        size_t number_of_incoming = 0;
+        readFromByteBuffer(receive_buffers[r], position, number_of_incoming);
+        if (r == rank_ || number_of_incoming == 0)
+            continue;
+        size_t first_new_index = particles_.addRealParticles(number_of_incoming);
+        unpack_particle_data(all_particle_data, first_new_index, number_of_incoming, receive_buffers[r], position);
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::packHaloParticles(StdVec<ByteBuffer> &send_buffers)
+{
+    ParticleData &all_particle_data = particles_.getAllParticleData();
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    send_buffers.resize(size_);
+    for (int r = 0; r != size_; ++r)
+    {
+        send_buffers[r].clear();
+        appendToByteBuffer(send_buffers[r], halo_sources_[r].size());
+        PackVariableToBuffer pack_variable{halo_sources_[r], send_buffers[r]};
+        loop_variable_namelist(all_particle_data, variables_to_exchange_, pack_variable);
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::unpackHaloParticles(const StdVec<ByteBuffer> &receive_buffers)
+{
+    ParticleData &all_particle_data = particles_.getAllParticleData();
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    for (int r = 0; r != size_; ++r)
+    {
+        size_t position = 0;
+        size_t number_of_halo_particles = 0;
+        readFromByteBuffer(receive_buffers[r], position, number_of_halo_particles);
+        if (number_of_halo_particles != halo_offsets_[r + 1] - halo_offsets_[r])
+        {
+            std::cout << "\n Error: the halo particles from rank " << r << " have been changed!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        UnpackVariableFromBuffer unpack_variable{first_halo_index_ + halo_offsets_[r],
+                                                 number_of_halo_particles, receive_buffers[r], position};
+        loop_variable_namelist(all_particle_data, variables_to_exchange_, unpack_variable);
+    }
+}
+//=================================================================================================//
+IndexVector DomainDecomposition::occupiedHaloCells(IndexVector &particle_cells)
+{
+    size_t total_real_particles = particles_.total_real_particles_;
+    StdLargeVec<Vecd> &pos = particles_.pos_;
+    Arrayi all_cells = halo_mesh_.AllCells();
+    particle_cells.resize(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        particle_cells[i] = halo_mesh_.transferMeshIndexTo1D(all_cells, halo_mesh_.CellIndexFromPosition(pos[i]));
+
+    IndexVector occupied_cells(particle_cells);
+    std::sort(occupied_cells.begin(), occupied_cells.end());
+    occupied_cells.erase(std::unique(occupied_cells.begin(), occupied_cells.end()), occupied_cells.end());
+    return occupied_cells;
+}
+//=================================================================================================//
+void DomainDecomposition::exchangeHaloParticles()
+{
+    IndexVector particle_cells;
+    IndexVector occupied_cells = occupiedHaloCells(particle_cells);
+    ByteBuffer cell_buffer;
+    appendToByteBuffer(cell_buffer, occupied_cells.size());
+    for (size_t cell : occupied_cells)
+        appendToByteBuffer(cell_buffer, cell);
+    StdVec<ByteBuffer> cell_send_buffers(size_, cell_buffer);
+    StdVec<ByteBuffer> cell_receive_buffers(size_);
+    communicator_.exchangeBuffers(cell_send_buffers, cell_receive_buffers);
+
+    /** As the grid spacing is the cutoff radius, the particles within the cutoff radius
+     *  of the particles of another rank are in the cells neighboring to the cells occupied by that rank.
+     *  The own occupied cells with such neighbors are marked for each rank. */
+    Arrayi all_cells = halo_mesh_.AllCells();
+    int number_of_neighbor_cells = 1;
+    for (int d = 0; d != Dimensions; ++d)
+        number_of_neighbor_cells *= 3;
+    for (int r = 0; r != size_; ++r)
+    {
+        halo_sources_[r].clear();
+        size_t position = 0;
+        size_t number_of_rank_cells = 0;
+        readFromByteBuffer(cell_receive_buffers[r], position, number_of_rank_cells);
+        if (r == rank_ || number_of_rank_cells == 0 || occupied_cells.empty())
+            continue;
+        IndexVector rank_cells(number_of_rank_cells);
+        for (size_t k = 0; k != number_of_rank_cells; ++k)
+            readFromByteBuffer(cell_receive_buffers[r], position, rank_cells[k]);
+
+        IndexVector near_cells;
+        for (size_t cell : occupied_cells)
+        {
+            Arrayi cell_index = halo_mesh_.transfer1DtoMeshIndex(all_cells, cell);
+            for (int n = 0; n != number_of_neighbor_cells; ++n)
+            {
+                Arrayi neighbor_index = cell_index;
+                for (int d = 0, stride = 1; d != Dimensions; ++d, stride *= 3)
+                    neighbor_index[d] += (n / stride) % 3 - 1;
+                if ((neighbor_index >= Arrayi::Zero()).all() && (neighbor_index < all_cells).all() &&
+                    std::binary_search(rank_cells.begin(), rank_cells.end(),
+                                       halo_mesh_.transferMeshIndexTo1D(all_cells, neighbor_index)))
+                {
+                    near_cells.push_back(cell);
+                    break;
+                }
+            }
+        }
+
+        for (size_t i = 0; i != particle_cells.size(); ++i)
+            if (std::binary_search(near_cells.begin(), near_cells.end(), particle_cells[i]))
+                halo_sources_[r].push_back(i);
+    }
+
+    StdVec<ByteBuffer> send_buffers(size_);
+    packHaloParticles(send_buffers);
+    StdVec<ByteBuffer> receive_buffers(size_);
+    communicator_.exchangeBuffers(send_buffers, receive_buffers);
+
+    for (int r = 0; r != size_; ++r)
+    {
+        size_t position = 0;
+        size_t number_of_halo_particles = 0;
+        readFromByteBuffer(receive_buffers[r], position, number_of_halo_particles);
+        halo_offsets_[r + 1] = halo_offsets_[r] + number_of_halo_particles;
+    }
+    total_halo_particles_ = halo_offsets_[size_];
+    first_halo_index_ = particles_.addGhostParticles(total_halo_particles_);
+    unpackHaloParticles(receive_buffers);
+
+    BaseCellLinkedList &cell_linked_list = real_body_.getCellLinkedList();
+    StdLargeVec<Vecd> &pos = particles_.pos_;
+    StdLargeVec<Real> &Vol = particles_.Vol_;
+    for (size_t k = 0; k != total_halo_particles_; ++k)
+    {
+        size_t halo_index = first_halo_index_ + k;
+        cell_linked_list.InsertListDataEntry(halo_index, pos[halo_index], Vol[halo_index]);
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::updateHaloParticles()
+{
+    StdVec<ByteBuffer> send_buffers(size_);
+    packHaloParticles(send_buffers);
+    StdVec<ByteBuffer> receive_buffers(size_);
+    communicator_.exchangeBuffers(send_buffers, receive_buffers);
+    unpackHaloParticles(receive_buffers);
+}
+//=================================================================================================//
+size_t DomainDecomposition::globalTotalRealParticles()
+{
+    ReduceSum<size_t> reduce_sum;
+    return communicator_.allReduce(particles_.total_real_particles_, reduce_sum);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,140 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	domain_decomposition.h
+ * @brief 	Here gives the spatial decomposition of a real body for distributed-memory runs.
+ * @details The particles of a body are partitioned along the Morton-ordered cells
+ * 			of its cell linked list, so that each rank owns a contiguous range of Morton keys
+ * 			with about the same number of particles.
+ * 			The particles leaving the range of a rank are migrated to their new owners,
+ * 			and the particles within the cutoff radius of the particles of other ranks
+ * 			are sent to them as halo particles, which are saved as ghost particles
+ * 			and inserted into the cell linked list after it is updated.
+ * 			As the partitions along the Morton keys are not compact,
+ * 			the halo particles are selected with the cells occupied by other ranks
+ * 			on a mesh whose grid spacing is the cutoff radius,
+ * 			rather than with the bounds of their particles, which overlap heavily.
+ * 			Only the variables added to exchange are sent for the halo particles,
+ * 			while all particle data are sent for the migrated particles.
+ * 			The migrated particles are realized from the buffer particles,
+ * 			which should be enough or growable for the incoming particles.
+ * 			The unsorted ids of the particles are local to each rank.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DOMAIN_DECOMPOSITION_H
+#define DOMAIN_DECOMPOSITION_H
+
+#include "base_body.h"
+#include "base_mesh.h"
+#include "base_particles.h"
+#include "communicator.h"
+#include "particle_dynamics_algorithms.h"
+
+namespace SPH
+{
+/**
+ * @class DomainDecomposition
+ * @brief The partition, particle migration and halo exchange of a real body.
+ * 		  The functions are collective, i.e. called by all ranks in the same order.
+ */
+class DomainDecomposition
+{
+  public:
+    DomainDecomposition(RealBody &real_body, BaseCommunicator &communicator);
+    virtual ~DomainDecomposition(){};
+
+    BaseCommunicator &getCommunicator() { return communicator_; };
+    /** the variables sent for the halo particles, the positions and volumes are always included */
+    template <typename DataType>
+    void addVariableToExchange(const std::string &variable_name);
+    /** the rank owning a Morton key */
+    int OwnerRank(size_t morton_key);
+    /** the Morton keys of the real particles from the cell linked list */
+    StdLargeVec<size_t> &computeMortonKeys();
+    /** balance the partition by the Morton keys of the present real particles on all ranks */
+    void updatePartition();
+    /** keep only the owned particles, used when all ranks have generated identical particles */
+    void keepOwnedParticles();
+    /** send the particles out of the partition of this rank to their owners */
+    void migrateParticles();
+    /** create the halo particles from other ranks, called just after the cell linked list is updated */
+    void exchangeHaloParticles();
+    /** update the exchanged variables of the present halo particles */
+    void updateHaloParticles();
+    size_t TotalHaloParticles() { return total_halo_particles_; };
+    size_t globalTotalRealParticles();
+
+  protected:
+    RealBody &real_body_;
+    BaseParticles &particles_;
+    BaseCommunicator &communicator_;
+    int rank_;
+    int size_;
+    Real halo_width_;
+    Mesh halo_mesh_; /**< the mesh with the cutoff radius as grid spacing for selecting halo particles */
+    StdVec<size_t> splitters_; /**< the first Morton key owned by the ranks after the first one */
+    ParticleVariables variables_to_exchange_;
+    StdVec<IndexVector> halo_sources_; /**< the particles sent to each rank as halo particles */
+    StdVec<size_t> halo_offsets_;      /**< the ghost index offsets of the halo particles from each rank */
+    size_t first_halo_index_;
+    size_t total_halo_particles_;
+
+    /** the sorted and unique indices of the halo mesh cells occupied by the real particles */
+    IndexVector occupiedHaloCells(IndexVector &particle_cells);
+    void packHaloParticles(StdVec<ByteBuffer> &send_buffers);
+    void unpackHaloParticles(const StdVec<ByteBuffer> &receive_buffers);
+};
+
+/**
+ * @class DistributedReduceDynamics
+ * @brief The reduce dynamics whose result is reduced from those of all ranks,
+ * 		  such as the time step sizes, before the output of the result.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class DistributedReduceDynamics : public ReduceDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+    using ReturnType = typename LocalDynamicsType::ReduceReturnType;
+
+  public:
+    template <class DynamicsIdentifier, typename... Args>
+    DistributedReduceDynamics(BaseCommunicator &communicator, DynamicsIdentifier &identifier, Args &&...args)
+        : ReduceDynamics<LocalDynamicsType, ExecutionPolicy>(identifier, std::forward<Args>(args)...),
+          communicator_(communicator){};
+    virtual ~DistributedReduceDynamics(){};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        this->setupDynamics(dt);
+        ReturnType temp = particle_reduce(ExecutionPolicy(),
+                                          this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
+                                          [&](size_t i) -> ReturnType
+                                          { return this->reduce(i, dt); });
+        return this->outputResult(communicator_.allReduce(temp, this->getOperation()));
+    };
+
+  protected:
+    BaseCommunicator &communicator_;
+};
+} // namespace SPH
+#endif // DOMAIN_DECOMPOSITION_H
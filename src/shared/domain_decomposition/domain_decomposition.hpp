@@ -0,0 +1,24 @@
+/**
+ * @file 	domain_decomposition.hpp
+ * @brief 	Here gives the template functions of the domain decomposition.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DOMAIN_DECOMPOSITION_HPP
+#define DOMAIN_DECOMPOSITION_HPP
+
+#include "domain_decomposition.h"
+
+#include "base_particles.hpp"
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename DataType>
+void DomainDecomposition::addVariableToExchange(const std::string &variable_name)
+{
+    particles_.addVariableToList<DataType>(variables_to_exchange_, variable_name);
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // DOMAIN_DECOMPOSITION_HPP
@@ -12,10 +12,18 @@ namespace SPH
 {
 //=============================================================================================//
 IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
+    : IOEnvironment(sph_system, ".", delete_output) {}
+//=============================================================================================//
+IOEnvironment::IOEnvironment(SPHSystem &sph_system, const std::string &root_folder, bool delete_output)
     : sph_system_(sph_system),
-      input_folder_("./input"), output_folder_("./output"),
-      restart_folder_("./restart"), reload_folder_("./reload")
+      input_folder_(root_folder + "/input"), output_folder_(root_folder + "/output"),
+      restart_folder_(root_folder + "/restart"), reload_folder_(root_folder + "/reload")
 {
+    if (!fs::exists(root_folder))
+    {
+        fs::create_directories(root_folder);
+    }
+
     if (!fs::exists(input_folder_))
     {
         fs::create_directory(input_folder_);
@@ -60,6 +60,8 @@ class IOEnvironment
     std::string reload_folder_;
 
     explicit IOEnvironment(SPHSystem &sph_system, bool delete_output = true);
+    /** the input, output, restart and reload folders are in the given root folder */
+    IOEnvironment(SPHSystem &sph_system, const std::string &root_folder, bool delete_output);
     virtual ~IOEnvironment(){};
     ParameterizationIO &defineParameterizationIO();
 };
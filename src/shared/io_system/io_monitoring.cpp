@@ -0,0 +1,221 @@
+/**
+ * @file 	io_monitoring.cpp
+ * @author	Xiangyu Hu
+ */
+
+#include "io_monitoring.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+
+namespace SPH
+{
+//=============================================================================================//
+MonitoringRingBuffer::MonitoringRingBuffer(size_t capacity)
+    : head_(0), tail_(0), dropped_records_(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    records_.resize(size);
+    mask_ = size - 1;
+}
+//=============================================================================================//
+bool MonitoringRingBuffer::push(const MonitoringRecord &record)
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == records_.size())
+    {
+        dropped_records_++;
+        return false;
+    }
+    records_[head & mask_] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+//=============================================================================================//
+bool MonitoringRingBuffer::pop(MonitoringRecord &record)
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+        return false;
+    record = records_[tail & mask_];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+//=============================================================================================//
+MonitoringChannel::MonitoringChannel(IOEnvironment &io_environment, const std::string &channel_name,
+                                     size_t buffer_capacity)
+    : ring_buffer_(buffer_capacity),
+      filefullpath_output_(io_environment.output_folder_ + "/" + channel_name + ".csv"),
+      screen_output_(false), is_sampling_(false) {}
+//=============================================================================================//
+MonitoringChannel::~MonitoringChannel()
+{
+    if (writing_thread_.joinable())
+    {
+        is_sampling_.store(false, std::memory_order_release);
+        writing_thread_.join();
+        if (ring_buffer_.DroppedRecords() != 0)
+            std::cout << "\n Warning: " << ring_buffer_.DroppedRecords()
+                      << " monitoring records are dropped as the buffer is full." << std::endl;
+    }
+}
+//=============================================================================================//
+void MonitoringChannel::checkRegistration()
+{
+    if (writing_thread_.joinable())
+    {
+        std::cout << "\n Error: the monitoring channel is not configurable after the sampling has started!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=============================================================================================//
+size_t MonitoringChannel::registerPublishedQuantity(const std::string &quantity_name)
+{
+    checkRegistration();
+    monitored_quantities_.push_back(monitored_quantities_keeper_.createPtr<PublishedQuantity>(quantity_name));
+    return monitored_quantities_.size() - 1;
+}
+//=============================================================================================//
+void MonitoringChannel::addScreenOutput()
+{
+    checkRegistration();
+    screen_output_ = true;
+}
+//=============================================================================================//
+void MonitoringChannel::addLocalSocket(const std::string &socket_path)
+{
+    checkRegistration();
+    socket_path_ = socket_path;
+}
+//=============================================================================================//
+void MonitoringChannel::startWriting()
+{
+    if (!writing_thread_.joinable())
+    {
+        first_sampling_time_ = TickCount::now();
+        is_sampling_.store(true, std::memory_order_release);
+        writing_thread_ = std::thread(&MonitoringChannel::writeRecords, this);
+    }
+}
+//=============================================================================================//
+void MonitoringChannel::sample(size_t iteration_step)
+{
+    startWriting();
+    TickCount sampling_start = TickCount::now();
+
+    MonitoringRecord record;
+    record.iteration_step_ = iteration_step;
+    record.physical_time_ = GlobalStaticVariables::physical_time_;
+    for (size_t k = 0; k != monitored_quantities_.size(); ++k)
+    {
+        if (monitored_quantities_[k]->isDue(iteration_step))
+        {
+            record.quantity_index_ = k;
+            monitored_quantities_[k]->evaluate(record);
+            ring_buffer_.push(record);
+        }
+    }
+    sampling_interval_ += TickCount::now() - sampling_start;
+}
+//=============================================================================================//
+Real MonitoringChannel::MonitoringCost()
+{
+    if (!writing_thread_.joinable())
+        return 0.0;
+    Real wall_time = (TickCount::now() - first_sampling_time_).seconds();
+    return wall_time > 0.0 ? sampling_interval_.seconds() / wall_time : 0.0;
+}
+//=============================================================================================//
+void MonitoringChannel::writeRecords()
+{
+#ifdef __linux__
+    /** the writing thread yields to the solver threads */
+    setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), 19);
+#endif
+    std::ofstream out_file(filefullpath_output_.c_str(), std::ios::out | std::ios::trunc);
+    out_file << "iteration_step,run_time,quantity,components\n";
+
+    int socket_descriptor = -1;
+#ifndef _WIN32
+    if (!socket_path_.empty())
+    {
+        socket_descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path_.c_str(), sizeof(address.sun_path) - 1);
+        if (socket_descriptor < 0 ||
+            connect(socket_descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            std::cout << "\n Warning: the monitoring socket " << socket_path_ << " is not available." << std::endl;
+            if (socket_descriptor >= 0)
+                close(socket_descriptor);
+            socket_descriptor = -1;
+        }
+    }
+#endif
+
+    MonitoringRecord record;
+    std::ostringstream line;
+    line.precision(9);
+    while (true)
+    {
+        /** the records pushed before the sampling stops are all written */
+        bool is_last_round = !is_sampling_.load(std::memory_order_acquire);
+        bool has_written = false;
+        while (ring_buffer_.pop(record))
+        {
+            line.str("");
+            line << record.iteration_step_ << "," << record.physical_time_ << ","
+                 << monitored_quantities_[record.quantity_index_]->QuantityName();
+            for (size_t k = 0; k != record.number_of_components_; ++k)
+                line << "," << record.components_[k];
+            line << "\n";
+
+            const std::string &text = line.str();
+            out_file << text;
+            if (screen_output_)
+                std::cout << text;
+#ifndef _WIN32
+            if (socket_descriptor >= 0 &&
+                send(socket_descriptor, text.data(), text.size(), MSG_NOSIGNAL) < 0)
+            {
+                close(socket_descriptor);
+                socket_descriptor = -1;
+            }
+#endif
+            has_written = true;
+        }
+
+        if (is_last_round)
+            break;
+        if (has_written)
+            out_file.flush();
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+#ifndef _WIN32
+    if (socket_descriptor >= 0)
+        close(socket_descriptor);
+#endif
+    out_file.close();
+}
+//=============================================================================================//
+} // namespace SPH
@@ -0,0 +1,226 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_monitoring.h
+ * @brief 	Non-blocking monitoring of reduced quantities during the simulation.
+ * @details The reductions, such as the total mechanical energy or the maximum speed,
+ * 			are registered to a monitoring channel with their sampling periods.
+ * 			The solver only executes the reductions due at the present step, on its own threads,
+ * 			and publishes the results to a lock-free ring buffer,
+ * 			while a separate thread formats and writes them to a CSV file,
+ * 			and optionally to the screen or to a local socket.
+ * 			The solver never waits for the output, and the records are dropped when the buffer is full.
+ * 			The quantities already computed by the solver, e.g. the time step size, are published directly
+ * 			without another reduction.
+ * @author	Xiangyu Hu
+ */
+
+#pragma once
+
+#include "io_base.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+namespace SPH
+{
+/**
+ * @struct MonitoringRecord
+ * @brief A sampled result of a monitored quantity, which is trivially copyable.
+ */
+struct MonitoringRecord
+{
+    size_t iteration_step_;
+    Real physical_time_;
+    size_t quantity_index_;
+    size_t number_of_components_;
+    std::array<Real, 3> components_;
+};
+
+/**
+ * @class MonitoringRingBuffer
+ * @brief Lock-free ring buffer with a single producer, i.e. the solver,
+ * 		  and a single consumer, i.e. the writing thread.
+ * 		  The capacity is rounded up to a power of two.
+ */
+class MonitoringRingBuffer
+{
+  public:
+    explicit MonitoringRingBuffer(size_t capacity);
+    virtual ~MonitoringRingBuffer(){};
+
+    /** return false and count the dropped record if the buffer is full */
+    bool push(const MonitoringRecord &record);
+    /** return false if the buffer is empty */
+    bool pop(MonitoringRecord &record);
+    size_t DroppedRecords() { return dropped_records_; };
+
+  protected:
+    StdVec<MonitoringRecord> records_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_; /**< the number of records pushed */
+    alignas(64) std::atomic<size_t> tail_; /**< the number of records popped */
+    size_t dropped_records_;
+};
+
+/**
+ * @class BaseMonitoredQuantity
+ * @brief The quantity sampled with a given period.
+ */
+class BaseMonitoredQuantity
+{
+  public:
+    BaseMonitoredQuantity(const std::string &quantity_name, size_t sampling_period)
+        : quantity_name_(quantity_name), sampling_period_(SMAX(sampling_period, size_t(1))){};
+    virtual ~BaseMonitoredQuantity(){};
+
+    std::string QuantityName() { return quantity_name_; };
+    virtual bool isDue(size_t iteration_step) { return iteration_step % sampling_period_ == 0; };
+    virtual void evaluate(MonitoringRecord &record) = 0;
+
+    static void setComponents(MonitoringRecord &record, const Real &quantity)
+    {
+        record.number_of_components_ = 1;
+        record.components_[0] = quantity;
+    };
+    static void setComponents(MonitoringRecord &record, const Vecd &quantity)
+    {
+        record.number_of_components_ = Dimensions;
+        for (int k = 0; k != Dimensions; ++k)
+            record.components_[k] = quantity[k];
+    };
+
+  protected:
+    std::string quantity_name_;
+    size_t sampling_period_;
+};
+
+/**
+ * @class PublishedQuantity
+ * @brief The quantity computed by the solver itself, such as the time step size given by a reduction
+ * 		  already executed in the time stepping, which is published without another reduction.
+ */
+class PublishedQuantity : public BaseMonitoredQuantity
+{
+  public:
+    explicit PublishedQuantity(const std::string &quantity_name)
+        : BaseMonitoredQuantity(quantity_name, 1){};
+    virtual ~PublishedQuantity(){};
+
+    virtual bool isDue(size_t iteration_step) override { return false; };
+    virtual void evaluate(MonitoringRecord &record) override{};
+};
+
+/**
+ * @class MonitoredReduction
+ * @brief The reduce dynamics sampled with a given period.
+ */
+template <class ReduceMethodType>
+class MonitoredReduction : public BaseMonitoredQuantity
+{
+  public:
+    template <typename... ConstructorArgs>
+    MonitoredReduction(size_t sampling_period, ConstructorArgs &&...args)
+        : BaseMonitoredQuantity("", sampling_period),
+          reduce_method_(std::forward<ConstructorArgs>(args)...)
+    {
+        quantity_name_ = reduce_method_.DynamicsIdentifierName() + "_" + reduce_method_.QuantityName();
+    };
+    virtual ~MonitoredReduction(){};
+
+    virtual void evaluate(MonitoringRecord &record) override
+    {
+        setComponents(record, reduce_method_.exec());
+    };
+
+  protected:
+    ReduceMethodType reduce_method_;
+};
+
+/**
+ * @class MonitoringChannel
+ * @brief Sample the registered quantities and write them on a separate thread.
+ * @details The output is configured and the quantities are registered before the first sampling or publishing,
+ * 			which starts the writing thread, as they are read by the writing thread afterwards.
+ * 			The registered reductions are executed on the solver threads at their sampling periods,
+ * 			while the registered published quantities are given by the solver when available.
+ * 			Sampling and publishing are called from the same thread, as the ring buffer has a single producer.
+ * 			Each line of the output is given as iteration_step,run_time,quantity,components.
+ * 			The local socket is a Unix domain socket listened by the monitoring program.
+ */
+class MonitoringChannel
+{
+  public:
+    MonitoringChannel(IOEnvironment &io_environment, const std::string &channel_name,
+                      size_t buffer_capacity = 4096);
+    virtual ~MonitoringChannel();
+
+    template <class ReduceMethodType, typename... ConstructorArgs>
+    void registerReduction(size_t sampling_period, ConstructorArgs &&...args)
+    {
+        checkRegistration();
+        monitored_quantities_.push_back(
+            monitored_quantities_keeper_.createPtr<MonitoredReduction<ReduceMethodType>>(
+                sampling_period, std::forward<ConstructorArgs>(args)...));
+    };
+    /** register a quantity computed by the solver, which is published by the returned index */
+    size_t registerPublishedQuantity(const std::string &quantity_name);
+    void addScreenOutput();
+    void addLocalSocket(const std::string &socket_path);
+    /** execute the quantities due at the iteration step and publish the results */
+    void sample(size_t iteration_step);
+    /** publish the value of a registered published quantity */
+    template <typename DataType>
+    void publish(size_t quantity_index, size_t iteration_step, const DataType &quantity)
+    {
+        startWriting();
+        MonitoringRecord record;
+        record.iteration_step_ = iteration_step;
+        record.physical_time_ = GlobalStaticVariables::physical_time_;
+        record.quantity_index_ = quantity_index;
+        BaseMonitoredQuantity::setComponents(record, quantity);
+        ring_buffer_.push(record);
+    };
+    /** the ratio of the time spent in sampling to the wall time since the first sampling */
+    Real MonitoringCost();
+    size_t DroppedRecords() { return ring_buffer_.DroppedRecords(); };
+
+  protected:
+    UniquePtrsKeeper<BaseMonitoredQuantity> monitored_quantities_keeper_;
+    StdVec<BaseMonitoredQuantity *> monitored_quantities_;
+    MonitoringRingBuffer ring_buffer_;
+    std::string filefullpath_output_;
+    bool screen_output_;
+    std::string socket_path_;
+    std::atomic<bool> is_sampling_;
+    std::thread writing_thread_;
+    TickCount first_sampling_time_;
+    TimeInterval sampling_interval_;
+
+    /** the registration and the output configuration are refused once the writing thread is started */
+    void checkRegistration();
+    void startWriting();
+    void writeRecords();
+};
+} // namespace SPH
@@ -31,12 +31,17 @@
 #include "io_base.h"
 
 #include "io_plt.h"
+#include "binary_observation_store.h"
 
 namespace SPH
 {
 /**
  * @class ObservedQuantityRecording
  * @brief write files for observed quantity
+ * @details If update_configuration is set, the contact configuration of the observer is built lazily
+ * just before recording, so that it need not be updated in every iteration.
+ * This is not for observers following material points, such as those in total Lagrangian solid bodies,
+ * whose configurations are built only once in the reference configuration.
  */
 template <typename VariableType>
 class ObservedQuantityRecording : public BodyStatesRecording,
@@ -44,6 +49,8 @@ class ObservedQuantityRecording : public BodyStatesRecording,
 {
   protected:
     SPHBody &observer_;
+    BaseContactRelation &contact_relation_;
+    bool update_configuration_;
     PltEngine plt_engine_;
     BaseParticles &base_particles_;
     std::string dynamics_identifier_name_;
@@ -55,10 +62,11 @@ class ObservedQuantityRecording : public BodyStatesRecording,
 
   public:
     ObservedQuantityRecording(const std::string &quantity_name, IOEnvironment &io_environment,
-                              BaseContactRelation &contact_relation)
+                              BaseContactRelation &contact_relation, bool update_configuration = false)
         : BodyStatesRecording(io_environment, contact_relation.getSPHBody()),
           ObservingAQuantity<VariableType>(contact_relation, quantity_name),
-          observer_(contact_relation.getSPHBody()), plt_engine_(),
+          observer_(contact_relation.getSPHBody()), contact_relation_(contact_relation),
+          update_configuration_(update_configuration), plt_engine_(),
           base_particles_(observer_.getBaseParticles()),
           dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
           quantity_name_(quantity_name)
@@ -80,6 +88,8 @@ class ObservedQuantityRecording : public BodyStatesRecording,
 
     virtual void writeWithFileName(const std::string &sequence) override
     {
+        if (update_configuration_)
+            contact_relation_.updateConfiguration();
         this->exec();
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << GlobalStaticVariables::physical_time_ << "   ";
@@ -97,6 +107,108 @@ class ObservedQuantityRecording : public BodyStatesRecording,
     }
 };
 
+/** file formats for streaming observed quantities */
+enum class ObservationFormat
+{
+    Binary,
+    CSV
+};
+
+/**
+ * @class ObservedQuantityStreaming
+ * @brief Stream the time series of an observed quantity for a large number of probes.
+ * @details The observer particles are the probes. As for ObservedQuantityRecording,
+ * if update_configuration is set, their contact configuration is built lazily just before recording,
+ * in which all probes are searched in one sweep over the cell linked list of each contact body.
+ * The file is kept open during the simulation. The binary format is that of the binary observation store,
+ * i.e. the header gives the numbers of probes and components for each probe,
+ * and each record gives the time and values in Real.
+ */
+template <typename VariableType>
+class ObservedQuantityStreaming : public BodyStatesRecording,
+                                  public ObservingAQuantity<VariableType>
+{
+  protected:
+    BaseContactRelation &contact_relation_;
+    bool update_configuration_;
+    BaseParticles &base_particles_;
+    const std::string quantity_name_;
+    ObservationFormat format_;
+    std::string filefullpath_output_;
+    UniquePtr<BinaryObservationWriter> binary_writer_;
+    std::ofstream out_file_;
+    StdVec<Real> values_;
+
+  public:
+    VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
+
+  public:
+    ObservedQuantityStreaming(const std::string &quantity_name, IOEnvironment &io_environment,
+                              BaseContactRelation &contact_relation,
+                              ObservationFormat format = ObservationFormat::Binary,
+                              bool update_configuration = false)
+        : BodyStatesRecording(io_environment, contact_relation.getSPHBody()),
+          ObservingAQuantity<VariableType>(contact_relation, quantity_name),
+          contact_relation_(contact_relation), update_configuration_(update_configuration),
+          base_particles_(contact_relation.getSPHBody().getBaseParticles()),
+          quantity_name_(quantity_name), format_(format)
+    {
+        std::string file_name = contact_relation.getSPHBody().getName() + "_" + quantity_name;
+        size_t number_of_probes = base_particles_.total_real_particles_;
+        size_t number_of_components = numberOfComponents(ZeroData<VariableType>::value);
+        values_.reserve(number_of_probes * number_of_components);
+
+        if (format_ == ObservationFormat::Binary)
+        {
+            filefullpath_output_ = io_environment_.output_folder_ + "/" + file_name + ".bin";
+            binary_writer_ = makeUnique<BinaryObservationWriter>(filefullpath_output_, number_of_probes, number_of_components);
+        }
+        else
+        {
+            filefullpath_output_ = io_environment_.output_folder_ + "/" + file_name + ".csv";
+            out_file_.open(filefullpath_output_.c_str(), std::ios::out | std::ios::trunc);
+            out_file_ << "run_time";
+            for (size_t i = 0; i != number_of_probes; ++i)
+                for (size_t k = 0; k != number_of_components; ++k)
+                {
+                    out_file_ << "," << quantity_name << "[" << i << "]";
+                    if (number_of_components != 1)
+                        out_file_ << "[" << k << "]";
+                }
+            out_file_ << "\n";
+        }
+    };
+    virtual ~ObservedQuantityStreaming() { out_file_.close(); };
+
+    virtual void writeWithFileName(const std::string &sequence) override
+    {
+        if (update_configuration_)
+            contact_relation_.updateConfiguration();
+        this->exec();
+
+        values_.clear();
+        for (size_t i = 0; i != base_particles_.total_real_particles_; ++i)
+            appendComponents(values_, (*this->interpolated_quantities_)[i]);
+
+        if (format_ == ObservationFormat::Binary)
+        {
+            binary_writer_->appendRecord(GlobalStaticVariables::physical_time_, values_);
+        }
+        else
+        {
+            out_file_ << GlobalStaticVariables::physical_time_;
+            for (size_t k = 0; k != values_.size(); ++k)
+                out_file_ << "," << values_[k];
+            out_file_ << "\n";
+        }
+    };
+
+    StdLargeVec<VariableType> *getObservedQuantity()
+    {
+        return this->interpolated_quantities_;
+    }
+};
+
 /**
  * @class ReducedQuantityRecording
  * @brief write reduced quantity of a body
@@ -117,12 +229,15 @@ class ReducedQuantityRecording
     using VariableType = typename ReduceMethodType::ReduceReturnType;
     VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
 
+  protected:
+    VariableType reduced_quantity_; /*< the reduced quantity at the last writing. */
+
   public:
     template <typename... ConstructorArgs>
     ReducedQuantityRecording(IOEnvironment &io_environment, ConstructorArgs &&...args)
         : io_environment_(io_environment), plt_engine_(), reduce_method_(std::forward<ConstructorArgs>(args)...),
           dynamics_identifier_name_(reduce_method_.DynamicsIdentifierName()),
-          quantity_name_(reduce_method_.QuantityName())
+          quantity_name_(reduce_method_.QuantityName()), reduced_quantity_(ZeroData<VariableType>::value)
     {
         /** output for .dat file. */
         filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat";
@@ -139,9 +254,15 @@ class ReducedQuantityRecording
     {
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << GlobalStaticVariables::physical_time_ << "   ";
-        plt_engine_.writeAQuantity(out_file, reduce_method_.exec());
+        reduced_quantity_ = reduce_method_.exec();
+        plt_engine_.writeAQuantity(out_file, reduced_quantity_);
         out_file << "\n";
         out_file.close();
     };
+
+    VariableType getReducedQuantity()
+    {
+        return reduced_quantity_;
+    }
 };
 } // namespace SPH
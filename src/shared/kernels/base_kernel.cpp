@@ -6,15 +6,7 @@ namespace SPH
 Kernel::Kernel(Real h, Real kernel_size, Real truncation, const std::string &name)
     : kernel_name_(name), h_(h), inv_h_(1.0 / h), kernel_size_(kernel_size),
       truncation_(truncation), rc_ref_(truncation * h), rc_ref_sqr_(rc_ref_ * rc_ref_),
-      h_factor_W_1D_(std::bind(&Kernel::factorW1D, this, _1)),
-      h_factor_W_2D_(std::bind(&Kernel::factorW2D, this, _1)),
-      h_factor_W_3D_(std::bind(&Kernel::factorW3D, this, _1)),
-      h_factor_dW_1D_(std::bind(&Kernel::factordW1D, this, _1)),
-      h_factor_dW_2D_(std::bind(&Kernel::factordW2D, this, _1)),
-      h_factor_dW_3D_(std::bind(&Kernel::factordW3D, this, _1)),
-      h_factor_d2W_1D_(std::bind(&Kernel::factord2W1D, this, _1)),
-      h_factor_d2W_2D_(std::bind(&Kernel::factord2W2D, this, _1)),
-      h_factor_d2W_3D_(std::bind(&Kernel::factord2W3D, this, _1)){};
+      h_power_1D_(1), h_power_2D_(2), h_power_3D_(3){};
 //=================================================================================================//
 void Kernel::setDerivativeParameters()
 {
@@ -95,73 +87,127 @@ Real Kernel::d2W(const Real &r_ij, const Vec3d &displacement) const
     return factor_d2W_3D_ * d2W_3D(q);
 }
 //=================================================================================================//
+void Kernel::WdW(const Real &r_ij, const Real &displacement, Real &W_ij, Real &dW_ij) const
+{
+    Real q = r_ij * inv_h_;
+    WdW_1D(q, W_ij, dW_ij);
+    W_ij *= factor_W_1D_;
+    dW_ij *= factor_dW_1D_;
+}
+//=================================================================================================//
+void Kernel::WdW(const Real &r_ij, const Vec2d &displacement, Real &W_ij, Real &dW_ij) const
+{
+    Real q = r_ij * inv_h_;
+    WdW_2D(q, W_ij, dW_ij);
+    W_ij *= factor_W_2D_;
+    dW_ij *= factor_dW_2D_;
+}
+//=================================================================================================//
+void Kernel::WdW(const Real &r_ij, const Vec3d &displacement, Real &W_ij, Real &dW_ij) const
+{
+    Real q = r_ij * inv_h_;
+    WdW_3D(q, W_ij, dW_ij);
+    W_ij *= factor_W_3D_;
+    dW_ij *= factor_dW_3D_;
+}
+//=================================================================================================//
+void Kernel::WdW_1D(const Real q, Real &w, Real &dw) const
+{
+    w = W_1D(q);
+    dw = dW_1D(q);
+}
+//=================================================================================================//
+void Kernel::WdW_2D(const Real q, Real &w, Real &dw) const
+{
+    w = W_2D(q);
+    dw = dW_2D(q);
+}
+//=================================================================================================//
+void Kernel::WdW_3D(const Real q, Real &w, Real &dw) const
+{
+    w = W_3D(q);
+    dw = dW_3D(q);
+}
+//=================================================================================================//
+void Kernel::WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec2d &displacement) const
+{
+    for (size_t n = 0; n != block_size; ++n)
+        WdW(r_ij[n], displacement, W_ij[n], dW_ij[n]);
+}
+//=================================================================================================//
+void Kernel::WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec3d &displacement) const
+{
+    for (size_t n = 0; n != block_size; ++n)
+        WdW(r_ij[n], displacement, W_ij[n], dW_ij[n]);
+}
+//=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_1D_ * W_1D(q) * h_factor_W_1D_(h_ratio);
+    return factor_W_1D_ * W_1D(q) * hFactor(h_ratio, h_power_1D_);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_2D_ * W_2D(q) * h_factor_W_2D_(h_ratio);
+    return factor_W_2D_ * W_2D(q) * hFactor(h_ratio, h_power_2D_);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_3D_ * W_3D(q) * h_factor_W_3D_(h_ratio);
+    return factor_W_3D_ * W_3D(q) * hFactor(h_ratio, h_power_3D_);
 }
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Real &point_i) const
 {
-    return factor_W_1D_ * h_factor_W_1D_(h_ratio);
+    return factor_W_1D_ * hFactor(h_ratio, h_power_1D_);
 };
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Vec2d &point_i) const
 {
-    return factor_W_2D_ * h_factor_W_2D_(h_ratio);
+    return factor_W_2D_ * hFactor(h_ratio, h_power_2D_);
 };
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Vec3d &point_i) const
 {
-    return factor_W_3D_ * h_factor_W_3D_(h_ratio);
+    return factor_W_3D_ * hFactor(h_ratio, h_power_3D_);
 };
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_1D_ * dW_1D(q) * h_factor_dW_1D_(h_ratio);
+    return factor_dW_1D_ * dW_1D(q) * hFactor(h_ratio, h_power_1D_ + 1);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_2D_ * dW_2D(q) * h_factor_dW_2D_(h_ratio);
+    return factor_dW_2D_ * dW_2D(q) * hFactor(h_ratio, h_power_2D_ + 1);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_3D_ * dW_3D(q) * h_factor_dW_1D_(h_ratio);
+    return factor_dW_3D_ * dW_3D(q) * hFactor(h_ratio, h_power_1D_ + 1);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_1D_ * d2W_1D(q) * h_factor_d2W_1D_(h_ratio);
+    return factor_d2W_1D_ * d2W_1D(q) * hFactor(h_ratio, h_power_1D_ + 2);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_2D_ * d2W_2D(q) * h_factor_d2W_2D_(h_ratio);
+    return factor_d2W_2D_ * d2W_2D(q) * hFactor(h_ratio, h_power_2D_ + 2);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_d2W_3D_ * d2W_3D(q) * h_factor_d2W_3D_(h_ratio);
+    return factor_d2W_3D_ * d2W_3D(q) * hFactor(h_ratio, h_power_3D_ + 2);
 }
 //=================================================================================================//
 void Kernel::reduceOnce()
@@ -171,12 +217,8 @@ void Kernel::reduceOnce()
     factor_W_1D_ = 0.0;
     setDerivativeParameters();
 
-    h_factor_W_3D_ = std::bind(&Kernel::factorW2D, this, _1);
-    h_factor_W_2D_ = std::bind(&Kernel::factorW1D, this, _1);
-    h_factor_dW_3D_ = std::bind(&Kernel::factordW2D, this, _1);
-    h_factor_dW_2D_ = std::bind(&Kernel::factordW1D, this, _1);
-    h_factor_d2W_3D_ = std::bind(&Kernel::factord2W2D, this, _1);
-    h_factor_d2W_2D_ = std::bind(&Kernel::factord2W1D, this, _1);
+    h_power_3D_ = 2;
+    h_power_2D_ = 1;
 }
 //=================================================================================================//
 void Kernel::reduceTwice()
@@ -186,9 +228,7 @@ void Kernel::reduceTwice()
     factor_W_1D_ = 0.0;
     setDerivativeParameters();
 
-    h_factor_W_3D_ = std::bind(&Kernel::factorW1D, this, _1);
-    h_factor_dW_3D_ = std::bind(&Kernel::factordW1D, this, _1);
-    h_factor_d2W_3D_ = std::bind(&Kernel::factord2W1D, this, _1);
+    h_power_3D_ = 1;
 }
 //=================================================================================================//
 } // namespace SPH
@@ -136,27 +136,64 @@ class Kernel
     virtual Real d2W_2D(const Real q) const = 0;
     virtual Real d2W_3D(const Real q) const = 0;
 
+    /** Calculates the kernel value and derivation in one call **/
+    void WdW(const Real &r_ij, const Real &displacement, Real &W_ij, Real &dW_ij) const;
+    void WdW(const Real &r_ij, const Vec2d &displacement, Real &W_ij, Real &dW_ij) const;
+    void WdW(const Real &r_ij, const Vec3d &displacement, Real &W_ij, Real &dW_ij) const;
+
+    /** this value could be use to calculate the value of W and dW together,
+     * they are realized by the kernel implementations sharing computation between both
+     */
+    virtual void WdW_1D(const Real q, Real &w, Real &dw) const;
+    virtual void WdW_2D(const Real q, Real &w, Real &dw) const;
+    virtual void WdW_3D(const Real q, Real &w, Real &dw) const;
+
+    /** Calculates the kernel values and derivations for a block of distances, e.g. of a neighborhood.
+     * The default evaluates distance by distance, and is overridden by kernels with vectorizable block evaluation. */
+    virtual void WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec2d &displacement) const;
+    virtual void WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec3d &displacement) const;
+
+    /** Kernel value and derivative with the concrete kernel type given at compile time.
+     * The qualified calls bypass the virtual functions,
+     * so that they are inlined when the kernel functions are defined in the header. */
+    template <class KernelType>
+    Real typedW(const Real &r_ij, const Vec2d &displacement) const
+    {
+        return factor_W_2D_ * static_cast<const KernelType *>(this)->KernelType::W_2D(r_ij * inv_h_);
+    };
+    template <class KernelType>
+    Real typedW(const Real &r_ij, const Vec3d &displacement) const
+    {
+        return factor_W_3D_ * static_cast<const KernelType *>(this)->KernelType::W_3D(r_ij * inv_h_);
+    };
+    template <class KernelType>
+    Real typeddW(const Real &r_ij, const Vec2d &displacement) const
+    {
+        return factor_dW_2D_ * static_cast<const KernelType *>(this)->KernelType::dW_2D(r_ij * inv_h_);
+    };
+    template <class KernelType>
+    Real typeddW(const Real &r_ij, const Vec3d &displacement) const
+    {
+        return factor_dW_3D_ * static_cast<const KernelType *>(this)->KernelType::dW_3D(r_ij * inv_h_);
+    };
+
     //----------------------------------------------------------------------
     //		Below are for variable smoothing length.
     //		Note that we input the ratio between the reference smoothing length
     //		to the variable smoothing length.
     //----------------------------------------------------------------------
   protected:
-    /** Functor for variable smoothing length. */
-    typedef std::function<Real(const Real &)> FactorFunctor;
-    FactorFunctor h_factor_W_1D_, h_factor_W_2D_, h_factor_W_3D_;
-    FactorFunctor h_factor_dW_1D_, h_factor_dW_2D_, h_factor_dW_3D_;
-    FactorFunctor h_factor_d2W_1D_, h_factor_d2W_2D_, h_factor_d2W_3D_;
-
-    Real factorW1D(const Real &h_ratio) const { return h_ratio; };
-    Real factorW2D(const Real &h_ratio) const { return h_ratio * h_ratio; };
-    Real factorW3D(const Real &h_ratio) const { return h_ratio * h_ratio * h_ratio; };
-    Real factordW1D(const Real &h_ratio) const { return factorW1D(h_ratio) * h_ratio; };
-    Real factordW2D(const Real &h_ratio) const { return factorW2D(h_ratio) * h_ratio; };
-    Real factordW3D(const Real &h_ratio) const { return factorW3D(h_ratio) * h_ratio; };
-    Real factord2W1D(const Real &h_ratio) const { return factordW1D(h_ratio) * h_ratio; };
-    Real factord2W2D(const Real &h_ratio) const { return factordW2D(h_ratio) * h_ratio; };
-    Real factord2W3D(const Real &h_ratio) const { return factordW3D(h_ratio) * h_ratio; };
+    /** Powers of the smoothing length ratio in the normalization factors,
+     * which are changed for reduced kernels. */
+    int h_power_1D_, h_power_2D_, h_power_3D_;
+
+    Real hFactor(const Real &h_ratio, int power) const
+    {
+        Real factor = 1.0;
+        for (int k = 0; k != power; ++k)
+            factor *= h_ratio;
+        return factor;
+    };
 
   public:
     Real CutOffRadius(Real h_ratio) const { return rc_ref_ / h_ratio; };
@@ -31,13 +31,15 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
  * @class Kernel Cubic B_Spline
  * @brief Kernel Cubic B_Spline
  */
-class KernelCubicBSpline : public Kernel
+class KernelCubicBSpline final : public Kernel
 {
   public:
     explicit KernelCubicBSpline(Real h);
@@ -46,17 +48,91 @@ class KernelCubicBSpline : public Kernel
      * Calculates the kernel value for
      * the given distance of two particles
      */
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
+    virtual Real W_1D(const Real q) const override
+    {
+        if (q < 1.0)
+        {
+            return (1.0 - 3.0 * pow(q, 2) * (1.0 - q / 2.0) / 2.0);
+        }
+        else
+        {
+            return pow(2.0 - q, 3) / 4.0;
+        }
+    };
+    virtual Real W_2D(const Real q) const override
+    {
+        return W_1D(q);
+    };
+    virtual Real W_3D(const Real q) const override
+    {
+        return W_2D(q);
+    };
+
+    virtual Real dW_1D(const Real q) const override
+    {
+        if (q < 1.0)
+        {
+            return (9.0 * pow(q, 2) / 4.0 - 3.0 * q);
+        }
+        else
+        {
+            return (-1.0) * 3.0 * pow(2.0 - q, 2) / 4.0;
+        }
+    };
+    virtual Real dW_2D(const Real q) const override
+    {
+        return dW_1D(q);
+    };
+    virtual Real dW_3D(const Real q) const override
+    {
+        return dW_2D(q);
+    };
 
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
+    virtual Real d2W_1D(const Real q) const override
+    {
+        if (q < 1.0)
+        {
+            return 9.0 * q / 2.0 - 3.0;
+        }
+        else
+        {
+            return 3.0 * (2.0 - q) / 2.0;
+        }
+    };
+    virtual Real d2W_2D(const Real q) const override
+    {
+        return d2W_1D(q);
+    };
+    virtual Real d2W_3D(const Real q) const override
+    {
+        return d2W_2D(q);
+    };
 
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
+    /** the value and derivative share the powers of q or (2 - q) */
+    virtual void WdW_1D(const Real q, Real &w, Real &dw) const override
+    {
+        if (q < 1.0)
+        {
+            Real q2 = q * q;
+            w = 1.0 - 1.5 * q2 + 0.75 * q2 * q;
+            dw = 2.25 * q2 - 3.0 * q;
+        }
+        else
+        {
+            Real a = 2.0 - q;
+            Real a2 = a * a;
+            w = 0.25 * a2 * a;
+            dw = -0.75 * a2;
+        }
+    };
+    virtual void WdW_2D(const Real q, Real &w, Real &dw) const override
+    {
+        WdW_1D(q, w, dw);
+    };
+    virtual void WdW_3D(const Real q, Real &w, Real &dw) const override
+    {
+        WdW_2D(q, w, dw);
+    };
 };
 } // namespace SPH
 #endif // KERNEL_CUBIC_B_SPLINE_H
\ No newline at end of file
@@ -44,6 +44,43 @@ class KernelTabulated : public Kernel
     StdVec<Real> w_1d, w_2d, w_3d;
     StdVec<Real> dw_1d, dw_2d, dw_3d;
     StdVec<Real> d2w_1d, d2w_2d, d2w_3d;
+    /** Interleaved tables for the kernel value and derivative, used by both the separate and the combined evaluation.
+     * For each interval, the cubic polynomials of the four-point Lagrangian interpolation
+     * of the value and derivative are given by their coefficients in one cache line. */
+    typedef std::array<Real, 8> PolynomialCoefficients;
+    Real inv_dq_;
+    StdLargeVec<PolynomialCoefficients> wdw_1d, wdw_2d, wdw_3d;
+
+    void tabulatePolynomials(const StdVec<Real> &w, const StdVec<Real> &dw, StdLargeVec<PolynomialCoefficients> &wdw);
+    Real InterpolationPolynomial(const StdLargeVec<PolynomialCoefficients> &wdw, size_t first_coefficient, Real q) const
+    {
+        size_t location = size_t(q * inv_dq_);
+        const Real *c = wdw[location].data() + first_coefficient;
+        Real fraction = q - Real(location) * dq_;
+        return ((c[3] * fraction + c[2]) * fraction + c[1]) * fraction + c[0];
+    };
+    void InterpolationPolynomial(const StdLargeVec<PolynomialCoefficients> &wdw, Real q, Real &w, Real &dw) const
+    {
+        size_t location = size_t(q * inv_dq_);
+        const PolynomialCoefficients &c = wdw[location];
+        Real fraction = q - Real(location) * dq_;
+        w = ((c[3] * fraction + c[2]) * fraction + c[1]) * fraction + c[0];
+        dw = ((c[7] * fraction + c[6]) * fraction + c[5]) * fraction + c[4];
+    };
+    void InterpolationPolynomial(const StdLargeVec<PolynomialCoefficients> &wdw, Real factor_W, Real factor_dW,
+                                 size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij) const
+    {
+        /** without branches, so that the loop can be vectorized by the compiler */
+        for (size_t n = 0; n != block_size; ++n)
+        {
+            Real q = r_ij[n] * inv_h_;
+            size_t location = size_t(q * inv_dq_);
+            const Real *c = wdw[location].data();
+            Real fraction = q - Real(location) * dq_;
+            W_ij[n] = factor_W * (((c[3] * fraction + c[2]) * fraction + c[1]) * fraction + c[0]);
+            dW_ij[n] = factor_dW * (((c[7] * fraction + c[6]) * fraction + c[5]) * fraction + c[4]);
+        }
+    };
 
     /** interpolation function, Four-point Lagrangian interpolation. */
     Real InterpolationCubic(const StdVec<Real> &data, Real q) const
@@ -75,6 +112,19 @@ class KernelTabulated : public Kernel
     virtual Real d2W_1D(const Real q) const override;
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
+
+    using Kernel::WdW;
+    virtual void WdW_1D(const Real q, Real &w, Real &dw) const override { InterpolationPolynomial(wdw_1d, q, w, dw); };
+    virtual void WdW_2D(const Real q, Real &w, Real &dw) const override { InterpolationPolynomial(wdw_2d, q, w, dw); };
+    virtual void WdW_3D(const Real q, Real &w, Real &dw) const override { InterpolationPolynomial(wdw_3d, q, w, dw); };
+    virtual void WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec2d &displacement) const override
+    {
+        InterpolationPolynomial(wdw_2d, factor_W_2D_, factor_dW_2D_, block_size, r_ij, W_ij, dW_ij);
+    };
+    virtual void WdW(size_t block_size, const Real *r_ij, Real *W_ij, Real *dW_ij, const Vec3d &displacement) const override
+    {
+        InterpolationPolynomial(wdw_3d, factor_W_3D_, factor_dW_3D_, block_size, r_ij, W_ij, dW_ij);
+    };
 };
 //=================================================================================================//
 template <class KernelType>
@@ -112,42 +162,86 @@ KernelTabulated<KernelType>::KernelTabulated(Real h, int kernel_resolution)
     delta_q_1_ = dq_ * (-1.0 * dq_) * (-2.0 * dq_);
     delta_q_2_ = (2.0 * dq_) * dq_ * (-1.0 * dq_);
     delta_q_3_ = (3.0 * dq_) * (2.0 * dq_) * dq_;
+
+    inv_dq_ = 1.0 / dq_;
+    tabulatePolynomials(w_1d, dw_1d, wdw_1d);
+    tabulatePolynomials(w_2d, dw_2d, wdw_2d);
+    tabulatePolynomials(w_3d, dw_3d, wdw_3d);
+}
+//=================================================================================================//
+template <class KernelType>
+void KernelTabulated<KernelType>::tabulatePolynomials(const StdVec<Real> &w, const StdVec<Real> &dw,
+                                                      StdLargeVec<PolynomialCoefficients> &wdw)
+{
+    /** the nodes of the Lagrangian basis polynomials relative to the beginning of the interval */
+    Real nodes[4] = {-dq_, 0.0, dq_, 2.0 * dq_};
+    Real denominators[4] = {delta_q_0_, delta_q_1_, delta_q_2_, delta_q_3_};
+    /** the monomial coefficients of the Lagrangian basis polynomials */
+    Real basis[4][4];
+    for (int k = 0; k != 4; ++k)
+    {
+        Real a[3];
+        int m = 0;
+        for (int l = 0; l != 4; ++l)
+            if (l != k)
+                a[m++] = nodes[l];
+        basis[k][0] = -a[0] * a[1] * a[2] / denominators[k];
+        basis[k][1] = (a[0] * a[1] + a[1] * a[2] + a[2] * a[0]) / denominators[k];
+        basis[k][2] = -(a[0] + a[1] + a[2]) / denominators[k];
+        basis[k][3] = 1.0 / denominators[k];
+    }
+
+    wdw.resize(kernel_resolution_ + 1);
+    for (int location = 0; location != kernel_resolution_ + 1; ++location)
+    {
+        int i = location + 1;
+        for (int p = 0; p != 4; ++p)
+        {
+            wdw[location][p] = 0.0;
+            wdw[location][4 + p] = 0.0;
+            for (int k = 0; k != 4; ++k)
+            {
+                wdw[location][p] += basis[k][p] * w[i - 1 + k];
+                wdw[location][4 + p] += basis[k][p] * dw[i - 1 + k];
+            }
+        }
+    }
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::W_1D(Real q) const
 {
-    return InterpolationCubic(w_1d, q);
+    return InterpolationPolynomial(wdw_1d, 0, q);
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::W_2D(Real q) const
 {
-    return InterpolationCubic(w_2d, q);
+    return InterpolationPolynomial(wdw_2d, 0, q);
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::W_3D(Real q) const
 {
-    return InterpolationCubic(w_3d, q);
+    return InterpolationPolynomial(wdw_3d, 0, q);
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::dW_1D(Real q) const
 {
-    return InterpolationCubic(dw_1d, q);
+    return InterpolationPolynomial(wdw_1d, 4, q);
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::dW_2D(Real q) const
 {
-    return InterpolationCubic(dw_2d, q);
+    return InterpolationPolynomial(wdw_2d, 4, q);
 }
 //=================================================================================================//
 template <class KernelType>
 Real KernelTabulated<KernelType>::dW_3D(Real q) const
 {
-    return InterpolationCubic(dw_3d, q);
+    return InterpolationPolynomial(wdw_3d, 4, q);
 }
 //=================================================================================================//
 template <class KernelType>
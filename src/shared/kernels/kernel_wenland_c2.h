@@ -31,13 +31,15 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
  * @class KernelWendlandC2
  * @brief Kernel WendlandC2
  */
-class KernelWendlandC2 : public Kernel
+class KernelWendlandC2 final : public Kernel
 {
   public:
     explicit KernelWendlandC2(Real h);
@@ -46,17 +48,61 @@ class KernelWendlandC2 : public Kernel
      * Calculates the kernel value for
      * the given distance of two particles
      */
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
+    virtual Real W_1D(const Real q) const override
+    {
+        return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q);
+    };
+    virtual Real W_2D(const Real q) const override
+    {
+        return W_1D(q);
+    };
+    virtual Real W_3D(const Real q) const override
+    {
+        return W_2D(q);
+    };
+
+    virtual Real dW_1D(const Real q) const override
+    {
+        return 0.625 * pow(q - 2.0, 3) * q;
+    };
+    virtual Real dW_2D(const Real q) const override
+    {
+        return dW_1D(q);
+    };
+    virtual Real dW_3D(const Real q) const override
+    {
+        return dW_2D(q);
+    };
 
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
+    virtual Real d2W_1D(const Real q) const override
+    {
+        return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0);
+    };
+    virtual Real d2W_2D(const Real q) const override
+    {
+        return d2W_1D(q);
+    };
+    virtual Real d2W_3D(const Real q) const override
+    {
+        return d2W_2D(q);
+    };
 
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
+    /** the value and derivative share the power of (1 - q / 2) */
+    virtual void WdW_1D(const Real q, Real &w, Real &dw) const override
+    {
+        Real a = 1.0 - 0.5 * q;
+        Real a3 = a * a * a;
+        w = a3 * a * (1.0 + 2.0 * q);
+        dw = -5.0 * a3 * q;
+    };
+    virtual void WdW_2D(const Real q, Real &w, Real &dw) const override
+    {
+        WdW_1D(q, w, dw);
+    };
+    virtual void WdW_3D(const Real q, Real &w, Real &dw) const override
+    {
+        WdW_2D(q, w, dw);
+    };
 };
 } // namespace SPH
 #endif // KERNEL_WENLAND_C2_H
\ No newline at end of file
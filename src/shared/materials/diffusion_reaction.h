@@ -196,6 +196,23 @@ class BaseReactionModel
     virtual ~BaseReactionModel(){};
     SpeciesNames &getSpeciesNames() { return species_names_; };
 
+    /** Species of a block of particles, each pointing to the values of the first particle of the block. */
+    typedef std::array<Real *, NUM_SPECIES> BlockSpecies;
+    /** Production and loss rates of a species for a block of particles.
+     *  Only one virtual call is required for a block. */
+    virtual void getBlockRates(size_t species_index, const BlockSpecies &block_species, size_t block_size,
+                               Real *production_rates, Real *loss_rates)
+    {
+        LocalSpecies local_species;
+        for (size_t i = 0; i != block_size; ++i)
+        {
+            for (size_t k = 0; k != NUM_SPECIES; ++k)
+                local_species[k] = block_species[k][i];
+            production_rates[i] = get_production_rates_[species_index](local_species);
+            loss_rates[i] = get_loss_rates_[species_index](local_species);
+        }
+    };
+
   protected:
     std::string reaction_model_;
     SpeciesNames species_names_;
@@ -22,7 +22,8 @@ void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 //=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                RealBody &real_body, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2)
+    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+      particle_bounds_(tentative_bounds), is_stencil_data_current_(false)
 {
     allocateMeshDataMatrix();
     single_cell_linked_list_level_.push_back(this);
@@ -44,6 +45,14 @@ void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
         },
         ap);
 
+    particle_bounds_ = particle_reduce(
+        execution::ParallelPolicy(), total_real_particles,
+        BoundingBox(MaxRealNumber * Vecd::Ones(), -MaxRealNumber * Vecd::Ones()),
+        [](const BoundingBox &x, const BoundingBox &y)
+        { return getUnionOfBoundingBoxes(x, y); },
+        [&](size_t i)
+        { return BoundingBox(pos_n[i], pos_n[i]); });
+
     UpdateCellListData(base_particles);
 
     if (real_body_.getUseSplitCellLists())
@@ -62,6 +71,47 @@ StdLargeVec<size_t> &CellLinkedList::computingSequence(BaseParticles &base_parti
     return sequence;
 }
 //=================================================================================================//
+void CellLinkedList::addPeriodicImage(BoundingBox &bounding_bounds, int axis)
+{
+    for (const PeriodicImage &periodic_image : periodic_images_)
+        if (periodic_image.axis_ == axis)
+        {
+            std::cout << "\n Error: the periodic image has been added in this axis direction!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+    PeriodicImage periodic_image;
+    periodic_image.axis_ = axis;
+    periodic_image.lower_bound_ = bounding_bounds.first_[axis];
+    periodic_image.upper_bound_ = bounding_bounds.second_[axis];
+    periodic_image.translation_ = bounding_bounds.second_[axis] - bounding_bounds.first_[axis];
+    periodic_images_.push_back(periodic_image);
+}
+//=================================================================================================//
+size_t CellLinkedList::getPeriodicImageShifts(const Vecd &position, Real search_range, PeriodicImageShifts &shifts)
+{
+    shifts[0] = Vecd::Zero();
+    size_t number_of_shifts = 1;
+    for (const PeriodicImage &periodic_image : periodic_images_)
+    {
+        int axis = periodic_image.axis_;
+        Vecd translation = Vecd::Zero();
+        if (position[axis] < periodic_image.lower_bound_ + search_range)
+            translation[axis] = periodic_image.translation_;
+        else if (position[axis] > periodic_image.upper_bound_ - search_range)
+            translation[axis] = -periodic_image.translation_;
+        else
+            continue;
+
+        /** combined with the shifts in other axis directions for the images at corners */
+        for (size_t k = 0; k != number_of_shifts; ++k)
+            shifts[number_of_shifts + k] = shifts[k] + translation;
+        number_of_shifts *= 2;
+    }
+    return number_of_shifts;
+}
+//=================================================================================================//
 MultilevelCellLinkedList::MultilevelCellLinkedList(
     BoundingBox tentative_bounds, Real reference_grid_spacing,
     size_t total_levels, RealBody &real_body, SPHAdaptation &sph_adaptation)
@@ -151,4 +201,12 @@ void MultilevelCellLinkedList::
     }
 }
 //=================================================================================================//
+void MultilevelCellLinkedList::addPeriodicImage(BoundingBox &bounding_bounds, int axis)
+{
+    for (size_t l = 0; l != total_levels_; ++l)
+    {
+        mesh_levels_[l]->addPeriodicImage(bounding_bounds, axis);
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -35,6 +35,8 @@
 #include "base_mesh.h"
 #include "neighborhood.h"
 
+#include <atomic>
+
 namespace SPH
 {
 
@@ -45,6 +47,21 @@ class Kernel;
 class SPHAdaptation;
 class CellLinkedList;
 
+/**
+ * @struct PeriodicImage
+ * @brief The periodic image in an axis direction, which is searched by a virtual cell offset
+ * 		  instead of inserting translated list data entries into the bounding cells.
+ */
+struct PeriodicImage
+{
+    int axis_;
+    Real lower_bound_;
+    Real upper_bound_;
+    Real translation_;
+};
+/** at most one periodic image in each axis direction */
+using PeriodicImageShifts = std::array<Vecd, 8>;
+
 /**
  * @class BaseCellLinkedList
  * @brief The Abstract class for mesh cell linked list derived from BaseMeshField.
@@ -80,6 +97,8 @@ class BaseCellLinkedList : public BaseMeshField
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) = 0;
     /** Tag domain bounding cells in an axis direction, called by domain bounding classes */
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) = 0;
+    /** Register a periodic image in an axis direction, which is found by neighbor search directly */
+    virtual void addPeriodicImage(BoundingBox &bounding_bounds, int axis) = 0;
 };
 
 /**
@@ -96,10 +115,24 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     MeshDataMatrix<ConcurrentIndexVector> cell_index_lists_;
     /** non-concurrent list data rewritten for building neighbor list */
     MeshDataMatrix<ListDataVector> cell_data_lists_;
+    /** periodic images searched with a virtual cell offset */
+    StdVec<PeriodicImage> periodic_images_;
+    /** bounds of the real particles at the last update of the cell lists */
+    BoundingBox particle_bounds_;
+    /** contiguous copy of the list data in the order of the linear cell index, for the stencil search */
+    StdLargeVec<size_t> stencil_cell_offsets_;
+    StdLargeVec<size_t> stencil_index_;
+    std::array<StdLargeVec<Real>, Dimensions> stencil_position_;
+    StdLargeVec<Real> stencil_Vol_;
+    /** whether the stencil cell data are a copy of the present list data,
+     *  reset when the list data are rebuilt or entries are inserted */
+    std::atomic<bool> is_stencil_data_current_;
 
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
     void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
     virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+    /** the shifts of a searching position for the periodic images, the number of shifts is returned */
+    size_t getPeriodicImageShifts(const Vecd &position, Real search_range, PeriodicImageShifts &shifts);
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
@@ -114,13 +147,40 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     virtual StdLargeVec<size_t> &computingSequence(BaseParticles &base_particles) override;
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) override;
+    virtual void addPeriodicImage(BoundingBox &bounding_bounds, int axis) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return single_cell_linked_list_level_; };
+    BoundingBox &ParticleBounds() { return particle_bounds_; };
+    bool hasPeriodicImages() { return !periodic_images_.empty(); };
 
     /** generalized particle search algorithm */
     template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
     void searchNeighborsByParticles(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
                                     GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation);
+    /** copy the list data of all cells into the contiguous stencil cell data */
+    void updateStencilCellData();
+    /** copy the list data only if they are changed since the last copy, i.e. once for each update of the cell lists */
+    void checkStencilCellData()
+    {
+        if (!is_stencil_data_current_.load(std::memory_order_relaxed))
+            updateStencilCellData();
+    };
+    /** inner neighbor search on the contiguous stencil cell data, giving the same neighbors as the particle search */
+    template <class DynamicsRange, class KernelType>
+    void searchInnerNeighborsByStencil(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+                                       int search_depth, const KernelType &kernel);
+    /** inner neighbor search giving only the neighbor indices in compressed rows */
+    template <class DynamicsRange>
+    void searchInnerNeighborIndicesByStencil(DynamicsRange &dynamics_range, int search_depth,
+                                             Real cutoff_radius_sqr, StdLargeVec<size_t> &neighbor_offset,
+                                             StdLargeVec<NeighborIndex> &neighbor_index);
+    /** apply a function on the contiguous ranges of the stencil cell data around a position,
+     *  including the periodic images, in the same order as the cells are visited by the particle search */
+    template <typename FunctionOnRange>
+    void forEachStencilRangeAround(const Vecd &position, int search_depth, const FunctionOnRange &function_on_range);
+    /** apply a function on the list data of each cell around a position, including the periodic images */
+    template <typename FunctionOnCell>
+    void forEachCellAround(const Vecd &position, int search_depth, const FunctionOnCell &function_on_cell);
 };
 
 /**
@@ -149,6 +209,7 @@ class MultilevelCellLinkedList : public MultilevelMesh<BaseCellLinkedList, CellL
     virtual StdLargeVec<size_t> &computingSequence(BaseParticles &base_particles) override;
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, BoundingBox &bounding_bounds, int axis) override{};
+    virtual void addPeriodicImage(BoundingBox &bounding_bounds, int axis) override;
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return getMeshLevels(); };
 };
 } // namespace SPH
@@ -112,7 +112,7 @@ class DiffusionRelaxationInner
 {
   protected:
     KernelGradientType kernel_gradient_;
-    void getDiffusionChangeRate(size_t particle_i, size_t particle_j, Vecd &e_ij, Real surface_area_ij);
+    void getDiffusionChangeRate(size_t particle_i, size_t particle_j, const Vecd &e_ij, Real surface_area_ij);
 
   public:
     typedef BaseInnerRelation BodyRelationType;
@@ -177,7 +177,7 @@ class DiffusionRelaxationDirichlet
   protected:
     StdVec<StdVec<StdLargeVec<Real> *>> contact_gradient_species_;
     void getDiffusionChangeRateDirichlet(
-        size_t particle_i, size_t particle_j, Vecd &e_ij, Real surface_area_ij,
+        size_t particle_i, size_t particle_j, const Vecd &e_ij, Real surface_area_ij,
         const StdVec<StdLargeVec<Real> *> &gradient_species_k);
 
   public:
@@ -292,5 +292,57 @@ class DiffusionRelaxationRK2 : public BaseDynamics<void>
 
     virtual void exec(Real dt = 0.0) override;
 };
+
+/**
+ * @class DiffusionRelaxationImplicit
+ * @brief Backward Euler integration of the inner diffusion of all species.
+ * @details The SPH Laplacian is assembled once into a compressed sparse row (CSR) matrix and
+ * the volume weighted linear system  V_i phi_i + dt sum_j c_ij (phi_i - phi_j) = V_i phi^n_i,
+ * which is symmetric positive definite, is solved for each species by a Jacobi preconditioned
+ * conjugate gradient method with parallel matrix-vector products and reductions.
+ * Therefore, the time step size is not limited by the diffusion stability criterion.
+ * The matrix is assembled on the first execution and re-assembled automatically
+ * once the inner configuration or the number of particles has changed.
+ * Only inner diffusion is considered, i.e. without contact boundary conditions.
+ */
+template <class ParticlesType, class KernelGradientType = KernelGradientInner>
+class DiffusionRelaxationImplicit
+    : public BaseDynamics<void>,
+      public DiffusionReactionInnerData<ParticlesType>
+{
+  protected:
+    typedef typename ParticlesType::DiffusionReactionMaterial Material;
+    Material &material_;
+    BaseInnerRelation &inner_relation_;
+    StdVec<BaseDiffusion *> &all_diffusions_;
+    StdVec<StdLargeVec<Real> *> &diffusion_species_;
+    StdLargeVec<Real> &Vol_;
+    KernelGradientType kernel_gradient_;
+    Real tolerance_;
+    size_t max_iterations_;
+    bool is_matrix_assembled_;
+    size_t assembled_configuration_update_count_; /**< the configuration by which the matrix is assembled */
+    /** CSR matrix, one off-diagonal and diagonal array for each species */
+    StdLargeVec<size_t> row_sizes_;
+    StdLargeVec<size_t> row_offsets_;
+    StdLargeVec<size_t> column_indexes_;
+    StdVec<StdLargeVec<Real>> off_diagonal_;
+    StdVec<StdLargeVec<Real>> diagonal_;
+    /** work vectors of the conjugate gradient method */
+    StdLargeVec<Real> rhs_, residual_, preconditioned_residual_, search_direction_, matrix_product_;
+
+    void assembleMatrix();
+    void multiplyMatrix(size_t species_index, Real dt, const StdLargeVec<Real> &x, StdLargeVec<Real> &y);
+    Real dotProduct(const StdLargeVec<Real> &a, const StdLargeVec<Real> &b);
+    void solveSpecies(size_t species_index, Real dt);
+
+  public:
+    explicit DiffusionRelaxationImplicit(BaseInnerRelation &inner_relation,
+                                         Real tolerance = 1.0e-8, size_t max_iterations = 1000);
+    virtual ~DiffusionRelaxationImplicit(){};
+    StdVec<BaseDiffusion *> &AllDiffusions() { return all_diffusions_; };
+
+    virtual void exec(Real dt = 0.0) override;
+};
 } // namespace SPH
 #endif // DIFFUSION_DYNAMICS_H
\ No newline at end of file
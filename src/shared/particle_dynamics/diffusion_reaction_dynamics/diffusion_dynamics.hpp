@@ -71,7 +71,7 @@ DiffusionRelaxationInner<ParticlesType, KernelGradientType>::
 //=================================================================================================//
 template <class ParticlesType, class KernelGradientType>
 void DiffusionRelaxationInner<ParticlesType, KernelGradientType>::
-    getDiffusionChangeRate(size_t particle_i, size_t particle_j, Vecd &e_ij, Real surface_area_ij)
+    getDiffusionChangeRate(size_t particle_i, size_t particle_j, const Vecd &e_ij, Real surface_area_ij)
 {
     for (size_t m = 0; m < this->all_diffusions_.size(); ++m)
     {
@@ -93,7 +93,7 @@ void DiffusionRelaxationInner<ParticlesType, KernelGradientType>::
         size_t index_j = inner_neighborhood.j_[n];
         Real dW_ijV_j_ = inner_neighborhood.dW_ijV_j_[n];
         Real r_ij_ = inner_neighborhood.r_ij_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
 
         const Vecd &grad_ijV_j = this->kernel_gradient_(index_i, index_j, dW_ijV_j_, e_ij);
         Real area_ij = 2.0 * grad_ijV_j.dot(e_ij) / r_ij_;
@@ -159,7 +159,7 @@ DiffusionRelaxationDirichlet<ParticlesType, ContactParticlesType, KernelGradient
 //=================================================================================================//
 template <class ParticlesType, class ContactParticlesType, class KernelGradientType>
 void DiffusionRelaxationDirichlet<ParticlesType, ContactParticlesType, KernelGradientType>::
-    getDiffusionChangeRateDirichlet(size_t particle_i, size_t particle_j, Vecd &e_ij,
+    getDiffusionChangeRateDirichlet(size_t particle_i, size_t particle_j, const Vecd &e_ij,
                                            Real surface_area_ij, const StdVec<StdLargeVec<Real> *> &gradient_species_k)
 {
     for (size_t m = 0; m < this->all_diffusions_.size(); ++m)
@@ -185,7 +185,7 @@ void DiffusionRelaxationDirichlet<ParticlesType, ContactParticlesType, KernelGra
             size_t index_j = contact_neighborhood.j_[n];
             Real r_ij_ = contact_neighborhood.r_ij_[n];
             Real dW_ijV_j_ = contact_neighborhood.dW_ijV_j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
 
             const Vecd &grad_ijV_j = this->contact_kernel_gradients_[k](index_i, index_j, dW_ijV_j_, e_ij);
             Real area_ij = 2.0 * grad_ijV_j.dot(e_ij) / r_ij_;
@@ -236,7 +236,7 @@ void DiffusionRelaxationNeumann<ParticlesType, ContactParticlesType, KernelGradi
         {
             size_t index_j = contact_neighborhood.j_[n];
             Real dW_ijV_j_ = contact_neighborhood.dW_ijV_j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
 
             const Vecd &grad_ijV_j = this->contact_kernel_gradients_[k](index_i, index_j, dW_ijV_j_, e_ij);
             Vecd n_ij = n_[index_i] - n_k[index_j];
@@ -294,7 +294,7 @@ void DiffusionRelaxationRobin<ParticlesType, ContactParticlesType, KernelGradien
         {
             size_t index_j = contact_neighborhood.j_[n];
             Real dW_ijV_j_ = contact_neighborhood.dW_ijV_j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
 
             const Vecd &grad_ijV_j = this->contact_kernel_gradients_[k](index_i, index_j, dW_ijV_j_, e_ij);
             Vecd n_ij = n_[index_i] - n_k[index_j];
@@ -360,5 +360,171 @@ void DiffusionRelaxationRK2<FirstStageType>::exec(Real dt)
     rk2_2nd_stage_.exec(dt);
 }
 //=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::
+    DiffusionRelaxationImplicit(BaseInnerRelation &inner_relation, Real tolerance, size_t max_iterations)
+    : BaseDynamics<void>(inner_relation.getSPHBody()),
+      DiffusionReactionInnerData<ParticlesType>(inner_relation),
+      material_(this->particles_->diffusion_reaction_material_), inner_relation_(inner_relation),
+      all_diffusions_(material_.AllDiffusions()),
+      diffusion_species_(this->particles_->DiffusionSpecies()),
+      Vol_(this->particles_->Vol_), kernel_gradient_(this->particles_),
+      tolerance_(tolerance), max_iterations_(max_iterations),
+      is_matrix_assembled_(false), assembled_configuration_update_count_(0)
+{
+    for (size_t m = 0; m < all_diffusions_.size(); ++m)
+    {
+        if (all_diffusions_[m]->diffusion_species_index_ != all_diffusions_[m]->gradient_species_index_)
+        {
+            std::cout << "\n Error: implicit diffusion requires identical diffusion and gradient species!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+    off_diagonal_.resize(all_diffusions_.size());
+    diagonal_.resize(all_diffusions_.size());
+}
+//=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+void DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::assembleMatrix()
+{
+    size_t total_real_particles = this->particles_->total_real_particles_;
+    row_sizes_.resize(total_real_particles);
+    row_offsets_.resize(total_real_particles);
+    particle_for(par, total_real_particles,
+                 [&](size_t index_i)
+                 { row_sizes_[index_i] = this->inner_configuration_[index_i].current_size_; });
+    size_t number_of_entries = particle_scan(par, row_sizes_, row_offsets_);
+    column_indexes_.resize(number_of_entries);
+    for (size_t m = 0; m < all_diffusions_.size(); ++m)
+    {
+        off_diagonal_[m].resize(number_of_entries);
+        diagonal_[m].resize(total_real_particles);
+    }
+
+    particle_for(par, total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     for (size_t m = 0; m < all_diffusions_.size(); ++m)
+                         diagonal_[m][index_i] = 0.0;
+
+                     Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+                     size_t offset = row_offsets_[index_i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         size_t index_j = inner_neighborhood.j_[n];
+                         const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+                         const Vecd &grad_ijV_j = kernel_gradient_(index_i, index_j, inner_neighborhood.dW_ijV_j_[n], e_ij);
+                         Real area_ij = 2.0 * grad_ijV_j.dot(e_ij) / inner_neighborhood.r_ij_[n];
+                         column_indexes_[offset + n] = index_j;
+                         for (size_t m = 0; m < all_diffusions_.size(); ++m)
+                         {
+                             Real diff_coeff_ij = all_diffusions_[m]->getInterParticleDiffusionCoeff(index_i, index_j, e_ij);
+                             Real c_ij = -Vol_[index_i] * diff_coeff_ij * area_ij;
+                             off_diagonal_[m][offset + n] = c_ij;
+                             diagonal_[m][index_i] += c_ij;
+                         }
+                     }
+                 });
+
+    rhs_.resize(total_real_particles);
+    residual_.resize(total_real_particles);
+    preconditioned_residual_.resize(total_real_particles);
+    search_direction_.resize(total_real_particles);
+    matrix_product_.resize(total_real_particles);
+    is_matrix_assembled_ = true;
+    assembled_configuration_update_count_ = inner_relation_.ConfigurationUpdateCount();
+}
+//=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+void DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::
+    multiplyMatrix(size_t species_index, Real dt, const StdLargeVec<Real> &x, StdLargeVec<Real> &y)
+{
+    const StdLargeVec<Real> &off_diagonal = off_diagonal_[species_index];
+    const StdLargeVec<Real> &diagonal = diagonal_[species_index];
+    particle_for(par, rhs_.size(),
+                 [&](size_t index_i)
+                 {
+                     Real sum = 0.0;
+                     for (size_t k = row_offsets_[index_i]; k != row_offsets_[index_i] + row_sizes_[index_i]; ++k)
+                         sum += off_diagonal[k] * x[column_indexes_[k]];
+                     y[index_i] = (Vol_[index_i] + dt * diagonal[index_i]) * x[index_i] - dt * sum;
+                 });
+}
+//=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+Real DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::
+    dotProduct(const StdLargeVec<Real> &a, const StdLargeVec<Real> &b)
+{
+    return particle_reduce(par, rhs_.size(), Real(0), ReduceSum<Real>(),
+                           [&](size_t index_i)
+                           { return a[index_i] * b[index_i]; });
+}
+//=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+void DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::solveSpecies(size_t species_index, Real dt)
+{
+    StdLargeVec<Real> &species = *diffusion_species_[species_index];
+    const StdLargeVec<Real> &diagonal = diagonal_[species_index];
+    particle_for(par, rhs_.size(),
+                 [&](size_t index_i)
+                 { rhs_[index_i] = Vol_[index_i] * species[index_i]; });
+    Real rhs_norm = sqrt(dotProduct(rhs_, rhs_));
+    if (rhs_norm < TinyReal)
+        return;
+
+    // the present state as initial guess
+    multiplyMatrix(species_index, dt, species, matrix_product_);
+    particle_for(par, rhs_.size(),
+                 [&](size_t index_i)
+                 {
+                     residual_[index_i] = rhs_[index_i] - matrix_product_[index_i];
+                     preconditioned_residual_[index_i] =
+                         residual_[index_i] / (Vol_[index_i] + dt * diagonal[index_i]);
+                     search_direction_[index_i] = preconditioned_residual_[index_i];
+                 });
+    Real residual_dot = dotProduct(residual_, preconditioned_residual_);
+
+    for (size_t k = 0; k != max_iterations_; ++k)
+    {
+        if (sqrt(dotProduct(residual_, residual_)) < tolerance_ * rhs_norm)
+            return;
+
+        multiplyMatrix(species_index, dt, search_direction_, matrix_product_);
+        Real alpha = residual_dot / dotProduct(search_direction_, matrix_product_);
+        particle_for(par, rhs_.size(),
+                     [&](size_t index_i)
+                     {
+                         species[index_i] += alpha * search_direction_[index_i];
+                         residual_[index_i] -= alpha * matrix_product_[index_i];
+                         preconditioned_residual_[index_i] =
+                             residual_[index_i] / (Vol_[index_i] + dt * diagonal[index_i]);
+                     });
+        Real residual_dot_new = dotProduct(residual_, preconditioned_residual_);
+        Real beta = residual_dot_new / residual_dot;
+        residual_dot = residual_dot_new;
+        particle_for(par, rhs_.size(),
+                     [&](size_t index_i)
+                     {
+                         search_direction_[index_i] =
+                             preconditioned_residual_[index_i] + beta * search_direction_[index_i];
+                     });
+    }
+    std::cout << "\n Warning: implicit diffusion is not converged after "
+              << max_iterations_ << " iterations!" << std::endl;
+}
+//=================================================================================================//
+template <class ParticlesType, class KernelGradientType>
+void DiffusionRelaxationImplicit<ParticlesType, KernelGradientType>::exec(Real dt)
+{
+    if (!is_matrix_assembled_ ||
+        assembled_configuration_update_count_ != inner_relation_.ConfigurationUpdateCount() ||
+        rhs_.size() != this->particles_->total_real_particles_)
+        assembleMatrix();
+
+    for (size_t m = 0; m < all_diffusions_.size(); ++m)
+        solveSpecies(m, dt);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // DIFFUSION_DYNAMICS_HPP
\ No newline at end of file
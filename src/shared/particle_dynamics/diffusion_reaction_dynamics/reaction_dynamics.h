@@ -92,5 +92,98 @@ class ReactionRelaxationBackward
     virtual ~ReactionRelaxationBackward(){};
     void update(size_t index_i, Real dt = 0.0) { this->advanceBackwardStep(index_i, dt); };
 };
+
+/**
+ * @class BaseBlockReactionRelaxation
+ * @brief Base class for computing the reaction process of all species for blocks of particles.
+ * @details The reaction model is called once for each species and block, in which
+ * the rates of the block are evaluated without virtual calls if the model provides them.
+ */
+template <class ParticlesType>
+class BaseBlockReactionRelaxation
+    : public BaseDynamics<void>,
+      public DiffusionReactionSimpleData<ParticlesType>
+{
+  protected:
+    static constexpr int NumReactiveSpecies = ParticlesType::NumReactiveSpecies;
+    static constexpr size_t BlockSize = 64;
+    typedef typename BaseReactionModel<NumReactiveSpecies>::BlockSpecies BlockSpecies;
+    typedef std::array<Real, BlockSize> BlockData;
+    StdVec<StdLargeVec<Real> *> &reactive_species_;
+    BaseReactionModel<NumReactiveSpecies> &reaction_model_;
+
+    void updateBlockSpecies(size_t species_index, const BlockSpecies &block_species, size_t block_size, Real dt);
+    virtual void advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt) = 0;
+
+  public:
+    explicit BaseBlockReactionRelaxation(SPHBody &sph_body);
+    virtual ~BaseBlockReactionRelaxation(){};
+
+    virtual void exec(Real dt = 0.0) override;
+};
+
+/**
+ * @class BlockReactionRelaxationForward
+ * @brief Compute the reaction process of all species by forward splitting for blocks of particles
+ */
+template <class ParticlesType>
+class BlockReactionRelaxationForward : public BaseBlockReactionRelaxation<ParticlesType>
+{
+  protected:
+    typedef typename BaseBlockReactionRelaxation<ParticlesType>::BlockSpecies BlockSpecies;
+    virtual void advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt) override;
+
+  public:
+    explicit BlockReactionRelaxationForward(SPHBody &sph_body)
+        : BaseBlockReactionRelaxation<ParticlesType>(sph_body){};
+    virtual ~BlockReactionRelaxationForward(){};
+};
+
+/**
+ * @class BlockReactionRelaxationBackward
+ * @brief Compute the reaction process of all species by backward splitting for blocks of particles
+ */
+template <class ParticlesType>
+class BlockReactionRelaxationBackward : public BaseBlockReactionRelaxation<ParticlesType>
+{
+  protected:
+    typedef typename BaseBlockReactionRelaxation<ParticlesType>::BlockSpecies BlockSpecies;
+    virtual void advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt) override;
+
+  public:
+    explicit BlockReactionRelaxationBackward(SPHBody &sph_body)
+        : BaseBlockReactionRelaxation<ParticlesType>(sph_body){};
+    virtual ~BlockReactionRelaxationBackward(){};
+};
+
+/**
+ * @class ReactionRelaxationRosenbrock
+ * @brief Compute the reaction process of all species, fully coupled,
+ * by the second-order L-stable Rosenbrock scheme (ROS2) for blocks of particles.
+ * @details The Jacobian of the reaction rates is obtained by finite differences and
+ * the resulting small linear systems are solved for each particle.
+ * As the scheme is stiffly stable, the time step size is not limited by stiff kinetics.
+ */
+template <class ParticlesType>
+class ReactionRelaxationRosenbrock : public BaseBlockReactionRelaxation<ParticlesType>
+{
+  protected:
+    static constexpr int NumReactiveSpecies = ParticlesType::NumReactiveSpecies;
+    static constexpr size_t BlockSize = BaseBlockReactionRelaxation<ParticlesType>::BlockSize;
+    typedef typename BaseBlockReactionRelaxation<ParticlesType>::BlockSpecies BlockSpecies;
+    typedef typename BaseBlockReactionRelaxation<ParticlesType>::BlockData BlockData;
+    typedef std::array<BlockData, NumReactiveSpecies> BlockSpeciesData;
+    typedef Eigen::Matrix<Real, NumReactiveSpecies, 1> SpeciesVector;
+    typedef Eigen::Matrix<Real, NumReactiveSpecies, NumReactiveSpecies> SpeciesMatrix;
+    const Real gamma_ = 1.0 + 1.0 / sqrt(2.0);
+
+    void getBlockReactionRates(BlockSpeciesData &species, size_t block_size, BlockSpeciesData &rates);
+    virtual void advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt) override;
+
+  public:
+    explicit ReactionRelaxationRosenbrock(SPHBody &sph_body)
+        : BaseBlockReactionRelaxation<ParticlesType>(sph_body){};
+    virtual ~ReactionRelaxationRosenbrock(){};
+};
 } // namespace SPH
 #endif // REACTION_DYNAMICS_H
\ No newline at end of file
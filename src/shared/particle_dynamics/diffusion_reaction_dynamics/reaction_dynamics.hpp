@@ -78,5 +78,137 @@ void BaseReactionRelaxation<ParticlesType>::
     applyGlobalSpecies(local_species, index_i);
 }
 //=================================================================================================//
+template <class ParticlesType>
+BaseBlockReactionRelaxation<ParticlesType>::
+    BaseBlockReactionRelaxation(SPHBody &sph_body)
+    : BaseDynamics<void>(sph_body),
+      DiffusionReactionSimpleData<ParticlesType>(sph_body),
+      reactive_species_(this->particles_->ReactiveSpecies()),
+      reaction_model_(this->particles_->diffusion_reaction_material_.ReactionModel()) {}
+//=================================================================================================//
+template <class ParticlesType>
+void BaseBlockReactionRelaxation<ParticlesType>::
+    updateBlockSpecies(size_t species_index, const BlockSpecies &block_species, size_t block_size, Real dt)
+{
+    BlockData production_rates, loss_rates;
+    reaction_model_.getBlockRates(species_index, block_species, block_size, production_rates.data(), loss_rates.data());
+    Real *species = block_species[species_index];
+    for (size_t i = 0; i != block_size; ++i)
+    {
+        Real decay = exp(-loss_rates[i] * dt);
+        species[i] = species[i] * decay + production_rates[i] * (1.0 - decay) / (loss_rates[i] + TinyReal);
+    }
+}
+//=================================================================================================//
+template <class ParticlesType>
+void BaseBlockReactionRelaxation<ParticlesType>::exec(Real dt)
+{
+    parallel_for(
+        IndexRange(0, this->particles_->total_real_particles_),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_begin = r.begin(); index_begin < r.end(); index_begin += BlockSize)
+            {
+                BlockSpecies block_species;
+                for (size_t k = 0; k != NumReactiveSpecies; ++k)
+                    block_species[k] = reactive_species_[k]->data() + index_begin;
+                advanceBlock(block_species, SMIN(BlockSize, r.end() - index_begin), dt);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+template <class ParticlesType>
+void BlockReactionRelaxationForward<ParticlesType>::
+    advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt)
+{
+    for (size_t k = 0; k != this->NumReactiveSpecies; ++k)
+    {
+        this->updateBlockSpecies(k, block_species, block_size, dt);
+    }
+}
+//=================================================================================================//
+template <class ParticlesType>
+void BlockReactionRelaxationBackward<ParticlesType>::
+    advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt)
+{
+    for (size_t k = this->NumReactiveSpecies; k != 0; --k)
+    {
+        this->updateBlockSpecies(k - 1, block_species, block_size, dt);
+    }
+}
+//=================================================================================================//
+template <class ParticlesType>
+void ReactionRelaxationRosenbrock<ParticlesType>::
+    getBlockReactionRates(BlockSpeciesData &species, size_t block_size, BlockSpeciesData &rates)
+{
+    BlockSpecies block_species;
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+        block_species[k] = species[k].data();
+
+    BlockData production_rates, loss_rates;
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        this->reaction_model_.getBlockRates(k, block_species, block_size, production_rates.data(), loss_rates.data());
+        for (size_t i = 0; i != block_size; ++i)
+            rates[k][i] = production_rates[i] - loss_rates[i] * species[k][i];
+    }
+}
+//=================================================================================================//
+template <class ParticlesType>
+void ReactionRelaxationRosenbrock<ParticlesType>::
+    advanceBlock(const BlockSpecies &block_species, size_t block_size, Real dt)
+{
+    BlockSpeciesData species, rates, perturbed_species, perturbed_rates;
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+        for (size_t i = 0; i != block_size; ++i)
+            species[k][i] = block_species[k][i];
+    getBlockReactionRates(species, block_size, rates);
+
+    // finite-difference Jacobian, assembled into the stage matrices (I - gamma * dt * J)^{-1}
+    std::array<SpeciesMatrix, BlockSize> stage_matrices;
+    for (size_t i = 0; i != block_size; ++i)
+        stage_matrices[i] = SpeciesMatrix::Identity();
+    for (size_t l = 0; l != NumReactiveSpecies; ++l)
+    {
+        BlockData perturbations;
+        perturbed_species = species;
+        for (size_t i = 0; i != block_size; ++i)
+        {
+            perturbations[i] = SqrtEps * SMAX(Real(1), ABS(species[l][i]));
+            perturbed_species[l][i] += perturbations[i];
+        }
+        getBlockReactionRates(perturbed_species, block_size, perturbed_rates);
+        for (size_t k = 0; k != NumReactiveSpecies; ++k)
+            for (size_t i = 0; i != block_size; ++i)
+                stage_matrices[i](k, l) -= gamma_ * dt * (perturbed_rates[k][i] - rates[k][i]) / perturbations[i];
+    }
+    for (size_t i = 0; i != block_size; ++i)
+        stage_matrices[i] = stage_matrices[i].inverse().eval();
+
+    // first stage
+    std::array<SpeciesVector, BlockSize> first_stage;
+    for (size_t i = 0; i != block_size; ++i)
+    {
+        SpeciesVector local_rates;
+        for (size_t k = 0; k != NumReactiveSpecies; ++k)
+            local_rates[k] = rates[k][i];
+        first_stage[i] = stage_matrices[i] * local_rates;
+        for (size_t k = 0; k != NumReactiveSpecies; ++k)
+            perturbed_species[k][i] = species[k][i] + dt * first_stage[i][k];
+    }
+    // second stage and update
+    getBlockReactionRates(perturbed_species, block_size, perturbed_rates);
+    for (size_t i = 0; i != block_size; ++i)
+    {
+        SpeciesVector local_rates;
+        for (size_t k = 0; k != NumReactiveSpecies; ++k)
+            local_rates[k] = perturbed_rates[k][i] - 2.0 * first_stage[i][k];
+        SpeciesVector second_stage = stage_matrices[i] * local_rates;
+        for (size_t k = 0; k != NumReactiveSpecies; ++k)
+            block_species[k][i] = species[k][i] + dt * (1.5 * first_stage[i][k] + 0.5 * second_stage[k]);
+    }
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // REACTION_DYNAMICS_HPP
\ No newline at end of file
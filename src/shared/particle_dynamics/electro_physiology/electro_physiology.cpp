@@ -55,4 +55,90 @@ Real AlievPanfilowModel::
     return epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
 }
 //=================================================================================================//
+void AlievPanfilowModel::getBlockRates(size_t species_index, const BlockSpecies &block_species, size_t block_size,
+                                       Real *production_rates, Real *loss_rates)
+{
+    auto getLocalSpecies = [&](size_t i)
+    {
+        LocalSpecies local_species;
+        for (size_t k = 0; k != NumSpecies; ++k)
+            local_species[k] = block_species[k][i];
+        return local_species;
+    };
+
+    if (species_index == voltage_)
+    {
+        for (size_t i = 0; i != block_size; ++i)
+        {
+            LocalSpecies local_species = getLocalSpecies(i);
+            production_rates[i] = AlievPanfilowModel::getProductionRateIonicCurrent(local_species);
+            loss_rates[i] = AlievPanfilowModel::getLossRateIonicCurrent(local_species);
+        }
+    }
+    else if (species_index == gate_variable_)
+    {
+        for (size_t i = 0; i != block_size; ++i)
+        {
+            LocalSpecies local_species = getLocalSpecies(i);
+            production_rates[i] = AlievPanfilowModel::getProductionRateGateVariable(local_species);
+            loss_rates[i] = AlievPanfilowModel::getLossRateGateVariable(local_species);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i != block_size; ++i)
+        {
+            LocalSpecies local_species = getLocalSpecies(i);
+            // the active contraction stress may be redefined in a derived model
+            production_rates[i] = getProductionActiveContractionStress(local_species);
+            loss_rates[i] = getLossRateActiveContractionStress(local_species);
+        }
+    }
+}
+//=================================================================================================//
+namespace electro_physiology
+{
+//=================================================================================================//
+ElectroMechanicsSplitting::
+    ElectroMechanicsSplitting(BaseDynamics<void> &active_stress_mapping,
+                              const SubStepFunction &electro_physiology_step, const SubStepFunction &mechanics_step,
+                              int electro_physiology_concurrency, int mechanics_concurrency)
+    : active_stress_mapping_(active_stress_mapping),
+      electro_physiology_step_(electro_physiology_step), mechanics_step_(mechanics_step),
+      electro_physiology_arena_(electro_physiology_concurrency, 0), mechanics_arena_(mechanics_concurrency),
+      electro_physiology_steps_(0), mechanics_steps_(0) {}
+//=================================================================================================//
+size_t ElectroMechanicsSplitting::advanceSubProblem(const SubStepFunction &sub_step, Real coupling_interval)
+{
+    size_t steps = 0;
+    Real integration_time = 0.0;
+    while (coupling_interval - integration_time > TinyReal)
+    {
+        integration_time += sub_step(coupling_interval - integration_time);
+        steps++;
+    }
+    return steps;
+}
+//=================================================================================================//
+void ElectroMechanicsSplitting::advance(Real coupling_interval)
+{
+    active_stress_mapping_.exec();
+
+    tbb::task_group electro_physiology_task;
+    electro_physiology_arena_.execute(
+        [&]()
+        {
+            electro_physiology_task.run(
+                [&]()
+                { electro_physiology_steps_ += advanceSubProblem(electro_physiology_step_, coupling_interval); });
+        });
+    mechanics_arena_.execute(
+        [&]()
+        { mechanics_steps_ += advanceSubProblem(mechanics_step_, coupling_interval); });
+    electro_physiology_arena_.execute([&]()
+                                      { electro_physiology_task.wait(); });
+}
+//=================================================================================================//
+} // namespace electro_physiology
+//=================================================================================================//
 } // namespace SPH
@@ -33,6 +33,9 @@
 #include "all_diffusion_reaction_dynamics.h"
 #include "solid_particles.h"
 
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
 namespace SPH
 {
 class ElectroPhysiologyReaction : public BaseReactionModel<3>
@@ -70,6 +73,7 @@ class ElectroPhysiologyReaction : public BaseReactionModel<3>
  * @brief The simplest Electrophysiology Reaction model,
  * which reduces the complex of array of ion currents to two variables that
  * describe excitation and recovery.
+ * The rate functions of the two variables are final, so that they are called directly in the block rates.
  */
 class AlievPanfilowModel : public ElectroPhysiologyReaction
 {
@@ -77,10 +81,10 @@ class AlievPanfilowModel : public ElectroPhysiologyReaction
     /** Parameters for two variable cell model. */
     Real k_, a_, b_, mu_1_, mu_2_, epsilon_, c_m_;
 
-    virtual Real getProductionRateIonicCurrent(LocalSpecies &species) override;
-    virtual Real getLossRateIonicCurrent(LocalSpecies &species) override;
-    virtual Real getProductionRateGateVariable(LocalSpecies &species) override;
-    virtual Real getLossRateGateVariable(LocalSpecies &species) override;
+    virtual Real getProductionRateIonicCurrent(LocalSpecies &species) override final;
+    virtual Real getLossRateIonicCurrent(LocalSpecies &species) override final;
+    virtual Real getProductionRateGateVariable(LocalSpecies &species) override final;
+    virtual Real getLossRateGateVariable(LocalSpecies &species) override final;
 
   public:
     explicit AlievPanfilowModel(Real k_a, Real c_m, Real k, Real a, Real b, Real mu_1, Real mu_2, Real epsilon)
@@ -90,6 +94,9 @@ class AlievPanfilowModel : public ElectroPhysiologyReaction
         reaction_model_ = "AlievPanfilowModel";
     };
     virtual ~AlievPanfilowModel(){};
+
+    virtual void getBlockRates(size_t species_index, const BlockSpecies &block_species, size_t block_size,
+                               Real *production_rates, Real *loss_rates) override;
 };
 
 // type trait for pass type template constructor
@@ -213,10 +220,51 @@ class ElectroPhysiologyDiffusionRelaxationComplex
 
 /** Solve the reaction ODE equation of trans-membrane potential	using forward sweeping */
 using ElectroPhysiologyReactionRelaxationForward =
-    SimpleDynamics<ReactionRelaxationForward<ElectroPhysiologyParticles>>;
+    BlockReactionRelaxationForward<ElectroPhysiologyParticles>;
 /** Solve the reaction ODE equation of trans-membrane potential	using backward sweeping */
 using ElectroPhysiologyReactionRelaxationBackward =
-    SimpleDynamics<ReactionRelaxationBackward<ElectroPhysiologyParticles>>;
+    BlockReactionRelaxationBackward<ElectroPhysiologyParticles>;
+/** Solve the reaction ODE equation of trans-membrane potential	using the stiffly stable Rosenbrock scheme */
+using ElectroPhysiologyReactionRelaxationRosenbrock =
+    ReactionRelaxationRosenbrock<ElectroPhysiologyParticles>;
+
+/**
+ * @class ElectroMechanicsSplitting
+ * @brief Operator splitting for electro-mechanics, in which the electrophysiology and the mechanics
+ * advance concurrently over a coupling interval, each with its own time step sizes and in its own task arena.
+ * @details Each sub-problem is given by a function which advances it by one step not larger than
+ * the remaining time of the coupling interval and returns the step size taken.
+ * The active contraction stress is mapped onto the mechanical particles at the beginning of
+ * each coupling interval, i.e. the mechanics lags the electrophysiology by one interval.
+ * The electrophysiology may be solved on coarser particles than the mechanics
+ * with the mapping by InterpolatingAQuantityByStencil.
+ * The electrophysiology is driven by a worker thread of its arena, which reserves no slot for the caller,
+ * and the mechanics by the calling thread, so that their particle loops use different affinity partitioners.
+ */
+class ElectroMechanicsSplitting
+{
+  public:
+    typedef std::function<Real(Real)> SubStepFunction;
+    ElectroMechanicsSplitting(BaseDynamics<void> &active_stress_mapping,
+                              const SubStepFunction &electro_physiology_step, const SubStepFunction &mechanics_step,
+                              int electro_physiology_concurrency, int mechanics_concurrency);
+    virtual ~ElectroMechanicsSplitting(){};
+    /** Advance both sub-problems by the coupling interval. */
+    void advance(Real coupling_interval);
+    size_t ElectroPhysiologySteps() { return electro_physiology_steps_; };
+    size_t MechanicsSteps() { return mechanics_steps_; };
+
+  protected:
+    BaseDynamics<void> &active_stress_mapping_;
+    SubStepFunction electro_physiology_step_;
+    SubStepFunction mechanics_step_;
+    tbb::task_arena electro_physiology_arena_;
+    tbb::task_arena mechanics_arena_;
+    size_t electro_physiology_steps_;
+    size_t mechanics_steps_;
+
+    size_t advanceSubProblem(const SubStepFunction &sub_step, Real coupling_interval);
+};
 } // namespace electro_physiology
 } // namespace SPH
 #endif // ELECTRO_PHYSIOLOGY_H
\ No newline at end of file
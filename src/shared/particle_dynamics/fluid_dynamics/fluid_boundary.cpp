@@ -55,7 +55,8 @@ void EmitterInflowCondition ::update(size_t unsorted_index_i, Real dt)
 //=================================================================================================//
 EmitterInflowInjection::EmitterInflowInjection(BodyAlignedBoxByParticle &aligned_box_part,
                                                size_t body_buffer_width, int axis)
-    : BaseLocalDynamics<BodyPartByParticle>(aligned_box_part), FluidDataSimple(sph_body_),
+    : BaseDynamics<void>(aligned_box_part.getSPHBody()),
+      BaseLocalDynamics<BodyPartByParticle>(aligned_box_part), FluidDataSimple(aligned_box_part.getSPHBody()),
       fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
       pos_(particles_->pos_), rho_(particles_->rho_),
       p_(*particles_->getVariableByName<Real>("Pressure")),
@@ -63,47 +64,84 @@ EmitterInflowInjection::EmitterInflowInjection(BodyAlignedBoxByParticle &aligned
 {
     size_t total_body_buffer_particles = aligned_box_part.body_part_particles_.size() * body_buffer_width;
     particles_->addBufferParticles(total_body_buffer_particles);
-    sph_body_.allocateConfigurationMemoriesForBufferParticles();
+    aligned_box_part.getSPHBody().allocateConfigurationMemoriesForBufferParticles();
+    injection_marks_.resize(aligned_box_part.body_part_particles_.size(), 0);
 }
 //=================================================================================================//
-void EmitterInflowInjection::update(size_t unsorted_index_i, Real dt)
+void EmitterInflowInjection::markInjection(size_t index_i, Real dt)
 {
-    size_t sorted_index_i = sorted_id_[unsorted_index_i];
-    if (aligned_box_.checkUpperBound(axis_, pos_[sorted_index_i]))
-    {
-        mutex_switch_to_real_.lock();
-        if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
-        {
-            std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
-                      << "Not enough body buffer particles! Exit the code."
-                      << "\n";
-            exit(0);
-        }
-        /** Buffer Particle state copied from real particle. */
-        particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-        /** Realize the buffer particle by increasing the number of real particle in the body.  */
-        particles_->total_real_particles_ += 1;
-        mutex_switch_to_real_.unlock();
-        /** Periodic bounding. */
-        pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[sorted_index_i]);
-        rho_[sorted_index_i] = fluid_.ReferenceDensity();
-        p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
-    }
+    size_t sorted_index_i = sorted_id_[identifier_.body_part_particles_[index_i]];
+    injection_marks_[index_i] = aligned_box_.checkUpperBound(axis_, pos_[sorted_index_i]) ? 1 : 0;
+}
+//=================================================================================================//
+void EmitterInflowInjection::resetInjected(size_t index_i, Real dt)
+{
+    /** Periodic bounding. */
+    pos_[index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[index_i]);
+    rho_[index_i] = fluid_.ReferenceDensity();
+    p_[index_i] = fluid_.getPressure(rho_[index_i]);
+}
+//=================================================================================================//
+void EmitterInflowInjection::exec(Real dt)
+{
+    setUpdated();
+    setupDynamics(dt);
+
+    particle_for(execution::par, injection_marks_.size(),
+                 [&](size_t i)
+                 { markInjection(i, dt); });
+    particle_compact(execution::par, injection_marks_, injection_offsets_, injected_particles_,
+                     [&](size_t i)
+                     { return sorted_id_[identifier_.body_part_particles_[i]]; });
+    /** Buffer particles state copied from real particles and realized in bulk. */
+    particles_->createRealParticlesFrom(injected_particles_);
+
+    particle_for(execution::par, injected_particles_,
+                 [&](size_t i)
+                 { resetInjected(i, dt); });
 }
 //=================================================================================================//
 DisposerOutflowDeletion::
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part, int axis)
-    : BaseLocalDynamics<BodyPartByCell>(aligned_box_part), FluidDataSimple(sph_body_),
+    : BaseDynamics<void>(aligned_box_part.getSPHBody()),
+      BaseLocalDynamics<BodyPartByCell>(aligned_box_part), FluidDataSimple(aligned_box_part.getSPHBody()),
       pos_(particles_->pos_), axis_(axis), aligned_box_(aligned_box_part.aligned_box_) {}
 //=================================================================================================//
-void DisposerOutflowDeletion::update(size_t index_i, Real dt)
+bool DisposerOutflowDeletion::checkDeletion(size_t index_i)
+{
+    return index_i < particles_->total_real_particles_ && aligned_box_.checkUpperBound(axis_, pos_[index_i]);
+}
+//=================================================================================================//
+void DisposerOutflowDeletion::exec(Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
-    {
-        particles_->switchToBufferParticle(index_i);
-    }
-    mutex_switch_to_buffer_.unlock();
+    setUpdated();
+    setupDynamics(dt);
+
+    ConcurrentCellLists &body_part_cells = identifier_.body_part_cells_;
+    cell_deletion_counts_.resize(body_part_cells.size());
+    particle_for(execution::par, body_part_cells.size(),
+                 [&](size_t i)
+                 {
+                     size_t count = 0;
+                     ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+                     for (size_t num = 0; num < particle_indexes.size(); ++num)
+                         count += checkDeletion(particle_indexes[num]) ? 1 : 0;
+                     cell_deletion_counts_[i] = count;
+                 });
+
+    cell_deletion_offsets_.resize(body_part_cells.size());
+    deleted_particles_.resize(particle_scan(execution::par, cell_deletion_counts_, cell_deletion_offsets_));
+    particle_for(execution::par, body_part_cells.size(),
+                 [&](size_t i)
+                 {
+                     size_t offset = cell_deletion_offsets_[i];
+                     ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+                     for (size_t num = 0; num < particle_indexes.size(); ++num)
+                         if (checkDeletion(particle_indexes[num]))
+                             deleted_particles_[offset++] = particle_indexes[num];
+                 });
+
+    particles_->switchToBufferParticles(deleted_particles_);
 }
 //=================================================================================================//
 StaticConfinementDensity::StaticConfinementDensity(NearShapeSurface &near_surface)
@@ -33,7 +33,6 @@
 #include "fluid_dynamics_inner.h"
 
 #include "relax_dynamics.h"
-#include <mutex>
 
 namespace SPH
 {
@@ -207,42 +206,60 @@ class EmitterInflowCondition : public BaseLocalDynamics<BodyPartByParticle>, pub
  * @brief Inject particles into the computational domain.
  * Note that the axis is at the local coordinate and upper bound direction is
  * the local positive direction.
+ * The injection is carried out in two phases without locks.
+ * First, the emitter particles beyond the upper bound are marked in parallel
+ * and compacted by a parallel prefix sum.
+ * Then, buffer particles are realized in bulk as copies of the marked particles.
  */
-class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, public FluidDataSimple
+class EmitterInflowInjection : public BaseDynamics<void>,
+                               public BaseLocalDynamics<BodyPartByParticle>,
+                               public FluidDataSimple
 {
   public:
     EmitterInflowInjection(BodyAlignedBoxByParticle &aligned_box_part,
                            size_t body_buffer_width, int axis);
     virtual ~EmitterInflowInjection(){};
 
-    void update(size_t unsorted_index_i, Real dt = 0.0);
+    virtual void exec(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
     Fluid &fluid_;
     StdLargeVec<Vecd> &pos_;
     StdLargeVec<Real> &rho_, &p_;
     const int axis_; /**< the axis direction for bounding*/
     AlignedBoxShape &aligned_box_;
+    StdLargeVec<size_t> injection_marks_, injection_offsets_;
+    IndexVector injected_particles_; /**< sorted indices of the emitter particles to be injected */
+
+    void markInjection(size_t index_i, Real dt = 0.0);
+    void resetInjected(size_t index_i, Real dt = 0.0);
 };
 
 /**
  * @class DisposerOutflowDeletion
  * @brief Delete particles who ruing out the computational domain.
+ * The deletion is carried out in two phases without locks.
+ * First, the particles beyond the upper bound are counted and collected cell-wise in parallel.
+ * Then, they are switched to buffer particles in bulk.
  */
-class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public FluidDataSimple
+class DisposerOutflowDeletion : public BaseDynamics<void>,
+                                public BaseLocalDynamics<BodyPartByCell>,
+                                public FluidDataSimple
 {
   public:
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part, int axis);
     virtual ~DisposerOutflowDeletion(){};
 
-    void update(size_t index_i, Real dt = 0.0);
+    virtual void exec(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
     StdLargeVec<Vecd> &pos_;
     const int axis_; /**< the axis direction for bounding*/
     AlignedBoxShape &aligned_box_;
+    StdLargeVec<size_t> cell_deletion_counts_, cell_deletion_offsets_;
+    IndexVector deleted_particles_;
+
+    bool checkDeletion(size_t index_i);
 };
 
 /**
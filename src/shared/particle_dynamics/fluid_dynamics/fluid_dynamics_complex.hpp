@@ -232,7 +232,7 @@ void BaseIntegration1stHalfWithWall<BaseIntegration1stHalfType>::
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Real r_ij = wall_neighborhood.r_ij_[n];
 
@@ -279,7 +279,7 @@ void BaseExtendIntegration1stHalfWithWall<BaseIntegration1stHalfType>::
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Real r_ij = wall_neighborhood.r_ij_[n];
             Vecd &n_j = n_k[index_j];
@@ -323,7 +323,7 @@ void BaseIntegration2ndHalfWithWall<BaseIntegration2ndHalfType>::
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
 
             Vecd vel_in_wall = 2.0 * vel_ave_k[index_j] - this->vel_[index_i];
@@ -112,6 +112,50 @@ class DensitySummationInnerAdaptive : public BaseDensitySummationInner
     StdLargeVec<Real> &h_ratio_;
 };
 
+/**
+ * @class DensitySummationImplicitInner
+ * @brief  computing density by summation with the implicit inner relation,
+ * in which the kernel values are recomputed from the current positions.
+ * The kernel type is given at compile time if known, otherwise the kernel is evaluated by virtual calls.
+ */
+template <class KernelType = Kernel>
+class DensitySummationImplicitInner : public LocalDynamics, public FluidDataSimple
+{
+  public:
+    explicit DensitySummationImplicitInner(ImplicitInnerRelation &implicit_inner_relation)
+        : LocalDynamics(implicit_inner_relation.getSPHBody()), FluidDataSimple(implicit_inner_relation.getSPHBody()),
+          implicit_inner_relation_(implicit_inner_relation),
+          kernel_(DynamicCast<KernelType>(this, *sph_body_.sph_adaptation_->getKernel())),
+          rho_(particles_->rho_), rho0_(sph_body_.base_material_->ReferenceDensity()),
+          inv_sigma0_(1.0 / sph_body_.sph_adaptation_->LatticeNumberDensity()),
+          W0_(kernel_.W0(ZeroVecd))
+    {
+        particles_->registerVariable(rho_sum_, "DensitySummation");
+    };
+    virtual ~DensitySummationImplicitInner(){};
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        Real sigma = W0_;
+        ImplicitNeighborhood<KernelType> inner_neighborhood = implicit_inner_relation_.getNeighborhood(index_i, kernel_);
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            sigma += inner_neighborhood[n].W_ij_;
+
+        rho_sum_[index_i] = sigma * rho0_ * inv_sigma0_;
+    };
+
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        rho_[index_i] = rho_sum_[index_i];
+    };
+
+  protected:
+    ImplicitInnerRelation &implicit_inner_relation_;
+    KernelType &kernel_;
+    StdLargeVec<Real> &rho_, rho_sum_;
+    Real rho0_, inv_sigma0_, W0_;
+};
+
 /**
  * @class BaseViscousAccelerationInner
  * @brief Base class for the viscosity force induced acceleration
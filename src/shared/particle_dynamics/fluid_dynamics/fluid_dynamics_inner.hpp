@@ -64,7 +64,7 @@ void AngularConservativeViscousAccelerationInner::
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
         size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
         Real r_ij = inner_neighborhood.r_ij_[n];
 
         /** The following viscous force is given in Monaghan 2005 (Rep. Prog. Phys.), it seems that
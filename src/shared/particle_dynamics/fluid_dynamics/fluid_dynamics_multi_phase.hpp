@@ -117,7 +117,7 @@ void BaseMultiPhaseIntegration1stHalf<Integration1stHalfType>::
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
         {
             size_t index_j = contact_neighborhood.j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
             Real dW_ijV_j = contact_neighborhood.dW_ijV_j_[n];
 
             acceleration -= 2.0 * riemann_solver_k.AverageP(this->p_[index_i], p_k[index_j]) * e_ij * dW_ijV_j;
@@ -143,7 +143,7 @@ Vecd BaseMultiPhaseIntegration1stHalf<Integration1stHalfType>::
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
         {
             size_t index_j = contact_neighborhood.j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
             Real dW_ijV_j = contact_neighborhood.dW_ijV_j_[n];
 
             Real p_ave_k = riemann_solver_k.AverageP(this->p_[index_i], p_k[index_j]);
@@ -186,7 +186,7 @@ void BaseMultiPhaseIntegration2ndHalf<Integration2ndHalfType>::
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
         {
             size_t index_j = contact_neighborhood.j_[n];
-            Vecd &e_ij = contact_neighborhood.e_ij_[n];
+            const Vecd &e_ij = contact_neighborhood.e_ij_[n];
             Real dW_ijV_j = contact_neighborhood.dW_ijV_j_[n];
 
             Vecd vel_ave = riemann_solver_k.AverageV(this->vel_[index_i], vel_k[index_j]);
@@ -11,9 +11,10 @@ BoundingAlongAxis::BoundingAlongAxis(RealBody &real_body, BoundingBox bounding_b
       cell_linked_list_(real_body.getCellLinkedList()),
       cut_off_radius_max_(real_body.sph_adaptation_->getKernel()->CutOffRadius()) {}
 //=================================================================================================//
-void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkUpperBound(ListDataVector &cell_list_data, Real dt)
+void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::
+    checkUpperBound(ListDataVector &cell_list_data, ListDataVector &staged_entries, Real dt)
 {
+    staged_entries.clear();
     for (size_t num = 0; num < cell_list_data.size(); ++num)
     {
         Vecd particle_position = std::get<1>(cell_list_data[num]);
@@ -21,18 +22,16 @@ void PeriodicConditionUsingCellLinkedList::
             particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
         {
             Vecd translated_position = particle_position - periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(std::get<0>(cell_list_data[num]),
-                                                  translated_position, std::get<2>(cell_list_data[num]));
-            mutex_cell_list_entry_.unlock();
+            staged_entries.emplace_back(std::make_tuple(std::get<0>(cell_list_data[num]),
+                                                        translated_position, std::get<2>(cell_list_data[num])));
         }
     }
 }
 //=================================================================================================//
-void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkLowerBound(ListDataVector &cell_list_data, Real dt)
+void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::
+    checkLowerBound(ListDataVector &cell_list_data, ListDataVector &staged_entries, Real dt)
 {
+    staged_entries.clear();
     for (size_t num = 0; num < cell_list_data.size(); ++num)
     {
         Vecd particle_position = std::get<1>(cell_list_data[num]);
@@ -40,70 +39,128 @@ void PeriodicConditionUsingCellLinkedList::
             particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
         {
             Vecd translated_position = particle_position + periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(std::get<0>(cell_list_data[num]),
-                                                  translated_position, std::get<2>(cell_list_data[num]));
-            mutex_cell_list_entry_.unlock();
+            staged_entries.emplace_back(std::make_tuple(std::get<0>(cell_list_data[num]),
+                                                        translated_position, std::get<2>(cell_list_data[num])));
         }
     }
 }
 //=================================================================================================//
+void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::
+    insertStagedEntries(StdVec<ListDataVector> &staged_entries)
+{
+    /** insert ghost entries to cell linked list */
+    for (size_t i = 0; i != staged_entries.size(); ++i)
+        for (const ListData &list_data : staged_entries[i])
+            cell_linked_list_.InsertListDataEntry(std::get<0>(list_data), std::get<1>(list_data), std::get<2>(list_data));
+}
+//=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::exec(Real dt)
 {
     setupDynamics(dt);
 
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[0].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkLowerBound(*cell_ist, dt); });
+    /** all translated entries are staged before insertion, as the entries in bounding cells are checked */
+    particle_for(execution::ParallelPolicy(), staged_entries_[0].size(),
+                 [&](size_t i)
+                 { checkLowerBound(*bound_cells_data_[0].second[i], staged_entries_[0][i], dt); });
 
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[1].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkUpperBound(*cell_ist, dt); });
+    particle_for(execution::ParallelPolicy(), staged_entries_[1].size(),
+                 [&](size_t i)
+                 { checkUpperBound(*bound_cells_data_[1].second[i], staged_entries_[1][i], dt); });
+
+    insertStagedEntries(staged_entries_[0]);
+    insertStagedEntries(staged_entries_[1]);
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::setupDynamics(Real dt)
+bool PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::
+    checkGhostSource(size_t bound_index, const Vecd &position)
 {
-    for (size_t i = 0; i != ghost_particles_.size(); ++i)
-        ghost_particles_[i].clear();
+    return bound_index == 0
+               ? position[axis_] > bounding_bounds_.first_[axis_] &&
+                     position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_)
+               : position[axis_] < bounding_bounds_.second_[axis_] &&
+                     position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_);
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::collectGhostSources(size_t bound_index)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-        particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
+    ConcurrentCellLists &bound_cells = bound_cells_data_[bound_index].first;
+    cell_counts_.resize(bound_cells.size());
+    cell_offsets_.resize(bound_cells.size());
+    particle_for(execution::ParallelPolicy(), bound_cells.size(),
+                 [&](size_t i)
+                 {
+                     size_t count = 0;
+                     ConcurrentIndexVector &particle_indexes = *bound_cells[i];
+                     for (size_t num = 0; num < particle_indexes.size(); ++num)
+                         count += checkGhostSource(bound_index, pos_[particle_indexes[num]]) ? 1 : 0;
+                     cell_counts_[i] = count;
+                 });
+
+    new_ghost_sources_.resize(particle_scan(execution::ParallelPolicy(), cell_counts_, cell_offsets_));
+    particle_for(execution::ParallelPolicy(), bound_cells.size(),
+                 [&](size_t i)
+                 {
+                     size_t offset = cell_offsets_[i];
+                     ConcurrentIndexVector &particle_indexes = *bound_cells[i];
+                     for (size_t num = 0; num < particle_indexes.size(); ++num)
+                         if (checkGhostSource(bound_index, pos_[particle_indexes[num]]))
+                             new_ghost_sources_[offset++] = particle_indexes[num];
+                 });
+
+    for (size_t k = 0; k != extra_ghost_candidates_.size(); ++k)
     {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[0].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position + periodic_translation_;
-        /** insert ghost particle to cell linked list */
-        cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
+        IndexVector &candidates = *extra_ghost_candidates_[k];
+        extra_marks_.resize(candidates.size());
+        particle_for(execution::ParallelPolicy(), candidates.size(),
+                     [&](size_t i)
+                     { extra_marks_[i] = checkGhostSource(bound_index, pos_[candidates[i]]) ? 1 : 0; });
+        particle_compact(execution::ParallelPolicy(), extra_marks_, extra_offsets_, extra_ghost_sources_,
+                         [&](size_t i)
+                         { return candidates[i]; });
+        new_ghost_sources_.insert(new_ghost_sources_.end(), extra_ghost_sources_.begin(), extra_ghost_sources_.end());
     }
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::
+    createGhostParticles(size_t bound_index, const Vecd &translation)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-        particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+    size_t first_ghost_index = particles_->insertGhostParticles(new_ghost_sources_);
+
+    IndexVector &ghost_particles = ghost_particles_[bound_index];
+    bool is_mapping_unchanged = new_ghost_sources_ == ghost_sources_[bound_index] &&
+                                (ghost_particles.empty() || ghost_particles[0] == first_ghost_index);
+    if (!is_mapping_unchanged)
+    {
+        ghost_sources_[bound_index].swap(new_ghost_sources_);
+        ghost_particles.resize(ghost_sources_[bound_index].size());
+        particle_for(execution::ParallelPolicy(), ghost_particles.size(),
+                     [&](size_t k)
+                     { ghost_particles[k] = first_ghost_index + k; });
+    }
+
+    particle_for(execution::ParallelPolicy(), ghost_particles,
+                 [&](size_t i)
+                 { pos_[i] += translation; });
+    /** insert ghost particles to cell linked list */
+    for (size_t k = 0; k != ghost_particles.size(); ++k)
     {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[1].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position - periodic_translation_;
-        /** insert ghost particle to cell linked list */
+        size_t ghost_particle_index = ghost_particles[k];
         cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
+                                              pos_[ghost_particle_index], Vol_[ghost_particle_index]);
     }
 }
 //=================================================================================================//
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::exec(Real dt)
+{
+    setupDynamics(dt);
+
+    collectGhostSources(0);
+    createGhostParticles(0, periodic_translation_);
+
+    collectGhostSources(1);
+    createGhostParticles(1, -periodic_translation_);
+}
+//=================================================================================================//
 void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 {
     particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
@@ -129,5 +186,24 @@ void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::exec(Re
                  { checkUpperBound(i, dt); });
 }
 //=================================================================================================//
+MultiAxisPeriodicConditionUsingGhostParticles::
+    MultiAxisPeriodicConditionUsingGhostParticles(RealBody &real_body, BoundingBox bounding_bounds, StdVec<int> axes)
+    : bounding_(real_body), ghost_creation_(real_body), ghost_update_(real_body)
+{
+    for (size_t k = 0; k != axes.size(); ++k)
+    {
+        PeriodicConditionUsingGhostParticles *periodic_condition =
+            periodic_conditions_keeper_.createPtr<PeriodicConditionUsingGhostParticles>(
+                real_body, bounding_bounds, axes[k]);
+        for (size_t l = 0; l != periodic_conditions_.size(); ++l)
+            periodic_condition->includeGhostParticlesOf(*periodic_conditions_[l]);
+        periodic_conditions_.push_back(periodic_condition);
+
+        bounding_.axis_dynamics_.push_back(&periodic_condition->bounding_);
+        ghost_creation_.axis_dynamics_.push_back(&periodic_condition->ghost_creation_);
+        ghost_update_.axis_dynamics_.push_back(&periodic_condition->ghost_update_);
+    }
+}
+//=================================================================================================//
 } // namespace SPH
   //=================================================================================================//
\ No newline at end of file
@@ -149,15 +149,18 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
     /**
      * @class PeriodicCellLinkedList
      * @brief Periodic boundary condition in an axis direction
+     * @details The translated entries are first written, in parallel, into the staging list of each bounding cell,
+     * whose capacity is kept between steps, and then inserted into the cell linked list without locks.
      */
     class PeriodicCellLinkedList : public BoundingAlongAxis
     {
       protected:
-        std::mutex mutex_cell_list_entry_; /**< mutex exclusion for memory conflict */
         Vecd &periodic_translation_;
         StdVec<CellLists> &bound_cells_data_;
-        virtual void checkLowerBound(ListDataVector &cell_list_data, Real dt = 0.0);
-        virtual void checkUpperBound(ListDataVector &cell_list_data, Real dt = 0.0);
+        StdVec<StdVec<ListDataVector>> staged_entries_; /**< translated entries for each bounding cell */
+        virtual void checkLowerBound(ListDataVector &cell_list_data, ListDataVector &staged_entries, Real dt = 0.0);
+        virtual void checkUpperBound(ListDataVector &cell_list_data, ListDataVector &staged_entries, Real dt = 0.0);
+        void insertStagedEntries(StdVec<ListDataVector> &staged_entries);
 
       public:
         PeriodicCellLinkedList(Vecd &periodic_translation,
@@ -165,8 +168,12 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
                                RealBody &real_body, BoundingBox bounding_bounds, int axis)
             : BoundingAlongAxis(real_body, bounding_bounds, axis),
               periodic_translation_(periodic_translation),
-              bound_cells_data_(bound_cells_data){};
-        ;
+              bound_cells_data_(bound_cells_data)
+        {
+            staged_entries_.resize(bound_cells_data_.size());
+            for (size_t i = 0; i != bound_cells_data_.size(); ++i)
+                staged_entries_[i].resize(bound_cells_data_[i].second.size());
+        };
         virtual ~PeriodicCellLinkedList(){};
 
         virtual void exec(Real dt = 0.0) override;
@@ -183,6 +190,29 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
     PeriodicCellLinkedList update_cell_linked_list_;
 };
 
+/**
+ * @class PeriodicConditionUsingVirtualCellOffset
+ * @brief The method imposing periodic boundary condition in an axis direction
+ *	without inserting translated entries into the cell linked list.
+ *	The periodic image is registered to the cell linked list and found in neighbor search
+ *	by searching from a position shifted with the periodic translation, i.e. a virtual cell offset.
+ *	Therefore, only the periodic bounding is carried out before update cell linked list.
+ *	The periodic conditions in combined directions are also supported.
+ */
+class PeriodicConditionUsingVirtualCellOffset : public BasePeriodicCondition<execution::ParallelPolicy>
+{
+  public:
+    PeriodicConditionUsingVirtualCellOffset(RealBody &real_body, BoundingBox bounding_bounds, int axis)
+        : BasePeriodicCondition<execution::ParallelPolicy>(real_body, bounding_bounds, axis),
+          bounding_(periodic_translation_, bound_cells_data_, real_body, bounding_bounds, axis)
+    {
+        real_body.getCellLinkedList().addPeriodicImage(bounding_bounds, axis);
+    };
+    virtual ~PeriodicConditionUsingVirtualCellOffset(){};
+
+    PeriodicBounding bounding_;
+};
+
 /**
  * @class PeriodicConditionUsingGhostParticles
  * @brief The method imposing periodic boundary condition in an axis direction by using ghost particles.
@@ -190,36 +220,52 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
  *	The first step is carried out before update cell linked list and
  *	the second and third after the updating.
  *	If the exec or parallel_exec is called directly, error message will be given.
- *  Note that, currently, this class is not for periodic condition in combined directions,
- *  such as periodic condition in both x and y directions.
+ *  Note that, for periodic condition in combined directions, such as in both x and y directions,
+ *  MultiAxisPeriodicConditionUsingGhostParticles should be used so that the ghosts at corners are created.
  */
 class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execution::ParallelPolicy>
 {
   protected:
     StdVec<IndexVector> ghost_particles_;
+    /** ghost particles created in other axis directions, which are also candidates for creating ghosts */
+    StdVec<IndexVector *> extra_ghost_candidates_;
 
     /**
      * @class CreatPeriodicGhostParticles
      * @brief create ghost particles in an axis direction
+     * @details The ghosts are created in bulk. The candidates in each bounding cell are counted in parallel,
+     * the ghost range is reserved once and the particle data are copied with a parallel gather.
+     * The ghost index lists are reused if the particles for creating ghosts did not change.
      */
     class CreatPeriodicGhostParticles : public PeriodicBounding
     {
       protected:
-        std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
         StdVec<IndexVector> &ghost_particles_;
+        StdVec<IndexVector *> &extra_ghost_candidates_;
         StdLargeVec<Real> &Vol_;
-        virtual void setupDynamics(Real dt = 0.0) override;
-        virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
-        virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+        StdVec<IndexVector> ghost_sources_; /**< particles from which the ghosts are created */
+        IndexVector new_ghost_sources_, extra_ghost_sources_;
+        StdLargeVec<size_t> cell_counts_, cell_offsets_, extra_marks_, extra_offsets_;
+
+        bool checkGhostSource(size_t bound_index, const Vecd &position);
+        void collectGhostSources(size_t bound_index);
+        void createGhostParticles(size_t bound_index, const Vecd &translation);
 
       public:
         CreatPeriodicGhostParticles(Vecd &periodic_translation,
                                     StdVec<CellLists> &bound_cells_data,
                                     StdVec<IndexVector> &ghost_particles,
+                                    StdVec<IndexVector *> &extra_ghost_candidates,
                                     RealBody &real_body, BoundingBox bounding_bounds, int axis)
             : PeriodicBounding(periodic_translation, bound_cells_data, real_body, bounding_bounds, axis),
-              ghost_particles_(ghost_particles), Vol_(particles_->Vol_){};
+              ghost_particles_(ghost_particles), extra_ghost_candidates_(extra_ghost_candidates),
+              Vol_(particles_->Vol_)
+        {
+            ghost_sources_.resize(2);
+        };
         virtual ~CreatPeriodicGhostParticles(){};
+
+        virtual void exec(Real dt = 0.0) override;
     };
 
     /**
@@ -249,7 +295,8 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
     PeriodicConditionUsingGhostParticles(RealBody &real_body, BoundingBox bounding_bounds, int axis)
         : BasePeriodicCondition<execution::ParallelPolicy>(real_body, bounding_bounds, axis),
           bounding_(periodic_translation_, bound_cells_data_, real_body, bounding_bounds, axis),
-          ghost_creation_(periodic_translation_, bound_cells_data_, ghost_particles_, real_body, bounding_bounds, axis),
+          ghost_creation_(periodic_translation_, bound_cells_data_, ghost_particles_, extra_ghost_candidates_,
+                          real_body, bounding_bounds, axis),
           ghost_update_(periodic_translation_, bound_cells_data_, ghost_particles_, real_body, bounding_bounds, axis)
     {
         ghost_particles_.resize(2);
@@ -257,9 +304,61 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
 
     virtual ~PeriodicConditionUsingGhostParticles(){};
 
+    /** The ghosts created by the condition in another axis direction are taken as candidates too.
+     *  Note that the other condition should create and update its ghosts before this one. */
+    void includeGhostParticlesOf(PeriodicConditionUsingGhostParticles &other_axis_condition)
+    {
+        for (size_t i = 0; i != other_axis_condition.ghost_particles_.size(); ++i)
+            extra_ghost_candidates_.push_back(&other_axis_condition.ghost_particles_[i]);
+    };
+
     PeriodicBounding bounding_;
     CreatPeriodicGhostParticles ghost_creation_;
     UpdatePeriodicGhostParticles ghost_update_;
 };
+
+/**
+ * @class MultiAxisPeriodicConditionUsingGhostParticles
+ * @brief The periodic boundary condition in several axis directions by using ghost particles.
+ * The axis directions are treated in the given order with the bulk ghost creation,
+ * and the ghosts created for an axis direction are candidates for the following ones.
+ * Therefore, the ghosts at corners and edges are created without the need of extra layers.
+ * The usage is the same as PeriodicConditionUsingGhostParticles.
+ */
+class MultiAxisPeriodicConditionUsingGhostParticles
+{
+  private:
+    UniquePtrsKeeper<PeriodicConditionUsingGhostParticles> periodic_conditions_keeper_;
+
+  protected:
+    StdVec<PeriodicConditionUsingGhostParticles *> periodic_conditions_;
+
+    /**
+     * @class SequencedAxisDynamics
+     * @brief execute the dynamics of all axis directions in sequence.
+     */
+    class SequencedAxisDynamics : public BaseDynamics<void>
+    {
+      public:
+        StdVec<BaseDynamics<void> *> axis_dynamics_;
+
+        explicit SequencedAxisDynamics(RealBody &real_body) : BaseDynamics<void>(real_body){};
+        virtual ~SequencedAxisDynamics(){};
+
+        virtual void exec(Real dt = 0.0) override
+        {
+            for (size_t k = 0; k != axis_dynamics_.size(); ++k)
+                axis_dynamics_[k]->exec(dt);
+        };
+    };
+
+  public:
+    MultiAxisPeriodicConditionUsingGhostParticles(RealBody &real_body, BoundingBox bounding_bounds, StdVec<int> axes);
+    virtual ~MultiAxisPeriodicConditionUsingGhostParticles(){};
+
+    SequencedAxisDynamics bounding_;
+    SequencedAxisDynamics ghost_creation_;
+    SequencedAxisDynamics ghost_update_;
+};
 } // namespace SPH
 #endif // GENERAL_BOUNDING_H
@@ -696,4 +696,237 @@ void MergeWithMinimumDensityErrorInner::kineticEnergyConservation(const StdVec<s
     vel_n_[merge_indices[1]][1] = linear_m[1] - vel_n_[merge_indices[0]][1];
 }
 //=================================================================================================//
+ParticleSplitAndMergeInParallel::
+    ParticleSplitAndMergeInParallel(BaseInnerRelation &inner_relation, Shape &refinement_region, size_t body_buffer_width)
+    : BaseDynamics<void>(inner_relation.getSPHBody()), GeneralDataDelegateInner(inner_relation),
+      refinement_region_bounds_(refinement_region.getBounds()),
+      particle_adaptation_(DynamicCast<ParticleSplitAndMerge>(this, *inner_relation.getSPHBody().sph_adaptation_)),
+      inv_rho0_(1.0 / inner_relation.getSPHBody().base_material_->ReferenceDensity()),
+      Vol_(particles_->Vol_), pos_(particles_->pos_), mass_(particles_->mass_),
+      h_ratio_(*particles_->getVariableByName<Real>("SmoothingLengthRatio")),
+      all_particle_data_(particles_->getAllParticleData()), max_matching_rounds_(3)
+{
+    particles_->addBufferParticles(body_buffer_width);
+    inner_relation.getSPHBody().allocateConfigurationMemoriesForBufferParticles();
+}
+//=================================================================================================//
+bool ParticleSplitAndMergeInParallel::isInsideRefinementRegion(const Vecd &position, Real volume)
+{
+    Real particle_spacing = pow(volume, 1.0 / (Real)Dimensions);
+    for (int axis_direction = 0; axis_direction != Dimensions; ++axis_direction)
+    {
+        if (position[axis_direction] <= (refinement_region_bounds_.first_[axis_direction] + particle_spacing) ||
+            position[axis_direction] >= (refinement_region_bounds_.second_[axis_direction] - particle_spacing))
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
+bool ParticleSplitAndMergeInParallel::isMergeCandidate(size_t index_i)
+{
+    Real non_deformed_volume = mass_[index_i] * inv_rho0_;
+    return particle_adaptation_.mergeResolutionCheck(non_deformed_volume) &&
+           !isInsideRefinementRegion(pos_[index_i], non_deformed_volume);
+}
+//=================================================================================================//
+bool ParticleSplitAndMergeInParallel::isMergePartner(size_t index_i, size_t index_j)
+{
+    Real particle_spacing = pow(mass_[index_i] * inv_rho0_, 1.0 / (Real)Dimensions);
+    Real search_distance = 1.2 * particle_spacing;
+    if ((pos_[index_j] - pos_[index_i]).norm() >= search_distance)
+        return false;
+
+    bool resolution_check = particle_adaptation_.mergeResolutionCheck(mass_[index_j] * inv_rho0_);
+    return ABS(particle_spacing - particle_adaptation_.ReferenceSpacing()) < TinyReal ? !resolution_check : resolution_check;
+}
+//=================================================================================================//
+bool ParticleSplitAndMergeInParallel::isCloserPair(size_t index_i, size_t index_j, size_t index_k, size_t index_l)
+{
+    Real distance_ij = (pos_[index_i] - pos_[index_j]).squaredNorm();
+    Real distance_kl = (pos_[index_k] - pos_[index_l]).squaredNorm();
+    if (distance_ij != distance_kl)
+        return distance_ij < distance_kl;
+    // tie broken by the particle indices so that all particles agree on the order
+    return std::make_pair(SMIN(index_i, index_j), SMAX(index_i, index_j)) <
+           std::make_pair(SMIN(index_k, index_l), SMAX(index_k, index_l));
+}
+//=================================================================================================//
+size_t ParticleSplitAndMergeInParallel::matchMergePairs()
+{
+    size_t total_real_particles = particles_->total_real_particles_;
+    partner_.resize(total_real_particles);
+    proposal_.resize(total_real_particles);
+    best_partner_.resize(total_real_particles);
+    particle_for(par, total_real_particles, [&](size_t index_i)
+                 { partner_[index_i] = index_i; });
+
+    size_t number_of_pairs = 0;
+    for (size_t round = 0; round != max_matching_rounds_; ++round)
+    {
+        // each unmatched candidate proposes its nearest unmatched partner
+        particle_for(par, total_real_particles,
+                     [&](size_t index_i)
+                     {
+                         proposal_[index_i] = index_i;
+                         if (partner_[index_i] != index_i || !isMergeCandidate(index_i))
+                             return;
+
+                         const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         {
+                             size_t index_j = inner_neighborhood.j_[n];
+                             if (index_j < total_real_particles && partner_[index_j] == index_j &&
+                                 isMergePartner(index_i, index_j) &&
+                                 (proposal_[index_i] == index_i || isCloserPair(index_i, index_j, index_i, proposal_[index_i])))
+                                 proposal_[index_i] = index_j;
+                         }
+                     });
+        // each unmatched particle chooses the nearest pair proposed from or to it
+        particle_for(par, total_real_particles,
+                     [&](size_t index_i)
+                     {
+                         best_partner_[index_i] = proposal_[index_i];
+                         if (partner_[index_i] != index_i)
+                             return;
+
+                         const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         {
+                             size_t index_k = inner_neighborhood.j_[n];
+                             if (index_k < total_real_particles && proposal_[index_k] == index_i &&
+                                 (best_partner_[index_i] == index_i || isCloserPair(index_k, index_i, index_i, best_partner_[index_i])))
+                                 best_partner_[index_i] = index_k;
+                         }
+                     });
+        // a pair is matched only if both particles choose it, so that the matched pairs do not overlap
+        size_t matched_particles = particle_reduce(
+            par, total_real_particles, size_t(0), ReduceSum<size_t>(),
+            [&](size_t index_i) -> size_t
+            {
+                size_t index_j = best_partner_[index_i];
+                if (partner_[index_i] == index_i && index_j != index_i && best_partner_[index_j] == index_i)
+                {
+                    partner_[index_i] = index_j;
+                    return 1;
+                }
+                return 0;
+            });
+
+        if (matched_particles == 0)
+            break;
+        number_of_pairs += matched_particles / 2;
+    }
+    return number_of_pairs;
+}
+//=================================================================================================//
+void ParticleSplitAndMergeInParallel::removeParticles(size_t number_of_removed_particles)
+{
+    size_t total_real_particles = particles_->total_real_particles_;
+    size_t remaining_particles = total_real_particles - number_of_removed_particles;
+    StdLargeVec<size_t> is_removed = marks_;
+
+    // removed particles below and remaining particles above the new particle number are swapped
+    particle_for(par, total_real_particles, [&](size_t index_i)
+                 { marks_[index_i] = index_i < remaining_particles ? is_removed[index_i] : 0; });
+    particle_compact(par, marks_, offsets_, holes_, [](size_t index_i)
+                     { return index_i; });
+    particle_for(par, total_real_particles, [&](size_t index_i)
+                 { marks_[index_i] = index_i < remaining_particles ? 0 : 1 - is_removed[index_i]; });
+    particle_compact(par, marks_, offsets_, fillers_, [](size_t index_i)
+                     { return index_i; });
+
+    particle_for(par, holes_.size(), [&](size_t n)
+                 { particles_->copyFromAnotherParticle(holes_[n], fillers_[n]); });
+    particles_->total_real_particles_ = remaining_particles;
+}
+//=================================================================================================//
+size_t ParticleSplitAndMergeInParallel::mergeParticles()
+{
+    size_t number_of_pairs = matchMergePairs();
+    if (number_of_pairs == 0)
+        return 0;
+
+    size_t total_real_particles = particles_->total_real_particles_;
+    marks_.resize(total_real_particles);
+    particle_for(par, total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     size_t index_j = partner_[index_i];
+                     marks_[index_i] = index_j < index_i ? 1 : 0;
+                     if (index_i < index_j)
+                     {
+                         StdVec<size_t> merge_indices = {index_j, index_i};
+                         StdVec<Real> merge_mass = {mass_[index_j], mass_[index_i]};
+                         merge_particle_value_(all_particle_data_, index_i, merge_indices, merge_mass);
+                         mass_[index_i] = merge_mass[0] + merge_mass[1];
+                         Vol_[index_i] = mass_[index_i] * inv_rho0_;
+                         Real particle_spacing = pow(Vol_[index_i], 1.0 / (Real)Dimensions);
+                         h_ratio_[index_i] = particle_adaptation_.ReferenceSpacing() / particle_spacing;
+                     }
+                 });
+    removeParticles(number_of_pairs);
+    return number_of_pairs;
+}
+//=================================================================================================//
+Vecd ParticleSplitAndMergeInParallel::getSplittingPosition(size_t index_i)
+{
+    // a deterministic angle from the golden ratio sequence, instead of the non-reentrant rand()
+    Real golden_ratio_sequence = Real(index_i) * 0.6180339887498949;
+    Real delta = 2.0 * Pi * (golden_ratio_sequence - floor(golden_ratio_sequence));
+    Real particle_spacing = pow(0.5 * Vol_[index_i], 1.0 / (Real)Dimensions);
+    return particle_adaptation_.splittingPattern(pos_[index_i], particle_spacing, delta);
+}
+//=================================================================================================//
+size_t ParticleSplitAndMergeInParallel::splitParticles()
+{
+    size_t total_real_particles = particles_->total_real_particles_;
+    marks_.resize(total_real_particles);
+    offsets_.resize(total_real_particles);
+    particle_for(par, total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     Real non_deformed_volume = mass_[index_i] * inv_rho0_;
+                     marks_[index_i] = particle_adaptation_.isSplitAllowed(non_deformed_volume) &&
+                                               isInsideRefinementRegion(pos_[index_i], non_deformed_volume)
+                                           ? 1
+                                           : 0;
+                 });
+    size_t number_of_split_particles = particle_scan(par, marks_, offsets_);
+    if (total_real_particles + number_of_split_particles > particles_->real_particles_bound_)
+    {
+        std::cout << "\n Error: not enough body buffer particles for splitting!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    particle_for(par, total_real_particles,
+                 [&](size_t index_i)
+                 {
+                     if (marks_[index_i] == 0)
+                         return;
+
+                     size_t index_new = total_real_particles + offsets_[index_i];
+                     particles_->copyFromAnotherParticle(index_new, index_i);
+                     Vecd pos_split = getSplittingPosition(index_i);
+                     Real split_mass = 0.5 * mass_[index_i];
+                     Real particle_spacing = pow(split_mass * inv_rho0_, 1.0 / (Real)Dimensions);
+                     for (size_t index_k : {index_i, index_new})
+                     {
+                         mass_[index_k] = split_mass;
+                         Vol_[index_k] = mass_[index_k] * inv_rho0_;
+                         h_ratio_[index_k] = particle_adaptation_.ReferenceSpacing() / particle_spacing;
+                     }
+                     pos_[index_i] = 2.0 * pos_[index_i] - pos_split;
+                     pos_[index_new] = pos_split;
+                 });
+    particles_->total_real_particles_ += number_of_split_particles;
+    return number_of_split_particles;
+}
+//=================================================================================================//
+void ParticleSplitAndMergeInParallel::exec(Real dt)
+{
+    mergeParticles();
+    splitParticles();
+}
+//=================================================================================================//
 } // namespace SPH
@@ -209,6 +209,31 @@ class SplitWithMinimumDensityErrorWithWall : public SplitWithMinimumDensityError
     ComputeDensityErrorWithWall compute_density_error;
 };
 
+/**
+ * @struct mergeParticleDataValue
+ * @brief Mass weighted average of all particle data of the merging particles.
+ */
+template <typename VariableType>
+struct mergeParticleDataValue
+{
+    void operator()(ParticleData &particle_data, size_t merged_index, const StdVec<size_t> &merge_indices, StdVec<Real> merge_mass)
+    {
+        Real total_mass = 0.0;
+        for (size_t k = 0; k != merge_indices.size(); ++k)
+            total_mass += merge_mass[k];
+
+        constexpr int type_index = DataTypeIndex<VariableType>::value;
+        for (size_t i = 0; i != std::get<type_index>(particle_data).size(); ++i)
+        {
+            VariableType particle_data_temp = ZeroData<VariableType>::value;
+            for (size_t k = 0; k != merge_indices.size(); ++k)
+                particle_data_temp += merge_mass[k] * (*std::get<type_index>(particle_data)[i])[merge_indices[k]];
+
+            (*std::get<type_index>(particle_data)[i])[merged_index] = particle_data_temp / (total_mass + TinyReal);
+        }
+    };
+};
+
 /**
  * @class ParticleMergeWithPrescribedArea
  * @brief merging particle for a body in prescribed area.
@@ -246,26 +271,6 @@ class ParticleMergeWithPrescribedArea : public ParticleRefinementWithPrescribedA
     bool findMergeParticles(size_t index_i, StdVec<size_t> &merge_indices, Real search_size, Real search_distance);
     virtual void updateMergedParticleInformation(size_t merged_index, const StdVec<size_t> &merge_indices);
 
-    template <typename VariableType>
-    struct mergeParticleDataValue
-    {
-        void operator()(ParticleData &particle_data, size_t merged_index, const StdVec<size_t> &merge_indices, StdVec<Real> merge_mass)
-        {
-            Real total_mass = 0.0;
-            for (size_t k = 0; k != merge_indices.size(); ++k)
-                total_mass += merge_mass[k];
-
-            constexpr int type_index = DataTypeIndex<VariableType>::value;
-            for (size_t i = 0; i != std::get<type_index>(particle_data).size(); ++i)
-            {
-                VariableType particle_data_temp = ZeroData<VariableType>::value;
-                for (size_t k = 0; k != merge_indices.size(); ++k)
-                    particle_data_temp += merge_mass[k] * (*std::get<type_index>(particle_data)[i])[merge_indices[k]];
-
-                (*std::get<type_index>(particle_data)[i])[merged_index] = particle_data_temp / (total_mass + TinyReal);
-            }
-        };
-    };
     DataAssembleOperation<mergeParticleDataValue> merge_particle_value_;
 };
 
@@ -321,4 +326,54 @@ class MergeWithMinimumDensityErrorWithWall : public MergeWithMinimumDensityError
   protected:
     ComputeDensityErrorWithWall compute_density_error;
 };
+
+/**
+ * @class ParticleSplitAndMergeInParallel
+ * @brief Split and merge particles of a body in prescribed area in parallel.
+ * @details Particles outside the refinement region are merged in pairs and particles inside are split,
+ * with the same criteria as ParticleMergeWithPrescribedArea and ParticleSplitWithPrescribedArea.
+ * The merge candidates propose their nearest eligible neighbor as partner in parallel.
+ * The conflicts are resolved by accepting a pair only if it is the nearest pair for both particles,
+ * which gives a matching, i.e. the merged pairs do not overlap, and is repeated for the unmatched particles.
+ * The merged particles are removed, and the split particles are inserted, in bulk.
+ * Merging is carried out before splitting so that only the valid neighbor lists are used,
+ * and the cell linked list and configuration need to be updated afterwards as usual.
+ */
+class ParticleSplitAndMergeInParallel : public BaseDynamics<void>, public GeneralDataDelegateInner
+{
+  public:
+    ParticleSplitAndMergeInParallel(BaseInnerRelation &inner_relation, Shape &refinement_region, size_t body_buffer_width);
+    virtual ~ParticleSplitAndMergeInParallel(){};
+
+    virtual void exec(Real dt = 0.0) override;
+    /** return the number of merged pairs */
+    size_t mergeParticles();
+    /** return the number of split particles */
+    size_t splitParticles();
+
+  protected:
+    BoundingBox refinement_region_bounds_;
+    ParticleSplitAndMerge &particle_adaptation_;
+    Real inv_rho0_;
+    StdLargeVec<Real> &Vol_;
+    StdLargeVec<Vecd> &pos_;
+    StdLargeVec<Real> &mass_;
+    StdLargeVec<Real> &h_ratio_;
+    ParticleData &all_particle_data_;
+    size_t max_matching_rounds_;
+    StdLargeVec<size_t> partner_;      /**< matched partner, or the particle itself if not matched */
+    StdLargeVec<size_t> proposal_;     /**< proposed partner, or the particle itself if none */
+    StdLargeVec<size_t> best_partner_; /**< partner of the nearest pair proposed from or to the particle */
+    StdLargeVec<size_t> marks_, offsets_;
+    IndexVector holes_, fillers_;
+    DataAssembleOperation<mergeParticleDataValue> merge_particle_value_;
+
+    bool isInsideRefinementRegion(const Vecd &position, Real volume);
+    bool isMergeCandidate(size_t index_i);
+    bool isMergePartner(size_t index_i, size_t index_j);
+    bool isCloserPair(size_t index_i, size_t index_j, size_t index_k, size_t index_l);
+    size_t matchMergePairs();
+    void removeParticles(size_t number_of_removed_particles);
+    Vecd getSplittingPosition(size_t index_i);
+};
 } // namespace SPH
@@ -104,6 +104,107 @@ class InterpolatingAQuantity : public BaseInterpolation<DataType>
     virtual ~InterpolatingAQuantity(){};
 };
 
+/**
+ * @class InterpolatingAQuantityByStencil
+ * @brief Interpolate a given member data in the particles of a general body
+ * with the normalized interpolation weights cached in a stencil.
+ * @details The stencil is built from the contact configuration on the first execution,
+ * after which the interpolation is a weighted gathering only. It is suitable for bodies
+ * which are not moving relatively to each other, such as the electrophysiology and mechanics bodies
+ * of a muscle in the reference configuration, and needs to be rebuilt by markTopologyChanged()
+ * after the contact configuration is updated.
+ */
+template <typename DataType>
+class InterpolatingAQuantityByStencil : public BaseDynamics<void>, public InterpolationContactData
+{
+  public:
+    explicit InterpolatingAQuantityByStencil(BaseContactRelation &contact_relation,
+                                             const std::string &interpolated_variable, const std::string &target_variable)
+        : BaseDynamics<void>(contact_relation.getSPHBody()), InterpolationContactData(contact_relation),
+          interpolated_quantities_(*this->particles_->template getVariableByName<DataType>(interpolated_variable)),
+          is_stencil_built_(false)
+    {
+        for (size_t k = 0; k != this->contact_particles_.size(); ++k)
+        {
+            contact_Vol_.push_back(&(this->contact_particles_[k]->Vol_));
+            contact_data_.push_back(this->contact_particles_[k]->template getVariableByName<DataType>(target_variable));
+        }
+    };
+    virtual ~InterpolatingAQuantityByStencil(){};
+    void markTopologyChanged() { is_stencil_built_ = false; };
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        if (!is_stencil_built_)
+            buildStencil();
+
+        particle_for(par, stencil_sizes_.size(),
+                     [&](size_t index_i)
+                     {
+                         DataType interpolated_quantity = ZeroData<DataType>::value;
+                         for (size_t n = stencil_offsets_[index_i]; n != stencil_offsets_[index_i] + stencil_sizes_[index_i]; ++n)
+                         {
+                             interpolated_quantity += stencil_weights_[n] * (*contact_data_[stencil_bodies_[n]])[stencil_indexes_[n]];
+                         }
+                         interpolated_quantities_[index_i] = interpolated_quantity;
+                     });
+    };
+
+  protected:
+    StdLargeVec<DataType> &interpolated_quantities_;
+    StdVec<StdLargeVec<Real> *> contact_Vol_;
+    StdVec<StdLargeVec<DataType> *> contact_data_;
+    bool is_stencil_built_;
+    StdLargeVec<size_t> stencil_sizes_;
+    StdLargeVec<size_t> stencil_offsets_;
+    StdLargeVec<size_t> stencil_bodies_;
+    StdLargeVec<size_t> stencil_indexes_;
+    StdLargeVec<Real> stencil_weights_;
+
+    void buildStencil()
+    {
+        size_t total_real_particles = this->particles_->total_real_particles_;
+        stencil_sizes_.resize(total_real_particles);
+        stencil_offsets_.resize(total_real_particles);
+        particle_for(par, total_real_particles,
+                     [&](size_t index_i)
+                     {
+                         stencil_sizes_[index_i] = 0;
+                         for (size_t k = 0; k < this->contact_configuration_.size(); ++k)
+                             stencil_sizes_[index_i] += (*this->contact_configuration_[k])[index_i].current_size_;
+                     });
+        size_t stencil_entries = particle_scan(par, stencil_sizes_, stencil_offsets_);
+        stencil_bodies_.resize(stencil_entries);
+        stencil_indexes_.resize(stencil_entries);
+        stencil_weights_.resize(stencil_entries);
+
+        particle_for(par, total_real_particles,
+                     [&](size_t index_i)
+                     {
+                         size_t entry = stencil_offsets_[index_i];
+                         Real ttl_weight(0);
+                         for (size_t k = 0; k < this->contact_configuration_.size(); ++k)
+                         {
+                             StdLargeVec<Real> &Vol_k = *(contact_Vol_[k]);
+                             Neighborhood &contact_neighborhood = (*this->contact_configuration_[k])[index_i];
+                             for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+                             {
+                                 size_t index_j = contact_neighborhood.j_[n];
+                                 Real weight_j = contact_neighborhood.W_ij_[n] * Vol_k[index_j];
+                                 stencil_bodies_[entry] = k;
+                                 stencil_indexes_[entry] = index_j;
+                                 stencil_weights_[entry] = weight_j;
+                                 ttl_weight += weight_j;
+                                 ++entry;
+                             }
+                         }
+                         for (size_t n = stencil_offsets_[index_i]; n != entry; ++n)
+                             stencil_weights_[n] /= ttl_weight + TinyReal;
+                     });
+        is_stencil_built_ = true;
+    };
+};
+
 /**
  * @class ObservingAQuantity
  * @brief Observing a variable from contact bodies.
@@ -37,6 +37,27 @@ namespace SPH
 {
 using namespace execution;
 
+/**
+ * @class WorkloadBalancedRange
+ * @brief The loop range of all real particles of a body.
+ * 		  If the bounds of the chunks with balanced workload are given and up to date,
+ * 		  the parallel iterators take each chunk as a task instead of splitting the range evenly.
+ */
+class WorkloadBalancedRange
+{
+    size_t *total_real_particles_;
+    IndexVector chunk_bounds_; /**< the first particle of each chunk and the end of the range */
+
+  public:
+    WorkloadBalancedRange() : total_real_particles_(nullptr){};
+    void setTotalRealParticles(size_t &total_real_particles) { total_real_particles_ = &total_real_particles; };
+    size_t size() const { return *total_real_particles_; };
+    IndexVector &ChunkBounds() { return chunk_bounds_; };
+    const IndexVector &ChunkBounds() const { return chunk_bounds_; };
+    /** the chunks are outdated when the number of real particles has been changed */
+    bool isBalanced() const { return chunk_bounds_.size() > 1 && chunk_bounds_.back() == size(); };
+};
+
 template <class ExecutionPolicy, typename DynamicsRange, class LocalDynamicsFunction>
 void particle_for(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
                   const LocalDynamicsFunction &local_dynamics_function)
@@ -73,6 +94,36 @@ inline void particle_for(const ParallelPolicy &par, const size_t &all_real_parti
         },
         ap);
 };
+/**
+ * Body-wise iterators with workload balanced chunks (for sequential and parallel computing).
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const SequencedPolicy &seq, const WorkloadBalancedRange &balanced_range,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    particle_for(seq, balanced_range.size(), local_dynamics_function);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const WorkloadBalancedRange &balanced_range,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    if (!balanced_range.isBalanced())
+        return particle_for(par, balanced_range.size(), local_dynamics_function);
+
+    const IndexVector &chunk_bounds = balanced_range.ChunkBounds();
+    parallel_for(
+        IndexRange(0, chunk_bounds.size() - 1, 1),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+                for (size_t i = chunk_bounds[k]; i < chunk_bounds[k + 1]; ++i)
+                {
+                    local_dynamics_function(i);
+                }
+        },
+        tbb::simple_partitioner());
+};
 /**
  * Bodypart By Particle-wise iterators (for sequential and parallel computing).
  */
@@ -286,6 +337,40 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const size_t &all_r
             return operation(x, y);
         });
 };
+/**
+ * Body-wise reduce iterators with workload balanced chunks (for sequential and parallel computing).
+ */
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const SequencedPolicy &seq, const WorkloadBalancedRange &balanced_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return particle_reduce(seq, balanced_range.size(), temp, operation, local_dynamics_function);
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelPolicy &par, const WorkloadBalancedRange &balanced_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    if (!balanced_range.isBalanced())
+        return particle_reduce(par, balanced_range.size(), temp, operation, local_dynamics_function);
+
+    const IndexVector &chunk_bounds = balanced_range.ChunkBounds();
+    return parallel_reduce(
+        IndexRange(0, chunk_bounds.size() - 1, 1),
+        temp, [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+                for (size_t i = chunk_bounds[k]; i < chunk_bounds[k + 1]; ++i)
+                {
+                    temp0 = operation(temp0, local_dynamics_function(i));
+                }
+            return temp0; },
+        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
+        { return operation(x, y); },
+        tbb::simple_partitioner());
+};
 /**
  * BodypartByParticle-wise reduce iterators (for sequential and parallel computing).
  */
@@ -365,5 +450,67 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const ConcurrentCel
         [&](const ReturnType &x, const ReturnType &y) -> ReturnType
         { return operation(x, y); });
 }
+/**
+ * Exclusive prefix sum (for sequential and parallel computing).
+ * The output gives the offset of each entry and the total sum is returned.
+ * The output is enlarged to the size of the input if it is shorter,
+ * while a longer output, e.g. with the extra end offset of compressed rows, is kept.
+ * It is used for compacting particles marked concurrently into a contiguous list without locks.
+ */
+template <typename DataType>
+inline DataType particle_scan(const SequencedPolicy &seq, const StdLargeVec<DataType> &input,
+                              StdLargeVec<DataType> &output)
+{
+    if (output.size() < input.size())
+        output.resize(input.size());
+    DataType sum = DataType(0);
+    for (size_t i = 0; i != input.size(); ++i)
+    {
+        output[i] = sum;
+        sum += input[i];
+    }
+    return sum;
+}
+
+template <typename DataType>
+inline DataType particle_scan(const ParallelPolicy &par, const StdLargeVec<DataType> &input,
+                              StdLargeVec<DataType> &output)
+{
+    if (output.size() < input.size())
+        output.resize(input.size());
+    return parallel_scan(
+        IndexRange(0, input.size()), DataType(0),
+        [&](const IndexRange &r, DataType sum, bool is_final_scan) -> DataType
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                if (is_final_scan)
+                    output[i] = sum;
+                sum += input[i];
+            }
+            return sum;
+        },
+        [](const DataType &x, const DataType &y) -> DataType
+        { return x + y; });
+}
+
+/**
+ * Stream compaction (for sequential and parallel computing).
+ * The entries marked by one (others by zero) are gathered, in their original order, into the compacted list.
+ * The index function gives the value to be saved for a marked entry.
+ */
+template <class ExecutionPolicy, class IndexFunction>
+inline void particle_compact(const ExecutionPolicy &execution_policy, const StdLargeVec<size_t> &marks,
+                             StdLargeVec<size_t> &offsets, IndexVector &compacted,
+                             const IndexFunction &index_function)
+{
+    compacted.resize(particle_scan(execution_policy, marks, offsets));
+    particle_for(execution_policy, marks.size(),
+                 [&](size_t i)
+                 {
+                     if (marks[i] != 0)
+                         compacted[offsets[i]] = index_function(i);
+                 });
+}
 } // namespace SPH
 #endif // PARTICLE_ITERATORS_H
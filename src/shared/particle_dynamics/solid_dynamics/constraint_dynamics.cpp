@@ -123,5 +123,99 @@ void ConstrainSolidBodyMassCenter::update(size_t index_i, Real dt)
     vel_[index_i] -= velocity_correction_;
 }
 //=================================================================================================//
+SimBodyAsyncIntegration::
+    SimBodyAsyncIntegration(SimTK::MultibodySystem &MBsystem,
+                            SimTK::RungeKuttaMersonIntegrator &integ,
+                            StdVec<SimTK::MobilizedBody *> mobods)
+    : MBsystem_(MBsystem), integ_(integ), mobods_(mobods),
+      current_states_(mobods.size()), previous_states_(mobods.size()),
+      has_previous_states_(false), step_size_(0.0)
+{
+    recordRigidStates();
+    has_previous_states_ = false;
+}
+//=================================================================================================//
+SimBodyAsyncIntegration::~SimBodyAsyncIntegration()
+{
+    if (simbody_step_.valid())
+        simbody_step_.wait();
+}
+//=================================================================================================//
+void SimBodyAsyncIntegration::stepBy(Real dt)
+{
+    synchronize();
+    step_size_ = dt;
+    simbody_step_ = std::async(std::launch::async, [&, dt]()
+                               { integ_.stepBy(dt); });
+}
+//=================================================================================================//
+void SimBodyAsyncIntegration::synchronize()
+{
+    if (simbody_step_.valid())
+    {
+        simbody_step_.get();
+        recordRigidStates();
+    }
+}
+//=================================================================================================//
+size_t SimBodyAsyncIntegration::getMobodIndex(SimTK::MobilizedBody &mobod)
+{
+    for (size_t k = 0; k != mobods_.size(); ++k)
+        if (mobods_[k] == &mobod)
+            return k;
+
+    std::cout << "\n Error: the mobilized body is not integrated asynchronously!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+    return MaxSize_t;
+}
+//=================================================================================================//
+void SimBodyAsyncIntegration::recordRigidStates()
+{
+    const SimTK::State &simbody_state = integ_.getState();
+    MBsystem_.realize(simbody_state, SimTK::Stage::Velocity);
+    previous_states_.swap(current_states_);
+    for (size_t k = 0; k != mobods_.size(); ++k)
+    {
+        current_states_[k].time_ = simbody_state.getTime();
+        current_states_[k].transform_ = mobods_[k]->getBodyTransform(simbody_state);
+        current_states_[k].velocity_ = mobods_[k]->getBodyVelocity(simbody_state);
+    }
+    has_previous_states_ = true;
+}
+//=================================================================================================//
+void SimBodyAsyncIntegration::
+    getRigidState(size_t mobod_index, SimTK::Transform &transform, SimTK::SpatialVec &velocity)
+{
+    transform = current_states_[mobod_index].transform_;
+    velocity = current_states_[mobod_index].velocity_;
+}
+//=================================================================================================//
+void SimBodyAsyncIntegration::
+    predictRigidState(size_t mobod_index, SimTK::Transform &transform, SimTK::SpatialVec &velocity)
+{
+    const RigidState &current = current_states_[mobod_index];
+    const RigidState &previous = previous_states_[mobod_index];
+    /** the velocities are extrapolated linearly from the last two states */
+    velocity = current.velocity_;
+    if (has_previous_states_ && current.time_ - previous.time_ > Eps)
+    {
+        Real ratio = step_size_ / (current.time_ - previous.time_);
+        velocity[0] += (current.velocity_[0] - previous.velocity_[0]) * ratio;
+        velocity[1] += (current.velocity_[1] - previous.velocity_[1]) * ratio;
+    }
+    /** the transform is advanced with the mean velocities over the step */
+    SimTKVec3 angular_velocity = (current.velocity_[0] + velocity[0]) * 0.5;
+    SimTKVec3 linear_velocity = (current.velocity_[1] + velocity[1]) * 0.5;
+    transform = current.transform_;
+    transform.updP() = current.transform_.p() + linear_velocity * step_size_;
+    Real rotation_angle = angular_velocity.norm() * step_size_;
+    if (rotation_angle > Eps)
+    {
+        transform.updR() = SimTK::Rotation(rotation_angle, SimTK::UnitVec3(angular_velocity)) *
+                           current.transform_.R();
+    }
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
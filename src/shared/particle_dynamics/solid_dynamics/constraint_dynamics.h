@@ -39,6 +39,8 @@
 #include "solid_particles.h"
 #include "all_simbody.h"
 
+#include <future>
+
 namespace SPH
 {
 namespace solid_dynamics
@@ -340,6 +342,188 @@ class TotalForceForSimBody
 };
 using TotalForceOnBodyForSimBody = TotalForceForSimBody<SPHBody>;
 using TotalForceOnBodyPartForSimBody = TotalForceForSimBody<BodyPartByParticle>;
+
+/**
+ * @class TotalForcesForSimBody
+ * @brief Compute the forces acting on several body parts, each driven by a mobilized body,
+ * and apply them together as the discrete forces of the multibody system.
+ * The forces on each part are reduced with the given execution policy as by ReduceDynamics.
+ * Note that all body forces of the discrete forces are cleared before applying,
+ * so that all mobilized bodies subjected to the discrete forces should be included.
+ */
+template <class ExecutionPolicy = ParallelPolicy>
+class TotalForcesForSimBody : public BaseDynamics<void>
+{
+  public:
+    TotalForcesForSimBody(StdVec<BodyPartByParticle *> body_parts,
+                          StdVec<SimTK::MobilizedBody *> mobods,
+                          SimTK::MultibodySystem &MBsystem,
+                          SimTK::Force::DiscreteForces &force_on_bodies,
+                          SimTK::RungeKuttaMersonIntegrator &integ)
+        : BaseDynamics<void>(firstSPHBody(body_parts)),
+          body_parts_(body_parts), mobods_(mobods), MBsystem_(MBsystem),
+          force_on_bodies_(force_on_bodies), integ_(integ), total_forces_(body_parts.size())
+    {
+        if (body_parts_.size() != mobods_.size())
+        {
+            std::cout << "\n Error: the numbers of body parts and mobilized bodies are not the same!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+    virtual ~TotalForcesForSimBody(){};
+
+    StdVec<SimTK::SpatialVec> &TotalForces() { return total_forces_; };
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        const SimTK::State &simbody_state = integ_.getState();
+        MBsystem_.realize(simbody_state, SimTK::Stage::Acceleration);
+        for (size_t k = 0; k != mobods_.size(); ++k)
+        {
+            BaseParticles &particles = body_parts_[k]->getBaseParticles();
+            SimTKVec3 mobod_origin_location = mobods_[k]->getBodyOriginLocation(simbody_state);
+            total_forces_[k] = particle_reduce(
+                ExecutionPolicy(), body_parts_[k]->LoopRange(),
+                SimTK::SpatialVec(SimTKVec3(0), SimTKVec3(0)), ReduceSum<SimTK::SpatialVec>(),
+                [&](size_t index_i) -> SimTK::SpatialVec
+                {
+                    Vecd force = (particles.acc_[index_i] + particles.acc_prior_[index_i]) * particles.mass_[index_i];
+                    SimTKVec3 force_from_particle = EigenToSimTK(upgradeToVec3d(force));
+                    SimTKVec3 displacement = EigenToSimTK(upgradeToVec3d(particles.pos_[index_i])) - mobod_origin_location;
+                    return SimTK::SpatialVec(SimTK::cross(displacement, force_from_particle), force_from_particle);
+                });
+        }
+
+        SimTK::State &state_for_update = integ_.updAdvancedState();
+        force_on_bodies_.clearAllBodyForces(state_for_update);
+        for (size_t k = 0; k != mobods_.size(); ++k)
+        {
+            force_on_bodies_.setOneBodyForce(state_for_update, *mobods_[k], total_forces_[k]);
+        }
+    };
+
+  protected:
+    StdVec<BodyPartByParticle *> body_parts_;
+    StdVec<SimTK::MobilizedBody *> mobods_;
+    SimTK::MultibodySystem &MBsystem_;
+    SimTK::Force::DiscreteForces &force_on_bodies_;
+    SimTK::RungeKuttaMersonIntegrator &integ_;
+    StdVec<SimTK::SpatialVec> total_forces_;
+
+  private:
+    /** the body of the first part, which exits if no body part is given */
+    static SPHBody &firstSPHBody(StdVec<BodyPartByParticle *> &body_parts)
+    {
+        if (body_parts.empty())
+        {
+            std::cout << "\n Error: no body part is given for the forces on the mobilized bodies!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        return body_parts.front()->getSPHBody();
+    };
+};
+
+/**
+ * @class SimBodyAsyncIntegration
+ * @brief Integrate the multibody system asynchronously,
+ * so that the Simbody step overlaps with the SPH sub-steps not depending on it.
+ * @details The rigid states, i.e. transforms and spatial velocities, of the mobilized bodies
+ * are recorded after each step. While a step is running, the rigid motion at the end of the step
+ * is predicted from the last two recorded states. A typical acoustic sub-step is:
+ * apply the forces, stepBy(dt), impose the predicted motion, run the fluid dynamics
+ * not depending on the rigid motion, then synchronize() and impose the corrected motion.
+ * The Simbody integrator and states must not be accessed elsewhere before synchronize() returns.
+ */
+class SimBodyAsyncIntegration
+{
+  public:
+    SimBodyAsyncIntegration(SimTK::MultibodySystem &MBsystem,
+                            SimTK::RungeKuttaMersonIntegrator &integ,
+                            StdVec<SimTK::MobilizedBody *> mobods);
+    virtual ~SimBodyAsyncIntegration();
+
+    /** start a Simbody step with the forces already applied to the advanced state */
+    void stepBy(Real dt);
+    /** wait for the running step and record the rigid states */
+    void synchronize();
+    bool isStepping() { return simbody_step_.valid(); };
+    size_t getMobodIndex(SimTK::MobilizedBody &mobod);
+    /** the rigid state after the last synchronization */
+    void getRigidState(size_t mobod_index, SimTK::Transform &transform, SimTK::SpatialVec &velocity);
+    /** the rigid state predicted at the end of the running step */
+    void predictRigidState(size_t mobod_index, SimTK::Transform &transform, SimTK::SpatialVec &velocity);
+
+  protected:
+    struct RigidState
+    {
+        Real time_;
+        SimTK::Transform transform_;
+        SimTK::SpatialVec velocity_;
+    };
+
+    SimTK::MultibodySystem &MBsystem_;
+    SimTK::RungeKuttaMersonIntegrator &integ_;
+    StdVec<SimTK::MobilizedBody *> mobods_;
+    StdVec<RigidState> current_states_, previous_states_;
+    bool has_previous_states_;
+    Real step_size_;
+    std::future<void> simbody_step_;
+
+    void recordRigidStates();
+};
+
+/**
+ * @class AsyncConstraintBySimBody
+ * @brief Constrain by the motion computed from the asynchronous Simbody integration.
+ * The predicted motion is imposed while a Simbody step is running,
+ * otherwise the motion after the last synchronization.
+ */
+template <class DynamicsIdentifier>
+class AsyncConstraintBySimBody : public BaseMotionConstraint<DynamicsIdentifier>
+{
+  public:
+    AsyncConstraintBySimBody(DynamicsIdentifier &identifier,
+                             SimBodyAsyncIntegration &simbody_integration,
+                             SimTK::MobilizedBody &mobod)
+        : BaseMotionConstraint<DynamicsIdentifier>(identifier),
+          simbody_integration_(simbody_integration),
+          mobod_index_(simbody_integration.getMobodIndex(mobod))
+    {
+        simbody_integration_.getRigidState(mobod_index_, transform_, velocity_);
+        initial_mobod_origin_location_ = transform_.p();
+    };
+    virtual ~AsyncConstraintBySimBody(){};
+
+    virtual void setupDynamics(Real dt = 0.0) override
+    {
+        simbody_integration_.isStepping()
+            ? simbody_integration_.predictRigidState(mobod_index_, transform_, velocity_)
+            : simbody_integration_.getRigidState(mobod_index_, transform_, velocity_);
+    };
+
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        SimTKVec3 rr = EigenToSimTK(upgradeToVec3d(this->pos0_[index_i])) - initial_mobod_origin_location_;
+        SimTKVec3 r = transform_.R() * rr;
+        SimTKVec3 pos = transform_.p() + r;
+        SimTKVec3 vel = velocity_[1] + SimTK::cross(velocity_[0], r);
+        degradeToVecd(SimTKToEigen(pos), this->pos_[index_i]);
+        degradeToVecd(SimTKToEigen(vel), this->vel_[index_i]);
+        SimTKVec3 n = transform_.R() * EigenToSimTK(upgradeToVec3d(this->n0_[index_i]));
+        degradeToVecd(SimTKToEigen(n), this->n_[index_i]);
+    };
+
+  protected:
+    SimBodyAsyncIntegration &simbody_integration_;
+    size_t mobod_index_;
+    SimTK::Transform transform_;
+    SimTK::SpatialVec velocity_;
+    SimTKVec3 initial_mobod_origin_location_;
+};
+using AsyncConstraintBodyBySimBody = AsyncConstraintBySimBody<SPHBody>;
+using AsyncConstraintBodyPartBySimBody = AsyncConstraintBySimBody<BodyPartByParticle>;
 } // namespace solid_dynamics
 } // namespace SPH
 #endif // CONSTRAINT_DYNAMICS_H
\ No newline at end of file
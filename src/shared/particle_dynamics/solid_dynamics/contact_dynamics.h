@@ -350,7 +350,7 @@ class PairwiseFrictionFromWall : public LocalDynamics, public ContactWithWallDat
             for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
             {
                 size_t index_j = contact_neighborhood.j_[n];
-                Vecd &e_ij = contact_neighborhood.e_ij_[n];
+                const Vecd &e_ij = contact_neighborhood.e_ij_[n];
 
                 parameter_b[n] = eta_ * contact_neighborhood.dW_ijV_j_[n] * Vol_i * dt / contact_neighborhood.r_ij_[n];
 
@@ -364,7 +364,7 @@ class PairwiseFrictionFromWall : public LocalDynamics, public ContactWithWallDat
             for (size_t n = contact_neighborhood.current_size_; n != 0; --n)
             {
                 size_t index_j = contact_neighborhood.j_[n - 1];
-                Vecd &e_ij = contact_neighborhood.e_ij_[n];
+                const Vecd &e_ij = contact_neighborhood.e_ij_[n];
 
                 // only update particle i
                 Vecd vel_derivative = (vel_i - vel_k[index_j]);
@@ -290,6 +290,128 @@ class DecomposedIntegration1stHalf : public BaseIntegration1stHalf
     const Real correction_factor_ = 1.07;
 };
 
+/**
+ * @class PackedDeformationGradientBySummation
+ * @brief computing deformation gradient tensor by summation
+ * with the pre-multiplied kernel gradients packed by the total Lagrangian inner relation.
+ */
+class PackedDeformationGradientBySummation : public DeformationGradientBySummation
+{
+  public:
+    explicit PackedDeformationGradientBySummation(TotalLagrangianInnerRelation &inner_relation)
+        : DeformationGradientBySummation(inner_relation), packed_relation_(inner_relation){};
+    virtual ~PackedDeformationGradientBySummation(){};
+    virtual void setupDynamics(Real dt = 0.0) override
+    {
+        DeformationGradientBySummation::setupDynamics(dt);
+        packed_relation_.checkCorrectedGradientsPacked();
+    };
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        const StdLargeVec<size_t> &neighbor_offset = packed_relation_.neighbor_offset_;
+        const StdLargeVec<size_t> &packed_j = packed_relation_.j_;
+        const StdLargeVec<Vecd> &B_gradW_ijV_j = packed_relation_.B_gradW_ijV_j_;
+        const Vecd &pos_n_i = pos_[index_i];
+
+        Matd deformation = Matd::Zero();
+        for (size_t k = neighbor_offset[index_i]; k != neighbor_offset[index_i + 1]; ++k)
+        {
+            deformation -= (pos_n_i - pos_[packed_j[k]]) * B_gradW_ijV_j[k].transpose();
+        }
+
+        F_[index_i] = deformation;
+    };
+
+  protected:
+    TotalLagrangianInnerRelation &packed_relation_;
+};
+
+/**
+ * @class PackedIntegration1stHalf
+ * @brief the first step of stress relaxation with the neighbor data packed by the total Lagrangian inner relation.
+ * The template parameter gives the stress constitute relation, e.g. Integration1stHalfPK2.
+ */
+template <class Integration1stHalfType>
+class PackedIntegration1stHalf : public Integration1stHalfType
+{
+  public:
+    explicit PackedIntegration1stHalf(TotalLagrangianInnerRelation &inner_relation)
+        : Integration1stHalfType(inner_relation), packed_relation_(inner_relation){};
+    virtual ~PackedIntegration1stHalf(){};
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        const StdLargeVec<size_t> &neighbor_offset = packed_relation_.neighbor_offset_;
+        const StdLargeVec<size_t> &packed_j = packed_relation_.j_;
+        const StdLargeVec<Real> &W_ij = packed_relation_.W_ij_;
+        const StdLargeVec<Real> &r_ij = packed_relation_.r_ij_;
+        const StdLargeVec<Vecd> &gradW_ijV_j = packed_relation_.gradW_ijV_j_;
+
+        // including gravity and force from fluid
+        Vecd acceleration = Vecd::Zero();
+        for (size_t k = neighbor_offset[index_i]; k != neighbor_offset[index_i + 1]; ++k)
+        {
+            size_t index_j = packed_j[k];
+            Real dim_r_ij_1 = Dimensions / r_ij[k];
+            Vecd pos_jump = this->pos_[index_i] - this->pos_[index_j];
+            Vecd vel_jump = this->vel_[index_i] - this->vel_[index_j];
+            Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
+            Real weight = W_ij[k] * this->inv_W0_;
+            Matd numerical_stress_ij = 0.5 * (this->F_[index_i] + this->F_[index_j]) *
+                                       this->elastic_solid_.PairNumericalDamping(strain_rate, this->smoothing_length_);
+            acceleration += this->inv_rho0_ *
+                            (this->stress_PK1_B_[index_i] + this->stress_PK1_B_[index_j] +
+                             this->numerical_dissipation_factor_ * weight * numerical_stress_ij) *
+                            gradW_ijV_j[k];
+        }
+
+        this->acc_[index_i] = acceleration;
+    };
+
+  protected:
+    TotalLagrangianInnerRelation &packed_relation_;
+};
+
+/**
+ * @class PackedDecomposedIntegration1stHalf
+ * @brief the decomposed first step of stress relaxation
+ * with the neighbor data packed by the total Lagrangian inner relation.
+ */
+class PackedDecomposedIntegration1stHalf : public DecomposedIntegration1stHalf
+{
+  public:
+    explicit PackedDecomposedIntegration1stHalf(TotalLagrangianInnerRelation &inner_relation)
+        : DecomposedIntegration1stHalf(inner_relation), packed_relation_(inner_relation){};
+    virtual ~PackedDecomposedIntegration1stHalf(){};
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        const StdLargeVec<size_t> &neighbor_offset = packed_relation_.neighbor_offset_;
+        const StdLargeVec<size_t> &packed_j = packed_relation_.j_;
+        const StdLargeVec<Real> &dW_ijV_j = packed_relation_.dW_ijV_j_;
+        const StdLargeVec<Real> &r_ij = packed_relation_.r_ij_;
+        const StdLargeVec<Vecd> &gradW_ijV_j = packed_relation_.gradW_ijV_j_;
+        Real shear_factor = correction_factor_ * elastic_solid_.ShearModulus();
+
+        // including gravity and force from fluid
+        Vecd acceleration = Vecd::Zero();
+        for (size_t k = neighbor_offset[index_i]; k != neighbor_offset[index_i + 1]; ++k)
+        {
+            size_t index_j = packed_j[k];
+            Vecd shear_force_ij = shear_factor *
+                                  (J_to_minus_2_over_dimension_[index_i] + J_to_minus_2_over_dimension_[index_j]) *
+                                  (pos_[index_i] - pos_[index_j]) * dW_ijV_j[k] / r_ij[k];
+            acceleration += (stress_on_particle_[index_i] + stress_on_particle_[index_j]) * gradW_ijV_j[k] +
+                            shear_force_ij;
+        }
+        acc_[index_i] = acceleration * inv_rho0_;
+    };
+
+  protected:
+    TotalLagrangianInnerRelation &packed_relation_;
+};
+
 /**
  * @class Integration2ndHalf
  * @brief computing stress relaxation process by verlet time stepping
@@ -322,6 +444,43 @@ class Integration2ndHalf : public BaseElasticIntegration
 
     void update(size_t index_i, Real dt = 0.0);
 };
+
+/**
+ * @class PackedIntegration2ndHalf
+ * @brief the second step of stress relaxation
+ * with the pre-multiplied kernel gradients packed by the total Lagrangian inner relation.
+ */
+class PackedIntegration2ndHalf : public Integration2ndHalf
+{
+  public:
+    explicit PackedIntegration2ndHalf(TotalLagrangianInnerRelation &inner_relation)
+        : Integration2ndHalf(inner_relation), packed_relation_(inner_relation){};
+    virtual ~PackedIntegration2ndHalf(){};
+    virtual void setupDynamics(Real dt = 0.0) override
+    {
+        Integration2ndHalf::setupDynamics(dt);
+        packed_relation_.checkCorrectedGradientsPacked();
+    };
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        const StdLargeVec<size_t> &neighbor_offset = packed_relation_.neighbor_offset_;
+        const StdLargeVec<size_t> &packed_j = packed_relation_.j_;
+        const StdLargeVec<Vecd> &B_gradW_ijV_j = packed_relation_.B_gradW_ijV_j_;
+        const Vecd &vel_n_i = vel_[index_i];
+
+        Matd deformation_gradient_change_rate = Matd::Zero();
+        for (size_t k = neighbor_offset[index_i]; k != neighbor_offset[index_i + 1]; ++k)
+        {
+            deformation_gradient_change_rate -= (vel_n_i - vel_[packed_j[k]]) * B_gradW_ijV_j[k].transpose();
+        }
+
+        dF_dt_[index_i] = deformation_gradient_change_rate;
+    };
+
+  protected:
+    TotalLagrangianInnerRelation &packed_relation_;
+};
 } // namespace solid_dynamics
 } // namespace SPH
 #endif // ELASTIC_DYNAMICS_H
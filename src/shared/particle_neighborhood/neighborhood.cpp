@@ -19,15 +19,15 @@ void Neighborhood::removeANeighbor(size_t neighbor_n)
     W_ij_[neighbor_n] = W_ij_[current_size_];
     dW_ijV_j_[neighbor_n] = dW_ijV_j_[current_size_];
     r_ij_[neighbor_n] = r_ij_[current_size_];
-    e_ij_[neighbor_n] = e_ij_[current_size_];
+    e_ij_.assign(neighbor_n, e_ij_[current_size_]);
 }
 //=================================================================================================//
 void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                      const Vecd &displacement, size_t index_j, const Real &Vol_j)
 {
     neighborhood.j_.push_back(index_j);
-    neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-    neighborhood.dW_ijV_j_.push_back(kernel_->dW(distance, displacement) * Vol_j);
+    neighborhood.W_ij_.push_back(0.0);
+    neighborhood.dW_ijV_j_.push_back(Vol_j);
     neighborhood.r_ij_.push_back(distance);
     neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
     neighborhood.allocated_size_++;
@@ -38,10 +38,28 @@ void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real
 {
     size_t current_size = neighborhood.current_size_;
     neighborhood.j_[current_size] = index_j;
-    neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-    neighborhood.dW_ijV_j_[current_size] = kernel_->dW(distance, displacement) * Vol_j;
+    neighborhood.dW_ijV_j_[current_size] = Vol_j;
     neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+    neighborhood.e_ij_.assign(current_size, displacement / (distance + TinyReal));
+}
+//=================================================================================================//
+void NeighborBuilder::evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor)
+{
+    constexpr size_t block_size = 16;
+    Real r_ij[block_size], W_ij[block_size], dW_ij[block_size];
+    Vecd zero_vector = Vecd::Zero(); // only for choosing the dimension of the kernel functions
+    for (size_t block_begin = first_neighbor; block_begin < neighborhood.current_size_; block_begin += block_size)
+    {
+        size_t number_of_neighbors = SMIN(block_size, neighborhood.current_size_ - block_begin);
+        for (size_t k = 0; k != number_of_neighbors; ++k)
+            r_ij[k] = neighborhood.r_ij_[block_begin + k];
+        kernel_->WdW(number_of_neighbors, r_ij, W_ij, dW_ij, zero_vector);
+        for (size_t k = 0; k != number_of_neighbors; ++k)
+        {
+            neighborhood.W_ij_[block_begin + k] = W_ij[k];
+            neighborhood.dW_ijV_j_[block_begin + k] *= dW_ij[k];
+        }
+    }
 }
 //=================================================================================================//
 void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
@@ -68,7 +86,7 @@ void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real
                                            : 0.0;
     neighborhood.dW_ijV_j_[current_size] = kernel_->dW(h_ratio_min, distance, displacement) * Vol_j;
     neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+    neighborhood.e_ij_.assign(current_size, displacement / (distance + TinyReal));
 }
 //=================================================================================================//
 NeighborBuilderInner::NeighborBuilderInner(SPHBody &body) : NeighborBuilder()
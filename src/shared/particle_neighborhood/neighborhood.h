@@ -42,9 +42,33 @@ class SPHBody;
 class BodyPart;
 class SPHAdaptation;
 
+/**
+ * @class NeighborVectors
+ * @brief The vectors of a neighborhood stored in NeighborVecd and read as Vecd.
+ * @details In the mixed-precision build, the vectors are stored in float
+ * and converted when read, so that the interactions are computed in Real.
+ * Otherwise, a reference to the stored vector is given without conversion.
+ */
+class NeighborVectors
+{
+    StdLargeVec<NeighborVecd> data_;
+
+  public:
+    size_t size() const { return data_.size(); };
+    void resize(size_t new_size) { data_.resize(new_size); };
+    void push_back(const Vecd &vector) { data_.push_back(vector.cast<NeighborReal>()); };
+    void assign(size_t n, const Vecd &vector) { data_[n] = vector.cast<NeighborReal>(); };
+#if SPHINXSYS_USE_MIXED_PRECISION
+    Vecd operator[](size_t n) const { return data_[n].cast<Real>(); };
+#else
+    const Vecd &operator[](size_t n) const { return data_[n]; };
+#endif
+};
+
 /**
  * @class Neighborhood
  * @brief A neighborhood around particle i.
+ * @details The neighbor data are stored in NeighborReal, i.e. in float for the mixed-precision build.
  */
 class Neighborhood
 {
@@ -52,11 +76,11 @@ class Neighborhood
     size_t current_size_;   /**< the current number of neighbors */
     size_t allocated_size_; /**< the limit of neighbors does not require memory allocation  */
 
-    StdLargeVec<size_t> j_;      /**< index of the neighbor particle. */
-    StdLargeVec<Real> W_ij_;     /**< kernel value or particle volume contribution */
-    StdLargeVec<Real> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
-    StdLargeVec<Real> r_ij_;     /**< distance between j and i. */
-    StdLargeVec<Vecd> e_ij_;     /**< unit vector pointing from j to i or inter-particle surface direction */
+    StdLargeVec<size_t> j_;              /**< index of the neighbor particle. */
+    StdLargeVec<NeighborReal> W_ij_;     /**< kernel value or particle volume contribution */
+    StdLargeVec<NeighborReal> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
+    StdLargeVec<NeighborReal> r_ij_;     /**< distance between j and i. */
+    NeighborVectors e_ij_;               /**< unit vector pointing from j to i or inter-particle surface direction */
 
     Neighborhood() : current_size_(0), allocated_size_(0){};
     ~Neighborhood(){};
@@ -65,6 +89,75 @@ class Neighborhood
 };
 using ParticleConfiguration = StdLargeVec<Neighborhood>;
 
+/** 32-bit index of a neighbor particle used by the implicit neighbor storage */
+using NeighborIndex = uint32_t;
+
+/**
+ * @struct ImplicitNeighbor
+ * @brief The pair data of a neighbor recomputed from the particle positions.
+ */
+struct ImplicitNeighbor
+{
+    size_t j_;
+    Real W_ij_;
+    Real dW_ijV_j_;
+    Real r_ij_;
+    Vecd e_ij_;
+};
+
+/**
+ * @class ImplicitNeighborhood
+ * @brief A light-weight accessor to the neighbors of particle i stored only by their indices.
+ * @details The displacement, distance and kernel functions are recomputed
+ * from the current positions for each access, instead of being loaded from memory.
+ * With the generic kernel type, the kernel functions are evaluated by a virtual call.
+ */
+template <class KernelType>
+class ImplicitNeighborhood
+{
+  protected:
+    const NeighborIndex *j_;
+    const Vecd &pos_i_;
+    const StdLargeVec<Vecd> &pos_;
+    const StdLargeVec<Real> &Vol_;
+    const KernelType &kernel_;
+    Real cutoff_radius_sqr_;
+
+  public:
+    size_t current_size_;
+
+    ImplicitNeighborhood(const NeighborIndex *j, size_t current_size, const Vecd &pos_i,
+                         const StdLargeVec<Vecd> &pos, const StdLargeVec<Real> &Vol, const KernelType &kernel)
+        : j_(j), pos_i_(pos_i), pos_(pos), Vol_(Vol), kernel_(kernel),
+          cutoff_radius_sqr_(kernel.CutOffRadiusSqr()), current_size_(current_size){};
+
+    size_t j(size_t n) const { return j_[n]; };
+    ImplicitNeighbor operator[](size_t n) const
+    {
+        ImplicitNeighbor neighbor;
+        neighbor.j_ = j_[n];
+        Vecd displacement = pos_i_ - pos_[neighbor.j_];
+        Real distance_sqr = displacement.squaredNorm();
+        neighbor.r_ij_ = std::sqrt(distance_sqr);
+        neighbor.e_ij_ = displacement / (neighbor.r_ij_ + TinyReal);
+        Real dW_ij;
+        if constexpr (std::is_same<KernelType, Kernel>::value)
+        {
+            kernel_.WdW(neighbor.r_ij_, displacement, neighbor.W_ij_, dW_ij);
+        }
+        else
+        {
+            neighbor.W_ij_ = kernel_.template typedW<KernelType>(neighbor.r_ij_, displacement);
+            dW_ij = kernel_.template typeddW<KernelType>(neighbor.r_ij_, displacement);
+        }
+        /** the particles moved apart since the last update are not interacting */
+        bool is_within_cutoff = distance_sqr < cutoff_radius_sqr_;
+        neighbor.W_ij_ = is_within_cutoff ? neighbor.W_ij_ : 0.0;
+        neighbor.dW_ijV_j_ = is_within_cutoff ? dW_ij * Vol_[neighbor.j_] : 0.0;
+        return neighbor;
+    };
+};
+
 /**
  * @class NeighborBuilder
  * @brief Base class for building a neighbor particle j around particles i.
@@ -75,6 +168,8 @@ class NeighborBuilder
     Kernel *kernel_;
     //----------------------------------------------------------------------
     //	Below are for constant smoothing length.
+    //	The kernel values are evaluated later in blocks by evaluateKernel,
+    //	and the volume of particle j is kept in dW_ijV_j_ until then.
     //----------------------------------------------------------------------
     void createNeighbor(Neighborhood &neighborhood, const Real &distance,
                         const Vecd &displacement, size_t j_index, const Real &Vol_j);
@@ -87,10 +182,40 @@ class NeighborBuilder
                         const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min);
     void initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
                             const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min);
+    //----------------------------------------------------------------------
+    //	Below are for the kernel type known at compile time.
+    //----------------------------------------------------------------------
+    template <class KernelType>
+    void createNeighbor(const KernelType &kernel, Neighborhood &neighborhood, const Real &distance,
+                        const Vecd &displacement, size_t j_index, const Real &Vol_j)
+    {
+        neighborhood.j_.push_back(j_index);
+        neighborhood.W_ij_.push_back(kernel.template typedW<KernelType>(distance, displacement));
+        neighborhood.dW_ijV_j_.push_back(kernel.template typeddW<KernelType>(distance, displacement) * Vol_j);
+        neighborhood.r_ij_.push_back(distance);
+        neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+        neighborhood.allocated_size_++;
+    };
+    template <class KernelType>
+    void initializeNeighbor(const KernelType &kernel, Neighborhood &neighborhood, const Real &distance,
+                            const Vecd &displacement, size_t j_index, const Real &Vol_j)
+    {
+        size_t current_size = neighborhood.current_size_;
+        neighborhood.j_[current_size] = j_index;
+        neighborhood.W_ij_[current_size] = kernel.template typedW<KernelType>(distance, displacement);
+        neighborhood.dW_ijV_j_[current_size] = kernel.template typeddW<KernelType>(distance, displacement) * Vol_j;
+        neighborhood.r_ij_[current_size] = distance;
+        neighborhood.e_ij_.assign(current_size, displacement / (distance + TinyReal));
+    };
 
   public:
     NeighborBuilder() : kernel_(nullptr){};
     virtual ~NeighborBuilder(){};
+    Kernel &getKernel() { return *kernel_; };
+
+    /** Evaluate the kernel values of the neighbors created from first_neighbor on
+     * with the block evaluation of the kernel, after all neighbors of a particle are found. */
+    void evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor);
 };
 
 /**
@@ -105,6 +230,143 @@ class NeighborBuilderInner : public NeighborBuilder
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
+/**
+ * @class NeighborBuilderInnerTyped
+ * @brief A inner neighbor builder functor with the kernel type given at compile time.
+ * @details The kernel functions are evaluated without virtual calls for each pair.
+ * The kernel type of the body is checked once at construction.
+ */
+template <class KernelType>
+class NeighborBuilderInnerTyped : public NeighborBuilderInner
+{
+  protected:
+    KernelType &typed_kernel_;
+
+  public:
+    explicit NeighborBuilderInnerTyped(SPHBody &body)
+        : NeighborBuilderInner(body), typed_kernel_(DynamicCast<KernelType>(this, *kernel_)){};
+    virtual ~NeighborBuilderInnerTyped(){};
+    /** the kernel values are evaluated when the neighbors are created */
+    void evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        size_t index_j = std::get<0>(list_data_j);
+        Vecd displacement = pos_i - std::get<1>(list_data_j);
+        Real distance_metric = displacement.squaredNorm();
+        if (distance_metric < typed_kernel_.CutOffRadiusSqr() && index_i != index_j)
+        {
+            neighborhood.current_size_ >= neighborhood.allocated_size_
+                ? createNeighbor(typed_kernel_, neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j))
+                : initializeNeighbor(typed_kernel_, neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j));
+            neighborhood.current_size_++;
+        }
+    };
+};
+
+/**
+ * @class NeighborBuilderInnerStencil
+ * @brief A inner neighbor builder for a contiguous range of candidates given in structure of arrays,
+ * i.e. the cell data used by the stencil search of the cell linked list.
+ * @details The candidates are tested in blocks with a branch-free distance test, which the compiler vectorizes.
+ * The accepted candidates are compacted and written to the neighborhood in one pass,
+ * which is resized at most once for each block.
+ * With the generic kernel type, the kernel functions of a block are evaluated by one virtual call.
+ */
+template <class KernelType>
+class NeighborBuilderInnerStencil : public NeighborBuilder
+{
+  protected:
+    static constexpr size_t block_size_ = 16;
+    const KernelType &typed_kernel_;
+    Real cutoff_radius_sqr_;
+    Vecd zero_vector_; /**< only for choosing the dimension of the kernel functions */
+
+    void evaluateKernel(size_t number_of_neighbors, const Real *r_ij, Real *W_ij, Real *dW_ij) const
+    {
+        if constexpr (std::is_same<KernelType, Kernel>::value)
+        {
+            typed_kernel_.WdW(number_of_neighbors, r_ij, W_ij, dW_ij, zero_vector_);
+        }
+        else
+        {
+            for (size_t k = 0; k != number_of_neighbors; ++k)
+            {
+                W_ij[k] = typed_kernel_.template typedW<KernelType>(r_ij[k], zero_vector_);
+                dW_ij[k] = typed_kernel_.template typeddW<KernelType>(r_ij[k], zero_vector_);
+            }
+        }
+    };
+
+  public:
+    explicit NeighborBuilderInnerStencil(const KernelType &kernel)
+        : NeighborBuilder(), typed_kernel_(kernel), cutoff_radius_sqr_(kernel.CutOffRadiusSqr()),
+          zero_vector_(Vecd::Zero()){};
+    virtual ~NeighborBuilderInnerStencil(){};
+
+    void operator()(Neighborhood &neighborhood, const Vecd &pos_i, size_t index_i, size_t begin, size_t end,
+                    const size_t *index_j, const std::array<const Real *, Dimensions> &position_j,
+                    const Real *Vol_j) const
+    {
+        Real distance_sqr[block_size_];
+        size_t accepted[block_size_];
+        Real r_ij[block_size_], W_ij[block_size_], dW_ij[block_size_];
+        for (size_t block_begin = begin; block_begin < end; block_begin += block_size_)
+        {
+            size_t candidates = SMIN(block_size_, end - block_begin);
+            for (size_t k = 0; k != candidates; ++k)
+            {
+                Real sum = 0.0;
+                for (int d = 0; d != Dimensions; ++d)
+                {
+                    Real displacement = pos_i[d] - position_j[d][block_begin + k];
+                    sum += displacement * displacement;
+                }
+                distance_sqr[k] = sum;
+            }
+
+            size_t number_of_accepted = 0;
+            for (size_t k = 0; k != candidates; ++k)
+            {
+                accepted[number_of_accepted] = k;
+                number_of_accepted += (distance_sqr[k] < cutoff_radius_sqr_) & (index_j[block_begin + k] != index_i);
+            }
+            if (number_of_accepted == 0)
+                continue;
+
+            size_t current_size = neighborhood.current_size_;
+            size_t required_size = current_size + number_of_accepted;
+            if (required_size > neighborhood.allocated_size_)
+            {
+                neighborhood.j_.resize(required_size);
+                neighborhood.W_ij_.resize(required_size);
+                neighborhood.dW_ijV_j_.resize(required_size);
+                neighborhood.r_ij_.resize(required_size);
+                neighborhood.e_ij_.resize(required_size);
+                neighborhood.allocated_size_ = required_size;
+            }
+
+            for (size_t k = 0; k != number_of_accepted; ++k)
+                r_ij[k] = std::sqrt(distance_sqr[accepted[k]]);
+            evaluateKernel(number_of_accepted, r_ij, W_ij, dW_ij);
+
+            for (size_t k = 0; k != number_of_accepted; ++k)
+            {
+                size_t n = block_begin + accepted[k];
+                Vecd displacement = pos_i;
+                for (int d = 0; d != Dimensions; ++d)
+                    displacement[d] -= position_j[d][n];
+                neighborhood.j_[current_size + k] = index_j[n];
+                neighborhood.W_ij_[current_size + k] = W_ij[k];
+                neighborhood.dW_ijV_j_[current_size + k] = dW_ij[k] * Vol_j[n];
+                neighborhood.r_ij_[current_size + k] = r_ij[k];
+                neighborhood.e_ij_.assign(current_size + k, displacement / (r_ij[k] + TinyReal));
+            }
+            neighborhood.current_size_ = required_size;
+        }
+    };
+};
+
 /**
  * @class NeighborBuilderInnerAdaptive
  * @brief A inner neighbor builder functor when the particles have different smoothing lengths.
@@ -115,6 +377,8 @@ class NeighborBuilderInnerAdaptive : public NeighborBuilder
     explicit NeighborBuilderInnerAdaptive(SPHBody &body);
     void operator()(Neighborhood &neighborhood,
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
+    /** the kernel values are evaluated when the neighbors are created */
+    void evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor){};
 
   protected:
     StdLargeVec<Real> &h_ratio_;
@@ -149,6 +413,40 @@ class NeighborBuilderContact : public NeighborBuilder
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
+/**
+ * @class NeighborBuilderContactTyped
+ * @brief A contact neighbor builder functor with the kernel type given at compile time.
+ * @details As for NeighborBuilderInnerTyped, the kernel functions are evaluated without virtual calls.
+ * The type of the kernel chosen for the body pair is checked once at construction.
+ */
+template <class KernelType>
+class NeighborBuilderContactTyped : public NeighborBuilderContact
+{
+  protected:
+    KernelType &typed_kernel_;
+
+  public:
+    NeighborBuilderContactTyped(SPHBody &body, SPHBody &contact_body)
+        : NeighborBuilderContact(body, contact_body), typed_kernel_(DynamicCast<KernelType>(this, *kernel_)){};
+    virtual ~NeighborBuilderContactTyped(){};
+    /** the kernel values are evaluated when the neighbors are created */
+    void evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor){};
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        size_t index_j = std::get<0>(list_data_j);
+        Vecd displacement = pos_i - std::get<1>(list_data_j);
+        Real distance = displacement.norm();
+        if (distance < typed_kernel_.CutOffRadius())
+        {
+            neighborhood.current_size_ >= neighborhood.allocated_size_
+                ? createNeighbor(typed_kernel_, neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
+                : initializeNeighbor(typed_kernel_, neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
+            neighborhood.current_size_++;
+        }
+    };
+};
+
 /**
  * @class NeighborBuilderSurfaceContact
  * @brief A solid contact neighbor builder functor when bodies having surface contact.
@@ -190,6 +488,8 @@ class NeighborBuilderContactAdaptive : public NeighborBuilder
     virtual ~NeighborBuilderContactAdaptive(){};
     void operator()(Neighborhood &neighborhood,
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
+    /** the kernel values are evaluated when the neighbors are created */
+    void evaluateKernel(Neighborhood &neighborhood, size_t first_neighbor){};
 
   protected:
     SPHAdaptation &adaptation_, &contact_adaptation_;
@@ -16,7 +16,8 @@ BaseParticles::BaseParticles(SPHBody &sph_body, BaseMaterial *base_material)
       sph_body_(sph_body), body_name_(sph_body.getName()),
       base_material_(*base_material),
       restart_xml_engine_("xml_restart", "particles"),
-      reload_xml_engine_("xml_particle_reload", "particles")
+      reload_xml_engine_("xml_particle_reload", "particles"),
+      is_buffer_growable_(false), buffer_growth_factor_(2.0), buffer_shrink_ratio_(0.0)
 {
     //----------------------------------------------------------------------
     //		register geometric data only
@@ -113,6 +114,39 @@ size_t BaseParticles::insertAGhostParticle(size_t index)
     return expected_particle_index;
 }
 //=================================================================================================//
+size_t BaseParticles::addGhostParticles(size_t number_of_ghost_particles)
+{
+    size_t first_ghost_index = real_particles_bound_ + total_ghost_particles_;
+    total_ghost_particles_ += number_of_ghost_particles;
+    size_t expected_size = real_particles_bound_ + total_ghost_particles_;
+    /** The ghost range is reserved once instead of adding particle entries one by one. */
+    if (expected_size > pos_.size())
+    {
+        resize_particle_data_(all_particle_data_, expected_size);
+        for (size_t i = unsorted_id_.size(); i != expected_size; ++i)
+        {
+            unsorted_id_.push_back(i);
+            sorted_id_.push_back(i);
+            sequence_.push_back(0);
+        }
+    }
+    return first_ghost_index;
+}
+//=================================================================================================//
+size_t BaseParticles::insertGhostParticles(const IndexVector &source_indices)
+{
+    size_t first_ghost_index = addGhostParticles(source_indices.size());
+    particle_for(execution::par, source_indices.size(),
+                 [&](size_t k)
+                 {
+                     size_t ghost_index = first_ghost_index + k;
+                     copyFromAnotherParticle(ghost_index, source_indices[k]);
+                     /** For a ghost particle, its sorted id is that of corresponding particle. */
+                     sorted_id_[ghost_index] = source_indices[k];
+                 });
+    return first_ghost_index;
+}
+//=================================================================================================//
 void BaseParticles::switchToBufferParticle(size_t index)
 {
     size_t last_real_particle_index = total_real_particles_ - 1;
@@ -126,6 +160,175 @@ void BaseParticles::switchToBufferParticle(size_t index)
     total_real_particles_ -= 1;
 }
 //=================================================================================================//
+size_t BaseParticles::addRealParticles(size_t number_of_new_particles)
+{
+    size_t first_new_index = total_real_particles_;
+    size_t new_total_real_particles = total_real_particles_ + number_of_new_particles;
+    if (new_total_real_particles > real_particles_bound_)
+    {
+        /** The buffer is not resized here, as the cell linked list and the relations are still in use. */
+        std::cout << "\n Error: not enough buffer particles for " << body_name_ << "!" << std::endl;
+        if (is_buffer_growable_)
+            std::cout << "The particles added within one step exceed the headroom of the buffer growth factor." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    particle_for(execution::par, number_of_new_particles,
+                 [&](size_t k)
+                 {
+                     size_t new_index = first_new_index + k;
+                     sorted_id_[unsorted_id_[new_index]] = new_index;
+                 });
+    total_real_particles_ = new_total_real_particles;
+    return first_new_index;
+}
+//=================================================================================================//
+void BaseParticles::createRealParticlesFrom(const IndexVector &source_indices)
+{
+    /** All buffer particles are reserved at once, so that each copy goes to a distinct particle. */
+    size_t first_new_index = addRealParticles(source_indices.size());
+    particle_for(execution::par, source_indices.size(),
+                 [&](size_t k)
+                 { copyFromAnotherParticle(first_new_index + k, source_indices[k]); });
+}
+//=================================================================================================//
+void BaseParticles::switchToBufferParticles(const IndexVector &indices)
+{
+    size_t total_deleted = indices.size();
+    if (total_deleted == 0)
+        return;
+    size_t new_total_real_particles = total_real_particles_ - total_deleted;
+    /**
+     * The deleted particles located before new_total_real_particles leave holes,
+     * which are filled by the remaining particles located after it.
+     * Both lists have the same size and are obtained by parallel prefix sums.
+     */
+    bulk_marks_.resize(total_deleted);
+    particle_for(execution::par, total_deleted,
+                 [&](size_t k)
+                 { bulk_marks_[k] = indices[k] < new_total_real_particles ? 1 : 0; });
+    particle_compact(execution::par, bulk_marks_, bulk_offsets_, bulk_holes_,
+                     [&](size_t k)
+                     { return indices[k]; });
+
+    bulk_marks_.assign(total_deleted, 1);
+    particle_for(execution::par, total_deleted,
+                 [&](size_t k)
+                 {
+                     if (indices[k] >= new_total_real_particles)
+                         bulk_marks_[indices[k] - new_total_real_particles] = 0;
+                 });
+    particle_compact(execution::par, bulk_marks_, bulk_offsets_, bulk_movers_,
+                     [&](size_t k)
+                     { return new_total_real_particles + k; });
+
+    particle_for(execution::par, bulk_holes_.size(),
+                 [&](size_t k)
+                 {
+                     size_t hole = bulk_holes_[k];
+                     size_t mover = bulk_movers_[k];
+                     updateFromAnotherParticle(hole, mover);
+                     std::swap(unsorted_id_[hole], unsorted_id_[mover]);
+                     sorted_id_[unsorted_id_[hole]] = hole;
+                     sorted_id_[unsorted_id_[mover]] = mover;
+                 });
+    total_real_particles_ = new_total_real_particles;
+}
+//=================================================================================================//
+void BaseParticles::enableBufferGrowth(Real growth_factor, Real shrink_ratio)
+{
+    if (growth_factor <= 1.0 || shrink_ratio * growth_factor >= 1.0)
+    {
+        std::cout << "\n Error: the buffer growth factor should be larger than one, " << std::endl;
+        std::cout << "and the product with the shrink ratio should be less than one!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    is_buffer_growable_ = true;
+    buffer_growth_factor_ = growth_factor;
+    buffer_shrink_ratio_ = shrink_ratio;
+}
+//=================================================================================================//
+void BaseParticles::updateBufferCapacity()
+{
+    if (!is_buffer_growable_)
+        return;
+
+    Real required_bound = Real(total_real_particles_) * buffer_growth_factor_;
+    if (Real(real_particles_bound_) < required_bound)
+    {
+        size_t new_real_particles_bound = real_particles_bound_;
+        while (Real(new_real_particles_bound) < required_bound)
+            new_real_particles_bound = size_t(std::ceil(Real(new_real_particles_bound + 1) * buffer_growth_factor_));
+        resizeBufferParticles(new_real_particles_bound);
+    }
+    else if (Real(total_real_particles_) < buffer_shrink_ratio_ * Real(real_particles_bound_))
+    {
+        resizeBufferParticles(size_t(std::ceil(required_bound)));
+    }
+}
+//=================================================================================================//
+void BaseParticles::resizeBufferParticles(size_t new_real_particles_bound)
+{
+    size_t old_real_particles_bound = real_particles_bound_;
+    /** Ghost particles are created again after the cell linked list is updated. */
+    total_ghost_particles_ = 0;
+
+    if (new_real_particles_bound > old_real_particles_bound)
+    {
+        /** The extra particle entries are appended, so that the former ghost entries become buffer particles. */
+        size_t old_size = unsorted_id_.size();
+        size_t new_size = old_size + new_real_particles_bound - old_real_particles_bound;
+        resize_particle_data_(all_particle_data_, new_size);
+        for (size_t i = old_size; i != new_size; ++i)
+        {
+            unsorted_id_.push_back(i);
+            sorted_id_.push_back(i);
+            sequence_.push_back(0);
+        }
+    }
+    else
+    {
+        /** The unsorted ids of real particles are kept, so that they are not reassigned. */
+        size_t max_real_id = particle_reduce(
+            execution::par, total_real_particles_, size_t(0),
+            [](size_t x, size_t y) -> size_t
+            { return SMAX(x, y); },
+            [&](size_t i) -> size_t
+            { return unsorted_id_[i]; });
+        new_real_particles_bound = SMAX(new_real_particles_bound, max_real_id + 1);
+        if (new_real_particles_bound >= old_real_particles_bound)
+            return;
+
+        /** The buffer particles take the unsorted ids not used by the real particles. */
+        bulk_marks_.assign(new_real_particles_bound, 1);
+        particle_for(execution::par, total_real_particles_,
+                     [&](size_t i)
+                     { bulk_marks_[unsorted_id_[i]] = 0; });
+        particle_compact(execution::par, bulk_marks_, bulk_offsets_, bulk_holes_,
+                         [&](size_t k)
+                         { return k; });
+        particle_for(execution::par, bulk_holes_.size(),
+                     [&](size_t k)
+                     {
+                         size_t buffer_index = total_real_particles_ + k;
+                         unsorted_id_[buffer_index] = bulk_holes_[k];
+                         sorted_id_[bulk_holes_[k]] = buffer_index;
+                     });
+
+        resize_particle_data_(all_particle_data_, new_real_particles_bound);
+        unsorted_id_.resize(new_real_particles_bound);
+        sorted_id_.resize(new_real_particles_bound);
+        sequence_.resize(new_real_particles_bound);
+    }
+
+    real_particles_bound_ = new_real_particles_bound;
+    sph_body_.allocateConfigurationMemoriesForBufferParticles();
+    std::cout << "\n Buffer particles of " << body_name_ << " resized: "
+              << old_real_particles_bound << " -> " << real_particles_bound_
+              << " (real particles " << total_real_particles_ << ")." << std::endl;
+}
+//=================================================================================================//
 void BaseParticles::writePltFileHeader(std::ofstream &output_file)
 {
     output_file << " VARIABLES = \"x\",\"y\",\"z\",\"ID\"";
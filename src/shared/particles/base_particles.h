@@ -120,7 +120,30 @@ class BaseParticles
     void copyFromAnotherParticle(size_t index, size_t another_index);
     void updateFromAnotherParticle(size_t index, size_t another_index);
     size_t insertAGhostParticle(size_t index);
+    /** Bulk version of insertAGhostParticle, the index of the first ghost particle is returned. */
+    size_t insertGhostParticles(const IndexVector &source_indices);
+    /** Reserve the given number of ghost particles, whose data are to be assigned, the index of the first one is returned. */
+    size_t addGhostParticles(size_t number_of_ghost_particles);
     void switchToBufferParticle(size_t index);
+    /** Bulk and lock-free version of copying real particles into the buffer and realizing them. */
+    void createRealParticlesFrom(const IndexVector &source_indices);
+    /** Realize the given number of buffer particles, whose data are to be assigned, the index of the first one is returned. */
+    size_t addRealParticles(size_t number_of_new_particles);
+    /** Bulk and lock-free version of switchToBufferParticle, the indices should be unique. */
+    void switchToBufferParticles(const IndexVector &indices);
+    //----------------------------------------------------------------------
+    //		Capacity management of buffer particles
+    //----------------------------------------------------------------------
+    /** The capacity is kept at least the growth factor times of the real particles and, if the shrink ratio is positive,
+     * the buffer shrinks when the real particles occupy less than this ratio of the capacity.
+     * The particles added within one step should not exceed the headroom given by the growth factor. */
+    void enableBufferGrowth(Real growth_factor = 2.0, Real shrink_ratio = 0.0);
+    /** Grow or shrink the buffer if required. It is called before updating the cell linked list,
+     * which is the safe point as the cell lists, ghost particles and configurations are rebuilt afterwards. */
+    void updateBufferCapacity();
+    /** Resize the buffer, also the configurations of the body relations.
+     * It should be called only at a safe point, i.e. before updating the cell linked list. */
+    void resizeBufferParticles(size_t new_real_particles_bound);
     //----------------------------------------------------------------------
     //		Parameterized management on generalized particle data
     //----------------------------------------------------------------------
@@ -205,6 +228,13 @@ class BaseParticles
     ParticleVariables variables_to_restart_;
     ParticleVariables variables_to_reload_;
     StdVec<BaseDynamics<void> *> derived_variables_;
+    bool is_buffer_growable_;
+    Real buffer_growth_factor_;
+    Real buffer_shrink_ratio_;
+    StdLargeVec<size_t> bulk_marks_;   /**< marks for bulk particle creation and deletion */
+    StdLargeVec<size_t> bulk_offsets_; /**< offsets from the prefix sum of the marks */
+    IndexVector bulk_holes_;           /**< deleted particles to be filled by the movers */
+    IndexVector bulk_movers_;          /**< remaining real particles moved into the holes */
 
     void addAParticleEntry(); /**< Add a particle entry to the particle array. */
     virtual void writePltFileHeader(std::ofstream &output_file);
@@ -30,6 +30,7 @@
 #ifndef ALL_REGRESSION_TEST_METHODS_H
 #define ALL_REGRESSION_TEST_METHODS_H
 
+#include "binary_regression_test.hpp"
 #include "dynamic_time_warping_method.hpp"
 #include "ensemble_average_method.hpp"
 #include "regression_test_base.hpp"
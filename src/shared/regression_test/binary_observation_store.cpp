@@ -0,0 +1,214 @@
+#include "binary_observation_store.h"
+
+namespace SPH
+{
+//=================================================================================================//
+BinaryObservationWriter::BinaryObservationWriter(const std::string &filefullpath,
+                                                 size_t number_of_observations, size_t number_of_components)
+    : filefullpath_(filefullpath), number_of_observations_(number_of_observations),
+      number_of_components_(number_of_components)
+{
+    out_file_.open(filefullpath_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    out_file_.write(reinterpret_cast<const char *>(&number_of_observations_), sizeof(size_t));
+    out_file_.write(reinterpret_cast<const char *>(&number_of_components_), sizeof(size_t));
+}
+//=================================================================================================//
+void BinaryObservationWriter::appendRecord(Real time, const StdVec<Real> &values)
+{
+    if (values.size() + 1 != RecordSize())
+    {
+        std::cout << "\n Error: the record does not match the header of " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    out_file_.write(reinterpret_cast<const char *>(&time), sizeof(Real));
+    out_file_.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(Real));
+}
+//=================================================================================================//
+BinaryObservationReader::BinaryObservationReader(const std::string &filefullpath)
+    : filefullpath_(filefullpath), number_of_observations_(0), number_of_components_(0),
+      number_of_records_(0), header_size_(2 * sizeof(size_t))
+{
+    in_file_.open(filefullpath_.c_str(), std::ios::in | std::ios::binary);
+    if (!in_file_.is_open())
+    {
+        std::cout << "\n Error: the input file:" << filefullpath_ << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    in_file_.read(reinterpret_cast<char *>(&number_of_observations_), sizeof(size_t));
+    in_file_.read(reinterpret_cast<char *>(&number_of_components_), sizeof(size_t));
+    in_file_.seekg(0, std::ios::end);
+    std::streamoff file_size = in_file_.tellg();
+    /** an incomplete last record, e.g. from an interrupted run, is ignored */
+    number_of_records_ = (file_size - header_size_) / (RecordSize() * sizeof(Real));
+    rewind();
+}
+//=================================================================================================//
+bool BinaryObservationReader::readRecord(StdVec<Real> &record)
+{
+    record.resize(RecordSize());
+    in_file_.read(reinterpret_cast<char *>(record.data()), RecordSize() * sizeof(Real));
+    return in_file_.gcount() == std::streamsize(RecordSize() * sizeof(Real));
+}
+//=================================================================================================//
+void BinaryObservationReader::readRecord(size_t record_index, StdVec<Real> &record)
+{
+    in_file_.clear();
+    in_file_.seekg(header_size_ + std::streamoff(record_index * RecordSize() * sizeof(Real)));
+    readRecord(record);
+}
+//=================================================================================================//
+void BinaryObservationReader::rewind()
+{
+    in_file_.clear();
+    in_file_.seekg(header_size_);
+}
+//=================================================================================================//
+StdVec<Real> streamingDTWDistance(BinaryObservationReader &store_a, BinaryObservationReader &store_b, int window_size)
+{
+    if (store_a.NumberOfObservations() != store_b.NumberOfObservations() ||
+        store_a.NumberOfComponents() != store_b.NumberOfComponents())
+    {
+        std::cout << "\n Error: the two stores have different observations!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    size_t number_of_observations = store_a.NumberOfObservations();
+    size_t number_of_components = store_a.NumberOfComponents();
+    int a_length = store_a.NumberOfRecords();
+    int b_length = store_b.NumberOfRecords();
+    StdVec<Real> dtw_distance(number_of_observations, 0.0);
+    if (a_length == 0 || b_length == 0)
+        return dtw_distance;
+
+    /** the band of row index_i is [index_i - window_size, index_i + window_size],
+     * the entry of column index_j is located at index_j - index_i + window_size. */
+    window_size = SMAX(window_size, ABS(a_length - b_length));
+    int band_width = 2 * window_size + 1;
+    BiVector<Real> previous_row(number_of_observations, StdVec<Real>(band_width, Infinity));
+    BiVector<Real> current_row(number_of_observations, StdVec<Real>(band_width, Infinity));
+    BiVector<Real> b_records(band_width); /* the records of store b within the band, stored cyclically. */
+    StdVec<Real> a_record;
+    int number_of_b_records = 0;
+
+    store_a.rewind();
+    store_b.rewind();
+    for (int index_i = 0; index_i != a_length; ++index_i)
+    {
+        store_a.readRecord(a_record);
+        int lower_bound = SMAX(0, index_i - window_size);
+        int upper_bound = SMIN(b_length - 1, index_i + window_size);
+        for (; number_of_b_records <= upper_bound; ++number_of_b_records)
+            store_b.readRecord(b_records[number_of_b_records % band_width]);
+
+        for (size_t observation_index = 0; observation_index != number_of_observations; ++observation_index)
+        {
+            StdVec<Real> &previous = previous_row[observation_index];
+            StdVec<Real> &current = current_row[observation_index];
+            std::fill(current.begin(), current.end(), Infinity);
+            size_t offset = 1 + observation_index * number_of_components;
+            for (int index_j = lower_bound; index_j <= upper_bound; ++index_j)
+            {
+                int k = index_j - index_i + window_size;
+                StdVec<Real> &b_record = b_records[index_j % band_width];
+                Real squared_norm = 0.0;
+                for (size_t c = 0; c != number_of_components; ++c)
+                    squared_norm += pow(a_record[offset + c] - b_record[offset + c], 2);
+
+                Real previous_distance = 0.0;
+                if (index_i != 0 || index_j != 0)
+                {
+                    Real left = k > 0 ? current[k - 1] : Infinity;
+                    Real up = k + 1 < band_width ? previous[k + 1] : Infinity;
+                    previous_distance = SMIN(previous[k], left, up);
+                }
+                current[k] = sqrt(squared_norm) + previous_distance;
+            }
+        }
+        std::swap(previous_row, current_row);
+    }
+
+    int k_end = (b_length - 1) - (a_length - 1) + window_size;
+    for (size_t observation_index = 0; observation_index != number_of_observations; ++observation_index)
+        dtw_distance[observation_index] = previous_row[observation_index][k_end];
+    return dtw_distance;
+}
+//=================================================================================================//
+void streamingTimeAverage(BinaryObservationReader &store, Real start_time, StdVec<Real> &meanvalue, StdVec<Real> &variance)
+{
+    size_t number_of_values = store.RecordSize() - 1;
+    meanvalue.assign(number_of_values, 0.0);
+    variance.assign(number_of_values, 0.0);
+
+    /** Welford's update, in which variance accumulates the sum of squared deviations. */
+    size_t count = 0;
+    StdVec<Real> record;
+    store.rewind();
+    while (store.readRecord(record))
+    {
+        if (record[0] < start_time)
+            continue;
+        ++count;
+        for (size_t k = 0; k != number_of_values; ++k)
+        {
+            Real deviation = record[k + 1] - meanvalue[k];
+            meanvalue[k] += deviation / Real(count);
+            variance[k] += deviation * (record[k + 1] - meanvalue[k]);
+        }
+    }
+
+    if (count != 0)
+        for (size_t k = 0; k != number_of_values; ++k)
+            variance[k] /= Real(count);
+}
+//=================================================================================================//
+void streamingEnsembleAverage(StdVec<BinaryObservationReader *> stores,
+                              BinaryObservationWriter &meanvalue, BinaryObservationWriter &variance)
+{
+    if (stores.empty())
+        return;
+
+    size_t record_size = stores[0]->RecordSize();
+    size_t number_of_records = stores[0]->NumberOfRecords();
+    for (BinaryObservationReader *store : stores)
+    {
+        if (store->RecordSize() != record_size || meanvalue.RecordSize() != record_size ||
+            variance.RecordSize() != record_size)
+        {
+            std::cout << "\n Error: the stores have different observations!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        number_of_records = SMIN(number_of_records, store->NumberOfRecords());
+        store->rewind();
+    }
+
+    Real number_of_stores = Real(stores.size());
+    BiVector<Real> records(stores.size());
+    StdVec<Real> local_meanvalue(record_size - 1);
+    StdVec<Real> local_variance(record_size - 1);
+    for (size_t record_index = 0; record_index != number_of_records; ++record_index)
+    {
+        for (size_t n = 0; n != stores.size(); ++n)
+            stores[n]->readRecord(records[n]);
+
+        for (size_t k = 0; k != record_size - 1; ++k)
+        {
+            Real sum = 0.0;
+            for (size_t n = 0; n != stores.size(); ++n)
+                sum += records[n][k + 1];
+            local_meanvalue[k] = sum / number_of_stores;
+
+            Real squared_sum = 0.0;
+            for (size_t n = 0; n != stores.size(); ++n)
+                squared_sum += pow(records[n][k + 1] - local_meanvalue[k], 2);
+            local_variance[k] = squared_sum / number_of_stores;
+        }
+        meanvalue.appendRecord(records[0][0], local_meanvalue);
+        variance.appendRecord(records[0][0], local_variance);
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,128 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	binary_observation_store.h
+ * @brief 	Append-only binary store for observed and reduced quantities
+ *        	and the out-of-core comparisons used by the regression tests.
+ * @details The file layout is the same as the binary output of ObservedQuantityStreaming.
+ *        	The header gives the numbers of observations and components for each observation,
+ *        	and each record, i.e. snapshot, gives the time and the values in Real.
+ *        	Since the records have fixed size, the store is appended during the run
+ *        	and the comparisons sweep the records sequentially, so that only a few records are kept in memory.
+ * @author	Bo Zhang , Chi Zhang and Xiangyu Hu
+ */
+
+#pragma once
+
+#include "base_data_package.h"
+
+#include <fstream>
+
+namespace SPH
+{
+/** the number of Real components and the flattened components of a variable */
+inline size_t numberOfComponents(const Real &variable) { return 1; };
+template <typename EigenType>
+size_t numberOfComponents(const EigenType &variable) { return variable.size(); };
+inline void appendComponents(StdVec<Real> &record, const Real &variable) { record.push_back(variable); };
+template <typename EigenType>
+void appendComponents(StdVec<Real> &record, const EigenType &variable)
+{
+    for (int k = 0; k != variable.size(); ++k)
+        record.push_back(variable.data()[k]);
+};
+
+/**
+ * @class BinaryObservationWriter
+ * @brief Append records to a binary observation store.
+ */
+class BinaryObservationWriter
+{
+  protected:
+    std::string filefullpath_;
+    size_t number_of_observations_;
+    size_t number_of_components_;
+    std::ofstream out_file_;
+
+  public:
+    BinaryObservationWriter(const std::string &filefullpath, size_t number_of_observations, size_t number_of_components);
+    virtual ~BinaryObservationWriter() { out_file_.close(); };
+
+    size_t RecordSize() { return 1 + number_of_observations_ * number_of_components_; };
+    /** the record gives the values of all observations with their components flattened */
+    void appendRecord(Real time, const StdVec<Real> &values);
+    void close() { out_file_.close(); };
+};
+
+/**
+ * @class BinaryObservationReader
+ * @brief Read the records of a binary observation store one by one.
+ */
+class BinaryObservationReader
+{
+  protected:
+    std::string filefullpath_;
+    std::ifstream in_file_;
+    size_t number_of_observations_;
+    size_t number_of_components_;
+    size_t number_of_records_;
+    std::streamoff header_size_;
+
+  public:
+    explicit BinaryObservationReader(const std::string &filefullpath);
+    virtual ~BinaryObservationReader() { in_file_.close(); };
+
+    size_t NumberOfObservations() { return number_of_observations_; };
+    size_t NumberOfComponents() { return number_of_components_; };
+    size_t NumberOfRecords() { return number_of_records_; };
+    size_t RecordSize() { return 1 + number_of_observations_ * number_of_components_; };
+    /** read the next record, in which the first entry is the time */
+    bool readRecord(StdVec<Real> &record);
+    /** read the record with the given index */
+    void readRecord(size_t record_index, StdVec<Real> &record);
+    void rewind();
+};
+
+/**
+ * @brief Locally constrained dynamic time warping distance for each observation between two stores.
+ * @details Each store is read only once. The warping path is restricted to a band of
+ * 			the given window size around the diagonal, which is enlarged to the difference of the record numbers.
+ * 			Only the records of the second store within the band and two rows of the band are kept,
+ * 			so that the memory is proportional to the number of observations times the window size.
+ */
+StdVec<Real> streamingDTWDistance(BinaryObservationReader &store_a, BinaryObservationReader &store_b, int window_size = 5);
+
+/**
+ * @brief Time-averaged mean value and variance of each observation component
+ * 		  for the records not earlier than the given time, computed in one sweep.
+ */
+void streamingTimeAverage(BinaryObservationReader &store, Real start_time, StdVec<Real> &meanvalue, StdVec<Real> &variance);
+
+/**
+ * @brief Ensemble-averaged mean value and variance over the stores at each record.
+ * @details The stores are swept simultaneously until the shortest ends.
+ * 			The mean value and variance are appended to the given stores record by record.
+ */
+void streamingEnsembleAverage(StdVec<BinaryObservationReader *> stores,
+                              BinaryObservationWriter &meanvalue, BinaryObservationWriter &variance);
+} // namespace SPH
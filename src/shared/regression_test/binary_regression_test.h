@@ -0,0 +1,128 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	binary_regression_test.h
+ * @brief 	Regression test based on the binary observation store.
+ * @details Different from RegressionTestBase, the snapshots are not kept in xml memory,
+ *        	but appended to a binary store during the run.
+ *        	The dynamic time warping, time-averaged and ensemble-averaged comparisons
+ *        	are carried out by sweeping the stores, so that the memory scales with the number of observations only.
+ *        	The stores are independent of the xml data base of the other regression tests.
+ * @author	Bo Zhang , Chi Zhang and Xiangyu Hu
+ */
+
+#pragma once
+
+#include "all_physical_dynamics.h"
+#include "binary_observation_store.h"
+#include "io_all.h"
+
+namespace SPH
+{
+/**
+ * @class RegressionTestBinaryStore
+ * @brief Regression test with the observed or reduced quantity streamed into a binary store.
+ */
+template <class ObserveMethodType>
+class RegressionTestBinaryStore : public ObserveMethodType
+{
+    /*identify the variable type from the parent class. */
+    using VariableType = decltype(ObserveMethodType::type_indicator_);
+
+  protected:
+    std::string input_folder_path_;          /*< the folder path for the input folder. (folder) */
+    std::string current_run_filefullpath_;   /*< the file path for the store of current run. (.bin) */
+    std::string runtimes_filefullpath_;      /*< the file path for run times information. (.dat) */
+    std::string dtw_distance_filefullpath_;  /*< the file path for DTW distance. (.bin) */
+    std::string mean_variance_filefullpath_; /*< the file path for time-averaged mean and variance. (.bin) */
+    std::string converged;                   /*< the tag for result converged, default false. */
+    int number_of_run_;                      /*< the times of run. */
+    int label_for_repeat_;                   /*< the label used stable convergence (several convergence). */
+
+    UniquePtr<BinaryObservationWriter> current_run_store_;
+    StdVec<Real> record_;
+
+    std::string runFileFullPath(int index_of_run)
+    {
+        return input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ +
+               "_Run_" + std::to_string(index_of_run) + "_result.bin";
+    };
+    void appendToStore(ObservedQuantityRecording<VariableType> *observe_method);
+    template <typename ReduceType>
+    void appendToStore(ReducedQuantityRecording<ReduceType> *reduce_method);
+    /** close the store of current run, which must have been recorded. */
+    void closeCurrentRun();
+    /** close the store of current run and archive it as the result of this run. */
+    void archiveCurrentRun();
+    /** read and write the values saved as records of a store */
+    BiVector<Real> readRecordsFromStore(const std::string &filefullpath);
+    void writeRecordsToStore(const std::string &filefullpath, size_t number_of_observations, const BiVector<Real> &records);
+    /** update the convergence label with the number of not converged values */
+    bool updateConvergence(int count_not_converged, const std::string &method_name);
+
+  public:
+    template <typename... ConstructorArgs>
+    explicit RegressionTestBinaryStore(ConstructorArgs &&...args) : ObserveMethodType(std::forward<ConstructorArgs>(args)...)
+    {
+        input_folder_path_ = this->io_environment_.input_folder_;
+        std::string file_name = this->dynamics_identifier_name_ + "_" + this->quantity_name_;
+        current_run_filefullpath_ = this->io_environment_.output_folder_ + "/" + file_name + "_current_run.bin";
+        runtimes_filefullpath_ = input_folder_path_ + "/" + file_name + "_binary_runtimes.dat";
+        dtw_distance_filefullpath_ = input_folder_path_ + "/" + file_name + "_dtwdistance.bin";
+        mean_variance_filefullpath_ = input_folder_path_ + "/" + file_name + "_time_averaged_mean_variance.bin";
+
+        if (!fs::exists(runtimes_filefullpath_))
+        {
+            converged = "false";
+            number_of_run_ = 1;
+            label_for_repeat_ = 0;
+        }
+        else
+        {
+            std::ifstream in_file(runtimes_filefullpath_.c_str());
+            in_file >> converged;
+            in_file >> number_of_run_;
+            in_file >> label_for_repeat_;
+            in_file.close();
+        };
+    };
+    virtual ~RegressionTestBinaryStore();
+
+    /** the interface to write observed quantity into the binary store. */
+    void writeToFile(size_t iteration = 0) override
+    {
+        ObserveMethodType::writeToFile(iteration); /* used for visualization (.dat)*/
+        appendToStore(this);                       /* used for regression test. (.bin) */
+    };
+
+    /** the interfaces for generating the priori converged result and testing new result with DTW. */
+    void generateDataBaseByDTW(Real threshold_value, int window_size = 5);
+    void testResultByDTW(int window_size = 5);
+    /** the interfaces for generating the priori converged result and testing new result
+     * with the time-averaged meanvalue and variance from the given steady starting time. */
+    void generateDataBaseByTimeAverage(Real threshold_mean, Real threshold_variance, Real start_time = 0.0);
+    void testResultByTimeAverage(Real start_time = 0.0);
+    /** write the ensemble-averaged meanvalue and variance of all preserved runs into the output folder. */
+    void writeEnsembleAverage();
+};
+} // namespace SPH
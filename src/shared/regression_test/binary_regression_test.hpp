@@ -0,0 +1,298 @@
+/**
+ * @file 	binary_regression_test.hpp
+ * @author	Bo Zhang , Chi Zhang and Xiangyu Hu
+ */
+
+#pragma once
+
+#include "binary_regression_test.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::appendToStore(ObservedQuantityRecording<VariableType> *observe_method)
+{
+    size_t number_of_observations = this->base_particles_.total_real_particles_;
+    if (current_run_store_ == nullptr)
+        current_run_store_ = makeUnique<BinaryObservationWriter>(current_run_filefullpath_, number_of_observations,
+                                                                 numberOfComponents(ZeroData<VariableType>::value));
+    StdLargeVec<VariableType> &observed_quantity = *this->getObservedQuantity();
+    record_.clear();
+    for (size_t i = 0; i != number_of_observations; ++i)
+        appendComponents(record_, observed_quantity[i]);
+    current_run_store_->appendRecord(GlobalStaticVariables::physical_time_, record_);
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+template <typename ReduceType>
+void RegressionTestBinaryStore<ObserveMethodType>::appendToStore(ReducedQuantityRecording<ReduceType> *reduce_method)
+{
+    VariableType reduced_quantity = this->getReducedQuantity(); /* reduced by writeToFile already. */
+    if (current_run_store_ == nullptr)
+        current_run_store_ = makeUnique<BinaryObservationWriter>(current_run_filefullpath_, 1,
+                                                                 numberOfComponents(reduced_quantity));
+    record_.clear();
+    appendComponents(record_, reduced_quantity);
+    current_run_store_->appendRecord(GlobalStaticVariables::physical_time_, record_);
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::closeCurrentRun()
+{
+    if (current_run_store_ == nullptr)
+    {
+        std::cout << "\n Error: no result of " << this->quantity_name_ << " has been recorded in current run!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    current_run_store_->close();
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::archiveCurrentRun()
+{
+    closeCurrentRun();
+    fs::copy_file(current_run_filefullpath_, runFileFullPath(number_of_run_ - 1), fs::copy_options::overwrite_existing);
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+BiVector<Real> RegressionTestBinaryStore<ObserveMethodType>::readRecordsFromStore(const std::string &filefullpath)
+{
+    BinaryObservationReader store(filefullpath);
+    BiVector<Real> records(store.NumberOfRecords());
+    for (size_t n = 0; n != records.size(); ++n)
+    {
+        store.readRecord(records[n]);
+        records[n].erase(records[n].begin()); /* remove the time. */
+    }
+    return records;
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::
+    writeRecordsToStore(const std::string &filefullpath, size_t number_of_observations, const BiVector<Real> &records)
+{
+    BinaryObservationWriter store(filefullpath, number_of_observations, records[0].size() / number_of_observations);
+    for (size_t n = 0; n != records.size(); ++n)
+        store.appendRecord(Real(n), records[n]);
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+bool RegressionTestBinaryStore<ObserveMethodType>::updateConvergence(int count_not_converged, const std::string &method_name)
+{
+    if (count_not_converged == 0)
+    {
+        if (label_for_repeat_ == 4)
+        {
+            converged = "true";
+            std::cout << "The " << method_name << " of " << this->quantity_name_ << " are converged enough times, and run will stop now." << std::endl;
+            return true;
+        }
+        converged = "false";
+        label_for_repeat_++;
+        std::cout << "The " << method_name << " of " << this->quantity_name_ << " are converged, and this is the " << label_for_repeat_
+                  << " times. They should be converged more times to be stable." << std::endl;
+        return false;
+    }
+    converged = "false";
+    label_for_repeat_ = 0;
+    std::cout << "The " << method_name << " of " << this->quantity_name_ << " are not converged " << count_not_converged << " times." << std::endl;
+    return false;
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::generateDataBaseByDTW(Real threshold_value, int window_size)
+{
+    if (converged == "true")
+    {
+        std::cout << "The results have been converged." << std::endl;
+        return;
+    }
+    archiveCurrentRun();
+    BinaryObservationReader current_run(current_run_filefullpath_);
+    size_t number_of_observations = current_run.NumberOfObservations();
+
+    StdVec<Real> dtw_distance(number_of_observations, 0.0);
+    if (number_of_run_ > 1)
+        dtw_distance = readRecordsFromStore(dtw_distance_filefullpath_)[0];
+    StdVec<Real> dtw_distance_new = dtw_distance;
+
+    /* loop all existed result to get maximum dtw distance. */
+    for (int n = 0; n != (number_of_run_ - 1); ++n)
+    {
+        BinaryObservationReader previous_run(runFileFullPath(n));
+        StdVec<Real> dtw_distance_local = streamingDTWDistance(current_run, previous_run, window_size);
+        for (size_t i = 0; i != number_of_observations; ++i)
+            dtw_distance_new[i] = SMAX(dtw_distance_local[i], dtw_distance_new[i]);
+    }
+    writeRecordsToStore(dtw_distance_filefullpath_, number_of_observations, BiVector<Real>(1, dtw_distance_new));
+
+    if (number_of_run_ > 1)
+    {
+        int count_not_converged = 0;
+        for (size_t i = 0; i != number_of_observations; ++i)
+            if (std::abs(dtw_distance[i] - dtw_distance_new[i]) > threshold_value)
+            {
+                count_not_converged++;
+                std::cout << "The DTW distance of " << this->quantity_name_ << " [" << i << "] is not converged." << std::endl;
+                std::cout << "The old DTW distance is " << dtw_distance[i] << ", and the new DTW distance is " << dtw_distance_new[i] << "." << std::endl;
+            }
+        updateConvergence(count_not_converged, "DTW distance");
+    }
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::testResultByDTW(int window_size)
+{
+    closeCurrentRun();
+    BinaryObservationReader current_run(current_run_filefullpath_);
+    size_t number_of_observations = current_run.NumberOfObservations();
+    StdVec<Real> dtw_distance = readRecordsFromStore(dtw_distance_filefullpath_)[0];
+    for (int n = 0; n != number_of_run_; ++n)
+    {
+        if (!fs::exists(runFileFullPath(n)))
+        {
+            std::cout << "This result has not been preserved and will not be compared." << std::endl;
+            continue;
+        }
+        BinaryObservationReader previous_run(runFileFullPath(n));
+        StdVec<Real> dtw_distance_current = streamingDTWDistance(previous_run, current_run, window_size);
+        int test_wrong = 0;
+        for (size_t i = 0; i != number_of_observations; ++i)
+            if (dtw_distance_current[i] > 1.01 * dtw_distance[i])
+            {
+                std::cout << "The maximum distance of " << this->quantity_name_ << "[" << i << "] is " << dtw_distance[i]
+                          << ", and the current distance is " << dtw_distance_current[i] << "." << std::endl;
+                test_wrong++;
+            }
+        if (test_wrong != 0)
+        {
+            std::cout << "The DTW distance of " << this->quantity_name_ << " between current result and this previous local result is beyond exception!" << std::endl;
+            std::cout << "Please try again. If it still post this sentence, the result is not correct!" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "The result of " << this->quantity_name_
+              << " is correct based on the dynamic time warping regression test!" << std::endl;
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::
+    generateDataBaseByTimeAverage(Real threshold_mean, Real threshold_variance, Real start_time)
+{
+    if (converged == "true")
+    {
+        std::cout << "The results have been converged." << std::endl;
+        return;
+    }
+    archiveCurrentRun();
+    BinaryObservationReader current_run(current_run_filefullpath_);
+    size_t number_of_observations = current_run.NumberOfObservations();
+    StdVec<Real> local_meanvalue, local_variance;
+    streamingTimeAverage(current_run, start_time, local_meanvalue, local_variance);
+
+    BiVector<Real> mean_variance(2, StdVec<Real>(local_meanvalue.size(), 0.0));
+    if (number_of_run_ > 1)
+        mean_variance = readRecordsFromStore(mean_variance_filefullpath_);
+    BiVector<Real> mean_variance_new(mean_variance);
+    for (size_t k = 0; k != local_meanvalue.size(); ++k)
+    {
+        mean_variance_new[0][k] = (mean_variance[0][k] * Real(number_of_run_ - 1) + local_meanvalue[k]) / Real(number_of_run_);
+        mean_variance_new[1][k] = SMAX(mean_variance[1][k], local_variance[k]);
+    }
+    writeRecordsToStore(mean_variance_filefullpath_, number_of_observations, mean_variance_new);
+
+    if (number_of_run_ > 1)
+    {
+        int count_not_converged = 0;
+        Real thresholds[2] = {threshold_mean, threshold_variance};
+        for (size_t n = 0; n != 2; ++n)
+            for (size_t k = 0; k != local_meanvalue.size(); ++k)
+            {
+                if (n == 0 && ABS(mean_variance[0][k]) < 0.005 && ABS(mean_variance_new[0][k]) < 0.005)
+                    continue; /* ignored due to its tiny effect. */
+                Real relative_value = ABS((mean_variance[n][k] - mean_variance_new[n][k]) / (mean_variance_new[n][k] + TinyReal));
+                if (relative_value > thresholds[n])
+                {
+                    std::cout << (n == 0 ? "meanvalue: " : "variance: ") << this->quantity_name_ << "[" << k << "]"
+                              << " is not converged, and difference is " << relative_value << std::endl;
+                    count_not_converged++;
+                }
+            }
+        updateConvergence(count_not_converged, "meanvalue and variance");
+    }
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::testResultByTimeAverage(Real start_time)
+{
+    closeCurrentRun();
+    BinaryObservationReader current_run(current_run_filefullpath_);
+    StdVec<Real> local_meanvalue, local_variance;
+    streamingTimeAverage(current_run, start_time, local_meanvalue, local_variance);
+    BiVector<Real> mean_variance = readRecordsFromStore(mean_variance_filefullpath_);
+
+    int test_wrong = 0;
+    for (size_t k = 0; k != local_meanvalue.size(); ++k)
+    {
+        if (ABS(mean_variance[0][k]) < 0.005 && ABS(local_meanvalue[k]) < 0.005)
+            continue; /* not tested due to its tiny effect. */
+        Real relative_value = ABS((mean_variance[0][k] - local_meanvalue[k]) / (mean_variance[0][k] + TinyReal));
+        if (relative_value > 0.1 || local_variance[k] > 1.01 * mean_variance[1][k])
+        {
+            std::cout << this->quantity_name_ << "[" << k << "] is beyond the exception !" << std::endl;
+            std::cout << "The meanvalue is " << mean_variance[0][k] << ", and the current meanvalue is " << local_meanvalue[k] << std::endl;
+            std::cout << "The variance is " << mean_variance[1][k] << ", and the current variance is " << local_variance[k] << std::endl;
+            test_wrong++;
+        }
+    }
+    if (test_wrong != 0)
+    {
+        std::cout << "The time-averaged meanvalue or variance of " << this->quantity_name_ << " is beyond exception!" << std::endl;
+        exit(1);
+    }
+    std::cout << "The result of " << this->quantity_name_
+              << " is correct based on the time-averaged regression test!" << std::endl;
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestBinaryStore<ObserveMethodType>::writeEnsembleAverage()
+{
+    StdVec<UniquePtr<BinaryObservationReader>> runs;
+    StdVec<BinaryObservationReader *> stores;
+    for (int n = 0; n != number_of_run_; ++n)
+        if (fs::exists(runFileFullPath(n)))
+        {
+            runs.push_back(makeUnique<BinaryObservationReader>(runFileFullPath(n)));
+            stores.push_back(runs.back().get());
+        }
+    if (stores.empty())
+        return;
+
+    std::string file_name = this->io_environment_.output_folder_ + "/" +
+                            this->dynamics_identifier_name_ + "_" + this->quantity_name_;
+    size_t number_of_observations = stores[0]->NumberOfObservations();
+    size_t number_of_components = stores[0]->NumberOfComponents();
+    BinaryObservationWriter meanvalue(file_name + "_ensemble_meanvalue.bin", number_of_observations, number_of_components);
+    BinaryObservationWriter variance(file_name + "_ensemble_variance.bin", number_of_observations, number_of_components);
+    streamingEnsembleAverage(stores, meanvalue, variance);
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+RegressionTestBinaryStore<ObserveMethodType>::~RegressionTestBinaryStore()
+{
+    if (converged == "false")
+    {
+        number_of_run_ += 1;
+    }
+    std::ofstream out_file(runtimes_filefullpath_.c_str(), std::ios::trunc);
+    out_file << converged;
+    out_file << "\n";
+    out_file << number_of_run_;
+    out_file << "\n";
+    out_file << label_for_repeat_;
+    out_file.close();
+};
+//=================================================================================================//
+} // namespace SPH
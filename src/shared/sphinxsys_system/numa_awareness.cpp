@@ -0,0 +1,153 @@
+#include "numa_awareness.h"
+
+#include <tbb/task_arena.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=================================================================================================//
+NumaTopology::NumaTopology() : number_of_nodes_(1)
+{
+#ifdef __linux__
+    cpu_set_t available_cpus;
+    CPU_ZERO(&available_cpus);
+    sched_getaffinity(0, sizeof(cpu_set_t), &available_cpus);
+
+    fs::path node_directory("/sys/devices/system/node");
+    StdVec<int> node_ids;
+    if (fs::exists(node_directory))
+    {
+        for (const auto &entry : fs::directory_iterator(node_directory))
+        {
+            std::string name = entry.path().filename().string();
+            if (name.rfind("node", 0) == 0 && name.size() > 4 &&
+                name.find_first_not_of("0123456789", 4) == std::string::npos)
+                node_ids.push_back(std::stoi(name.substr(4)));
+        }
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    for (int node : node_ids)
+    {
+        /** the CPU list is given as ranges, e.g. 0-3,8-11 */
+        std::ifstream cpu_list_file(node_directory / ("node" + std::to_string(node)) / "cpulist");
+        std::string cpu_range;
+        while (std::getline(cpu_list_file, cpu_range, ','))
+        {
+            if (cpu_range.find_first_of("0123456789") == std::string::npos)
+                continue;
+            size_t dash = cpu_range.find('-');
+            int first = std::stoi(cpu_range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(cpu_range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+                if (CPU_ISSET(cpu, &available_cpus))
+                {
+                    cpus_.push_back(cpu);
+                    nodes_.push_back(node);
+                }
+        }
+    }
+    number_of_nodes_ = node_ids.empty() ? 1 : node_ids.back() + 1;
+#endif
+}
+//=================================================================================================//
+ThreadPinning::ThreadPinning(const NumaTopology &numa_topology)
+    : tbb::task_scheduler_observer(), numa_topology_(numa_topology), number_of_threads_(0)
+{
+    observe(true);
+}
+//=================================================================================================//
+#ifdef __linux__
+namespace
+{
+/** the CPU given to this thread, and its affinity before entering the (nested) arenas */
+thread_local const ThreadPinning *thread_pinning = nullptr;
+thread_local size_t thread_cpu_index = 0;
+thread_local int arena_entry_depth = 0;
+thread_local bool is_thread_pinned = false;
+thread_local cpu_set_t thread_original_cpus;
+} // namespace
+#endif
+//=================================================================================================//
+void ThreadPinning::on_scheduler_entry(bool is_worker)
+{
+#ifdef __linux__
+    const StdVec<int> &cpus = numa_topology_.cpus_;
+    if (arena_entry_depth++ != 0 || cpus.empty())
+        return;
+
+    if (thread_pinning != this)
+    {
+        thread_pinning = this;
+        thread_cpu_index = number_of_threads_.fetch_add(1);
+    }
+    CPU_ZERO(&thread_original_cpus);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &thread_original_cpus) != 0)
+        return;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpus[thread_cpu_index % cpus.size()], &cpu_set);
+    is_thread_pinned = sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0;
+#endif
+}
+//=================================================================================================//
+void ThreadPinning::on_scheduler_exit(bool is_worker)
+{
+#ifdef __linux__
+    if (arena_entry_depth == 0 || --arena_entry_depth != 0 || !is_thread_pinned)
+        return;
+    sched_setaffinity(0, sizeof(cpu_set_t), &thread_original_cpus);
+    is_thread_pinned = false;
+#endif
+}
+//=================================================================================================//
+StdVec<size_t> memoryPlacementOnNodes(const NumaTopology &numa_topology,
+                                      const StdVec<std::pair<void *, size_t>> &regions)
+{
+    StdVec<size_t> bytes_on_nodes(numa_topology.number_of_nodes_ + 1, 0);
+#ifdef __linux__
+    size_t page_bytes = size_t(sysconf(_SC_PAGESIZE));
+    size_t batch_size = 4096;
+    StdVec<void *> pages;
+    StdVec<int> status;
+    for (const auto &region : regions)
+    {
+        if (region.second == 0)
+            continue;
+        uintptr_t begin = reinterpret_cast<uintptr_t>(region.first) / page_bytes * page_bytes;
+        uintptr_t end = reinterpret_cast<uintptr_t>(region.first) + region.second;
+        for (uintptr_t page = begin; page < end; page += batch_size * page_bytes)
+        {
+            pages.clear();
+            for (uintptr_t address = page; address < end && pages.size() != batch_size; address += page_bytes)
+                pages.push_back(reinterpret_cast<void *>(address));
+            status.assign(pages.size(), -1);
+            /** with no target nodes given, the nodes of the pages are only queried */
+            if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+                return StdVec<size_t>();
+            for (int node : status)
+            {
+                size_t index = node >= 0 && size_t(node) < numa_topology.number_of_nodes_
+                                   ? size_t(node)
+                                   : numa_topology.number_of_nodes_;
+                bytes_on_nodes[index] += page_bytes;
+            }
+        }
+    }
+#endif
+    return bytes_on_nodes;
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,90 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	numa_awareness.h
+ * @brief 	Here gives the NUMA topology, the pinning of the TBB worker threads
+ * 			and the report of the memory placement of the particle data.
+ * @details The worker threads are pinned to the CPUs ordered by the NUMA nodes,
+ * 			so that the contiguous blocks of the particle data touched first by the threads
+ * 			in order are placed on the NUMA nodes one after another.
+ * 			Only Linux is supported, and nothing is done on other platforms.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef NUMA_AWARENESS_H
+#define NUMA_AWARENESS_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <tbb/task_scheduler_observer.h>
+
+#include <atomic>
+
+namespace SPH
+{
+/** the NUMA nodes of the CPUs available to this process, ordered by the nodes */
+struct NumaTopology
+{
+    NumaTopology();
+    size_t number_of_nodes_;
+    StdVec<int> cpus_;  /**< the available CPUs ordered by the nodes */
+    StdVec<int> nodes_; /**< the nodes of the CPUs */
+};
+
+/**
+ * @class ThreadPinning
+ * @brief Pin each thread entering the TBB arena to a CPU, and restore its affinity when it leaves.
+ * @details Each thread is given its own CPU when it enters first,
+ * so that the threads of concurrent arenas, which have the same thread slots, are not pinned to the same CPUs.
+ */
+class ThreadPinning : public tbb::task_scheduler_observer
+{
+  public:
+    explicit ThreadPinning(const NumaTopology &numa_topology);
+    virtual ~ThreadPinning() { observe(false); };
+    virtual void on_scheduler_entry(bool is_worker) override;
+    virtual void on_scheduler_exit(bool is_worker) override;
+
+  protected:
+    const NumaTopology &numa_topology_;
+    std::atomic<size_t> number_of_threads_; /**< the number of threads given a CPU */
+};
+
+/** the memory regions of the particle data */
+template <typename DataType>
+struct collectParticleDataRegions
+{
+    void operator()(ParticleData &particle_data, StdVec<std::pair<void *, size_t>> &regions) const
+    {
+        constexpr int type_index = DataTypeIndex<DataType>::value;
+        for (StdLargeVec<DataType> *variable : std::get<type_index>(particle_data))
+            regions.push_back(std::make_pair(variable->data(), variable->capacity() * sizeof(DataType)));
+    };
+};
+
+/** the bytes of the memory regions on each NUMA node, with the pages not yet touched as the last entry */
+StdVec<size_t> memoryPlacementOnNodes(const NumaTopology &numa_topology,
+                                      const StdVec<std::pair<void *, size_t>> &regions);
+} // namespace SPH
+#endif // NUMA_AWARENESS_H
@@ -12,7 +12,26 @@ SPHSystem::SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref, size
       resolution_ref_(resolution_ref),
       tbb_global_control_(tbb::global_control::max_allowed_parallelism, number_of_threads),
       io_environment_(nullptr), generate_regression_data_(false), run_particle_relaxation_(false),
-      reload_particles_(false), restart_step_(0) {}
+      reload_particles_(false), restart_step_(0), numa_awareness_(false) {}
+//=================================================================================================//
+SPHSystem::~SPHSystem()
+{
+    /** the allocation of large data is global, and is set back to the default */
+    if (numa_awareness_)
+    {
+        LargeDataAllocation::parallel_first_touch_ = false;
+        LargeDataAllocation::use_huge_pages_ = false;
+    }
+}
+//=================================================================================================//
+void SPHSystem::setNumaAwareness(bool pin_threads, bool use_huge_pages)
+{
+    numa_awareness_ = true;
+    LargeDataAllocation::parallel_first_touch_ = true;
+    LargeDataAllocation::use_huge_pages_ = use_huge_pages;
+    if (pin_threads)
+        thread_pinning_keeper_.createPtr<ThreadPinning>(numa_topology_);
+}
 //=================================================================================================//
 void SPHSystem::initializeSystemCellLinkedLists()
 {
@@ -20,6 +39,9 @@ void SPHSystem::initializeSystemCellLinkedLists()
     {
         DynamicCast<RealBody>(this, body)->updateCellLinkedList();
     }
+
+    if (numa_awareness_)
+        reportMemoryPlacement();
 }
 //=================================================================================================//
 void SPHSystem::initializeSystemConfigurations()
@@ -30,6 +52,8 @@ void SPHSystem::initializeSystemConfigurations()
         {
             body->body_relations_[i]->updateConfiguration();
         }
+        if (body->getWorkloadBalancing())
+            body->balanceWorkload();
     }
 }
 //=================================================================================================//
@@ -46,6 +70,30 @@ Real SPHSystem::getSmallestTimeStepAmongSolidBodies(Real CFL)
     return dt;
 }
 //=================================================================================================//
+void SPHSystem::reportMemoryPlacement()
+{
+    StdVec<std::pair<void *, size_t>> regions;
+    DataAssembleOperation<collectParticleDataRegions> collect_particle_data_regions;
+    for (auto &body : sph_bodies_)
+        collect_particle_data_regions(body->getBaseParticles().getAllParticleData(), regions);
+
+    StdVec<size_t> bytes_on_nodes = memoryPlacementOnNodes(numa_topology_, regions);
+    if (bytes_on_nodes.empty())
+    {
+        std::cout << "\n Memory placement of particle data is not available." << std::endl;
+        return;
+    }
+
+    size_t total_bytes = 0;
+    for (size_t bytes : bytes_on_nodes)
+        total_bytes += bytes;
+    Real megabyte = 1024.0 * 1024.0;
+    std::cout << "\n Memory placement of particle data (" << Real(total_bytes) / megabyte << " MB):";
+    for (size_t node = 0; node != numa_topology_.number_of_nodes_; ++node)
+        std::cout << " node " << node << ": " << Real(bytes_on_nodes[node]) / megabyte << " MB;";
+    std::cout << " not yet touched: " << Real(bytes_on_nodes.back()) / megabyte << " MB." << std::endl;
+}
+//=================================================================================================//
 #ifdef BOOST_AVAILABLE
 void SPHSystem::handleCommandlineOptions(int ac, char *av[])
 {
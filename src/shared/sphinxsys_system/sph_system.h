@@ -38,6 +38,7 @@ namespace po = boost::program_options;
 #endif
 
 #include "base_data_package.h"
+#include "numa_awareness.h"
 #include "sph_data_containers.h"
 
 #include <filesystem>
@@ -63,7 +64,7 @@ class SPHSystem
   public:
     SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref,
               size_t number_of_threads = std::thread::hardware_concurrency());
-    virtual ~SPHSystem(){};
+    virtual ~SPHSystem();
 
     void setRunParticleRelaxation(bool run_particle_relaxation) { run_particle_relaxation_ = run_particle_relaxation; };
     bool RunParticleRelaxation() { return run_particle_relaxation_; };
@@ -71,6 +72,9 @@ class SPHSystem
     bool ReloadParticles() { return reload_particles_; };
     void setRestartStep(size_t restart_step) { restart_step_ = restart_step; };
     size_t RestartStep() { return restart_step_; };
+    /** NUMA-aware mode with the parallel first touch of large data, should be set before the particles are generated */
+    void setNumaAwareness(bool pin_threads = true, bool use_huge_pages = false);
+    bool NumaAwareness() { return numa_awareness_; };
     BoundingBox system_domain_bounds_;       /**< Lower and Upper domain bounds. */
     Real resolution_ref_;                    /**< reference resolution of the SPH system */
     tbb::global_control tbb_global_control_; /**< global controlling on the total number parallel threads */
@@ -88,6 +92,8 @@ class SPHSystem
     void initializeSystemConfigurations();
     /** get the min time step from all bodies. */
     Real getSmallestTimeStepAmongSolidBodies(Real CFL = 0.6);
+    /** report the memory placement of the particle data of all bodies on the NUMA nodes */
+    void reportMemoryPlacement();
     /** Command line handle for Ctest. */
 #ifdef BOOST_AVAILABLE
     void handleCommandlineOptions(int ac, char *av[]);
@@ -96,6 +102,9 @@ class SPHSystem
     bool run_particle_relaxation_; /**< run particle relaxation for body fitted particle distribution */
     bool reload_particles_;        /**< start the simulation with relaxed particles. */
     size_t restart_step_;          /**< restart step */
+    bool numa_awareness_;          /**< parallel first touch of large data and report of memory placement */
+    NumaTopology numa_topology_;
+    UniquePtrKeeper<ThreadPinning> thread_pinning_keeper_;
 };
 } // namespace SPH
 #endif // SPH_SYSTEM_H
\ No newline at end of file
@@ -102,7 +102,7 @@ int main(int ac, char *av[])
     RegressionTestDynamicTimeWarping<ReducedQuantityRecording<ReduceDynamics<TotalMechanicalEnergy>>>
         write_water_mechanical_energy(io_environment, water_block, gravity_ptr);
     RegressionTestDynamicTimeWarping<ObservedQuantityRecording<Real>>
-        write_recorded_water_pressure("Pressure", io_environment, fluid_observer_contact);
+        write_recorded_water_pressure("Pressure", io_environment, fluid_observer_contact, true);
     //----------------------------------------------------------------------
     //	Prepare the simulation with cell linked list, configuration
     //	and case specified initial condition if necessary.
@@ -196,7 +196,6 @@ int main(int ac, char *av[])
             time_instance = TickCount::now();
             water_block.updateCellLinkedListWithParticleSort(100);
             water_block_complex.updateConfiguration();
-            fluid_observer_contact.updateConfiguration();
             interval_updating_configuration += TickCount::now() - time_instance;
         }
 
@@ -12,6 +12,9 @@ Real L = 2.0;
 Real H = 0.4;
 Real resolution_ref = H / 40.0;
 BoundingBox system_domain_bounds(Vec2d(0.0, 0.0), Vec2d(L, H));
+/** Set true to compare with the implicit diffusion, which is not limited by the diffusion time step size. */
+bool use_implicit_diffusion = false;
+Real implicit_time_step_ratio = 10.0;
 //----------------------------------------------------------------------
 //	Basic parameters for material properties.
 //----------------------------------------------------------------------
@@ -142,6 +145,8 @@ int main()
     //	Note that there may be data dependence on the constructors of these methods.
     //----------------------------------------------------------------------
     DiffusionBodyRelaxation diffusion_relaxation(diffusion_body_inner_relation);
+    DiffusionRelaxationImplicit<DiffusionParticles, CorrectedKernelGradientInner>
+        implicit_diffusion_relaxation(diffusion_body_inner_relation);
     SimpleDynamics<DiffusionInitialCondition> setup_diffusion_initial_condition(diffusion_body);
     InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration(diffusion_body_inner_relation);
     GetDiffusionTimeStepSize<DiffusionParticles> get_time_step_size(diffusion_body);
@@ -198,10 +203,11 @@ int main()
                               << dt << "\n";
                 }
 
-                diffusion_relaxation.exec(dt);
+                use_implicit_diffusion ? implicit_diffusion_relaxation.exec(dt) : diffusion_relaxation.exec(dt);
 
                 ite++;
-                dt = get_time_step_size.exec();
+                dt = use_implicit_diffusion ? implicit_time_step_ratio * get_time_step_size.exec()
+                                            : get_time_step_size.exec();
                 relaxation_time += dt;
                 integration_time += dt;
                 GlobalStaticVariables::physical_time_ += dt;
@@ -95,6 +95,8 @@ int main(int ac, char *av[])
     //----------------------------------------------------------------------
     ComplexRelation water_block_complex(water_block, {&wall_boundary});
     ContactRelation fluid_observer_contact(fluid_observer, {&water_block});
+    /** The inner and wall contact configurations of the water block are updated together. */
+    RelationManager water_block_relations({&water_block_complex});
     //----------------------------------------------------------------------
     //	Define the numerical methods used in the simulation.
     //	Note that there may be data dependence on the sequence of constructions.
@@ -115,7 +117,7 @@ int main(int ac, char *av[])
     RegressionTestDynamicTimeWarping<ReducedQuantityRecording<ReduceDynamics<TotalMechanicalEnergy>>>
         write_water_mechanical_energy(io_environment, water_block, gravity_ptr);
     RegressionTestDynamicTimeWarping<ObservedQuantityRecording<Real>>
-        write_recorded_water_pressure("Pressure", io_environment, fluid_observer_contact);
+        write_recorded_water_pressure("Pressure", io_environment, fluid_observer_contact, true);
     //----------------------------------------------------------------------
     //	Prepare the simulation with cell linked list, configuration
     //	and case specified initial condition if necessary.
@@ -174,8 +176,7 @@ int main(int ac, char *av[])
             number_of_iterations++;
 
             water_block.updateCellLinkedListWithParticleSort(100);
-            water_block_complex.updateConfiguration();
-            fluid_observer_contact.updateConfiguration();
+            water_block_relations.updateConfigurations();
             write_recorded_water_pressure.writeToFile(number_of_iterations);
         }
 
@@ -411,7 +411,7 @@ int main(int ac, char *av[])
     InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration_contraction(mechanics_body_inner);
     InteractionDynamics<CorrectInterpolationKernelWeights> correct_kernel_weights_for_interpolation(mechanics_body_contact);
     /** Interpolate the active contract stress from electrophysiology body. */
-    InteractionDynamics<InterpolatingAQuantity<Real>>
+    InterpolatingAQuantityByStencil<Real>
         active_stress_interpolation(mechanics_body_contact, "ActiveContractionStress", "ActiveContractionStress");
     /** Interpolate the particle position in physiology_heart  from mechanics_heart. */
     // TODO: this is a bug, we should interpolate displacement other than position.
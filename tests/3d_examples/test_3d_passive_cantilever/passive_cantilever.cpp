@@ -81,7 +81,7 @@ int main()
     cantilever_observer.generateParticles<ObserverParticleGenerator>(observation_location);
 
     /** topology */
-    InnerRelation cantilever_body_inner(cantilever_body);
+    TotalLagrangianInnerRelation cantilever_body_inner(cantilever_body);
     ContactRelation cantilever_observer_contact(cantilever_observer, {&cantilever_body});
 
     /**
@@ -95,8 +95,9 @@ int main()
     ReduceDynamics<solid_dynamics::AcousticTimeStepSize>
         computing_time_step_size(cantilever_body);
     /** active and passive stress relaxation. */
-    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> stress_relaxation_first_half(cantilever_body_inner);
-    Dynamics1Level<solid_dynamics::Integration2ndHalf> stress_relaxation_second_half(cantilever_body_inner);
+    Dynamics1Level<solid_dynamics::PackedIntegration1stHalf<solid_dynamics::Integration1stHalfPK2>>
+        stress_relaxation_first_half(cantilever_body_inner);
+    Dynamics1Level<solid_dynamics::PackedIntegration2ndHalf> stress_relaxation_second_half(cantilever_body_inner);
     /** Constrain the holder. */
     BodyRegionByParticle holder(cantilever_body,
                                 makeShared<TransformShape<GeometricShapeBox>>(Transform(translation_holder), halfsize_holder, "Holder"));
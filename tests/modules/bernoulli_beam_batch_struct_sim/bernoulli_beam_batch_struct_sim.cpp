@@ -0,0 +1,68 @@
+#include "structural_simulation_class.h"
+#include <gtest/gtest.h>
+
+TEST(BernoulliBeam20xBatch, PressureSweep)
+{
+    Real scale_stl = 0.001;
+    Real end_time = 0.15;
+
+    Real rho_0 = 6.45e3; // Nitinol
+    Real poisson = 0.3;
+    Real Youngs_modulus = 5e8;
+    Real physical_viscosity = Youngs_modulus / 100;
+    StdVec<Real> pressure_list = {1e3, 2e3};
+
+    /** STL IMPORT PARAMETERS */
+    std::string relative_input_path = "./input/"; // path definition for linux
+    std::vector<std::string> imported_stl_list = {"bernoulli_beam_20x.stl"};
+    std::vector<Vec3d> translation_list = {Vec3d::Zero()};
+    std::vector<Real> resolution_list = {10.0 / 6.0};
+    SharedPtr<SaintVenantKirchhoffSolid> material = makeShared<SaintVenantKirchhoffSolid>(rho_0, Youngs_modulus, poisson);
+    std::vector<SharedPtr<SaintVenantKirchhoffSolid>> material_model_list = {material};
+
+    SharedPtr<TriangleMeshShapeSTL> specimen = makeShared<TriangleMeshShapeSTL>("./input/bernoulli_beam_20x.stl", Vec3d::Zero(), scale_stl, "bernoulli_beam_20x");
+    BoundingBox fixation = specimen->getBounds();
+    fixation.second_[0] = fixation.first_[0] + 0.01;
+
+    StructuralSimulationInput input{
+        relative_input_path,
+        imported_stl_list,
+        scale_stl,
+        translation_list,
+        resolution_list,
+        material_model_list,
+        {physical_viscosity},
+        {}};
+    input.body_indices_fixed_constraint_region_ = StdVec<ConstrainedRegionPair>{ConstrainedRegionPair(0, fixation)};
+
+    //=================================================================================================//
+    StructuralSimulationBatch batch(input);
+    for (size_t k = 0; k < pressure_list.size(); k++)
+    {
+        StdVec<std::array<Real, 2>> pressure_over_time = {
+            {Real(0), Real(0)},
+            {Real(end_time * 0.1), pressure_list[k]},
+            {Real(end_time), pressure_list[k]}};
+        input.surface_pressure_tuple_ = StdVec<PressureTuple>{PressureTuple(0, specimen, Vec3d(0.1, 0.0, 0.1), pressure_over_time)};
+        batch.addCase("pressure_" + std::to_string(k), input);
+    }
+    batch.runCases(end_time, 2);
+
+    // the displacement is linear to the pressure
+    StdVec<StdVec<Real>> results = batch.getResults();
+    Real displ_max_analytical = 4.8e-3; // in mm, absolute max displacement
+    for (size_t k = 0; k < pressure_list.size(); k++)
+    {
+        ASSERT_EQ(results[k].size(), size_t(4));
+        Real displ_max = results[k][1];
+        Real displ_max_expected = displ_max_analytical * pressure_list[k] / pressure_list[0];
+        EXPECT_NEAR(displ_max, displ_max_expected, displ_max_expected * 0.1);
+        std::cout << "case " << k << " displ_max: " << displ_max << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;                          /**< Block length. */
+Real DH = 1.0;                          /**< Block height. */
+Real resolution_ref = 0.05;             /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+int number_of_ranks = 3;
+
+/** exchange buffers of different sizes, including a large one, and reduce values of all ranks */
+int testCommunicator(BaseCommunicator &communicator)
+{
+    int rank = communicator.Rank();
+    int size = communicator.Size();
+    StdVec<ByteBuffer> send_buffers(size);
+    for (int r = 0; r != size; ++r)
+        send_buffers[r].assign(r == 0 ? 1000000 : 10 * rank + r, char(10 * rank + r));
+    StdVec<ByteBuffer> receive_buffers;
+    communicator.exchangeBuffers(send_buffers, receive_buffers);
+    for (int r = 0; r != size; ++r)
+    {
+        size_t expected_size = rank == 0 ? 1000000 : 10 * r + rank;
+        EXPECT_EQ(receive_buffers[r].size(), expected_size);
+        for (char value : receive_buffers[r])
+            EXPECT_EQ(value, char(10 * r + rank));
+    }
+
+    ReduceSum<Real> reduce_sum;
+    ReduceMin reduce_min;
+    EXPECT_EQ(communicator.allReduce(Real(rank + 1), reduce_sum), Real(size * (size + 1) / 2));
+    EXPECT_EQ(communicator.allReduce(Real(rank + 1), reduce_min), 1.0);
+    return ::testing::Test::HasFailure() ? 1 : 0;
+}
+
+TEST(test_DomainDecomposition, test_LocalProcessCommunicator)
+{
+    EXPECT_EQ(runOnLocalProcesses(number_of_ranks, testCommunicator), 0);
+}
+
+/** the neighbors found with the migrated and halo particles are the same as those of the whole body */
+int testDecomposition(BaseCommunicator &communicator)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    StdLargeVec<Vecd> &pos = particles.pos_;
+    size_t total_particles = particles.total_real_particles_;
+    /** the particles are mirrored, so that most of them are moved to other ranks */
+    StdLargeVec<Vecd> all_positions(total_particles);
+    for (size_t i = 0; i != total_particles; ++i)
+        all_positions[i] = Vecd(DL - pos[i][0], pos[i][1]);
+
+    DomainDecomposition decomposition(block, communicator);
+    decomposition.updatePartition();
+    decomposition.keepOwnedParticles();
+    EXPECT_EQ(decomposition.globalTotalRealParticles(), total_particles);
+    EXPECT_LT(particles.total_real_particles_, total_particles);
+
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        pos[i][0] = DL - pos[i][0];
+    decomposition.migrateParticles();
+    EXPECT_EQ(decomposition.globalTotalRealParticles(), total_particles);
+    StdLargeVec<size_t> &morton_keys = decomposition.computeMortonKeys();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        EXPECT_EQ(decomposition.OwnerRank(morton_keys[i]), communicator.Rank());
+
+    block.updateCellLinkedList();
+    decomposition.exchangeHaloParticles();
+    EXPECT_GT(decomposition.TotalHaloParticles(), size_t(0));
+    InnerRelation block_inner(block);
+    block_inner.updateConfiguration();
+
+    Real cutoff_radius = block.sph_adaptation_->getKernel()->CutOffRadius();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        size_t number_of_neighbors = 0;
+        for (size_t j = 0; j != total_particles; ++j)
+        {
+            Real distance = (all_positions[j] - pos[i]).norm();
+            if (distance < cutoff_radius && distance > 0.0)
+                number_of_neighbors++;
+        }
+        EXPECT_EQ(block_inner.inner_configuration_[i].current_size_, number_of_neighbors);
+    }
+
+    StdLargeVec<Real> &rho = particles.rho_;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        rho[i] = pos[i][0] + 2.0 * pos[i][1];
+    decomposition.addVariableToExchange<Real>("Density");
+    decomposition.updateHaloParticles();
+    for (size_t i = particles.real_particles_bound_;
+         i != particles.real_particles_bound_ + particles.total_ghost_particles_; ++i)
+        EXPECT_NEAR(rho[i], pos[i][0] + 2.0 * pos[i][1], 1.0e-12);
+
+    DistributedReduceDynamics<QuantitySummation<Real>> total_volume(communicator, block, "VolumetricMeasure");
+    EXPECT_NEAR(total_volume.exec(), DL * DH, 1.0e-10);
+    return ::testing::Test::HasFailure() ? 1 : 0;
+}
+
+TEST(test_DomainDecomposition, test_MigrationAndHaloExchange)
+{
+    EXPECT_EQ(runOnLocalProcesses(number_of_ranks, testDecomposition), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;              /**< Block length. */
+Real DH = 1.0;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+
+TEST(test_MonitoringChannel, test_ring_buffer)
+{
+    MonitoringRingBuffer ring_buffer(5);
+    MonitoringRecord record;
+    for (size_t k = 0; k != 10; ++k)
+    {
+        record.iteration_step_ = k;
+        ring_buffer.push(record);
+    }
+    EXPECT_EQ(ring_buffer.DroppedRecords(), size_t(2));
+    for (size_t k = 0; k != 8; ++k)
+    {
+        ASSERT_TRUE(ring_buffer.pop(record));
+        EXPECT_EQ(record.iteration_step_, k);
+    }
+    EXPECT_FALSE(ring_buffer.pop(record));
+}
+
+/** the quantities are written with their sampling periods after the channel is closed,
+ *  together with the published quantity computed by the solver */
+TEST(test_MonitoringChannel, test_sampled_reductions)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    IOEnvironment io_environment(sph_system);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    StdLargeVec<Vecd> &vel = block.getBaseParticles().vel_;
+
+    size_t number_of_steps = 20;
+    {
+        MonitoringChannel monitoring_channel(io_environment, "Monitoring");
+        monitoring_channel.registerReduction<ReduceDynamics<QuantitySummation<Real>>>(5, block, "VolumetricMeasure");
+        monitoring_channel.registerReduction<ReduceDynamics<MaximumSpeed>>(1, block);
+        size_t time_step_index = monitoring_channel.registerPublishedQuantity("TimeStepSize");
+        for (size_t step = 0; step != number_of_steps; ++step)
+        {
+            vel[0] = Vecd(Real(step), 0.0);
+            monitoring_channel.sample(step);
+            if (step % 2 == 0)
+                monitoring_channel.publish(time_step_index, step, 0.1 * Real(step));
+        }
+        EXPECT_EQ(monitoring_channel.DroppedRecords(), size_t(0));
+    }
+
+    std::ifstream in_file(io_environment.output_folder_ + "/Monitoring.csv");
+    std::string line;
+    std::getline(in_file, line);
+    EXPECT_EQ(line, "iteration_step,run_time,quantity,components");
+    size_t volume_records = 0;
+    size_t speed_records = 0;
+    size_t time_step_records = 0;
+    while (std::getline(in_file, line))
+    {
+        std::stringstream line_stream(line);
+        std::string step, time, quantity, value;
+        std::getline(line_stream, step, ',');
+        std::getline(line_stream, time, ',');
+        std::getline(line_stream, quantity, ',');
+        std::getline(line_stream, value, ',');
+        if (quantity == "Block_VolumetricMeasureSummation")
+        {
+            EXPECT_EQ(std::stoul(step) % 5, size_t(0));
+            EXPECT_NEAR(std::stod(value), DL * DH, 1.0e-6);
+            volume_records++;
+        }
+        else if (quantity == "TimeStepSize")
+        {
+            EXPECT_EQ(std::stoul(step) % 2, size_t(0));
+            EXPECT_NEAR(std::stod(value), 0.1 * std::stod(step), 1.0e-6);
+            time_step_records++;
+        }
+        else
+        {
+            EXPECT_EQ(quantity, "Block_MaximumSpeed");
+            EXPECT_NEAR(std::stod(value), std::stod(step), 1.0e-6);
+            speed_records++;
+        }
+    }
+    EXPECT_EQ(volume_records, number_of_steps / 5);
+    EXPECT_EQ(speed_records, number_of_steps);
+    EXPECT_EQ(time_step_records, number_of_steps / 2);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
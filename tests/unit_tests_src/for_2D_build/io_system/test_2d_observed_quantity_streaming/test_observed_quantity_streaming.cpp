@@ -0,0 +1,112 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;              /**< Block length. */
+Real DH = 1.0;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+size_t number_of_records = 6;
+
+/** the probes on a regular grid inside the block */
+StdVec<Vecd> probeLocations()
+{
+    StdVec<Vecd> locations;
+    for (size_t i = 1; i != 10; ++i)
+        for (size_t j = 1; j != 5; ++j)
+            locations.push_back(Vecd(0.2 * Real(i), 0.2 * Real(j)));
+    return locations;
+}
+
+/** the records written by the streaming are read back by the binary observation store
+ *  and from the CSV file, and compared with the observed quantities at the time of writing */
+TEST(test_ObservedQuantityStreaming, test_round_trip)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    IOEnvironment io_environment(sph_system);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    ObserverBody probes(sph_system, "Probes");
+    probes.generateParticles<ObserverParticleGenerator>(probeLocations());
+    ContactRelation probes_contact(probes, {&block});
+    sph_system.initializeSystemCellLinkedLists();
+
+    BaseParticles &particles = block.getBaseParticles();
+    size_t number_of_probes = probes.getBaseParticles().total_real_particles_;
+    StdVec<StdVec<Real>> expected_velocities;
+    StdVec<StdVec<Real>> expected_densities;
+    {
+        ObservedQuantityStreaming<Vecd> velocity_streaming("Velocity", io_environment, probes_contact,
+                                                           ObservationFormat::Binary, true);
+        ObservedQuantityStreaming<Real> density_streaming("Density", io_environment, probes_contact,
+                                                          ObservationFormat::CSV, true);
+        for (size_t n = 0; n != number_of_records; ++n)
+        {
+            GlobalStaticVariables::physical_time_ = 0.1 * Real(n);
+            for (size_t i = 0; i != particles.total_real_particles_; ++i)
+            {
+                Vecd &pos = particles.pos_[i];
+                particles.vel_[i] = Real(n + 1) * Vecd(pos[0], -pos[1]);
+                particles.rho_[i] = 1.0 + 0.1 * Real(n) * pos[0];
+            }
+            velocity_streaming.writeToFile(n);
+            density_streaming.writeToFile(n);
+
+            StdVec<Real> velocities;
+            for (const Vecd &velocity : *velocity_streaming.getObservedQuantity())
+                appendComponents(velocities, velocity);
+            velocities.resize(number_of_probes * Dimensions);
+            expected_velocities.push_back(velocities);
+            StdVec<Real> densities(density_streaming.getObservedQuantity()->begin(),
+                                   density_streaming.getObservedQuantity()->begin() + number_of_probes);
+            expected_densities.push_back(densities);
+        }
+    }
+
+    BinaryObservationReader velocity_store(io_environment.output_folder_ + "/Probes_Velocity.bin");
+    ASSERT_EQ(velocity_store.NumberOfObservations(), number_of_probes);
+    ASSERT_EQ(velocity_store.NumberOfComponents(), size_t(Dimensions));
+    ASSERT_EQ(velocity_store.NumberOfRecords(), number_of_records);
+    StdVec<Real> record;
+    for (size_t n = 0; n != number_of_records; ++n)
+    {
+        ASSERT_TRUE(velocity_store.readRecord(record));
+        ASSERT_EQ(record.size(), velocity_store.RecordSize());
+        EXPECT_EQ(record[0], 0.1 * Real(n));
+        for (size_t k = 0; k != expected_velocities[n].size(); ++k)
+            EXPECT_EQ(record[k + 1], expected_velocities[n][k]) << "record " << n << " component " << k;
+    }
+    EXPECT_FALSE(velocity_store.readRecord(record));
+    /** the observed field is not trivial, i.e. the interpolation is done with the lazy configuration */
+    EXPECT_NEAR(expected_velocities.back()[0], Real(number_of_records) * 0.2, 0.05);
+
+    std::ifstream in_file(io_environment.output_folder_ + "/Probes_Density.csv");
+    std::string line;
+    std::getline(in_file, line);
+    EXPECT_EQ(line.substr(0, 20), "run_time,Density[0],");
+    for (size_t n = 0; n != number_of_records; ++n)
+    {
+        ASSERT_TRUE(std::getline(in_file, line).good());
+        std::stringstream line_stream(line);
+        std::string value;
+        std::getline(line_stream, value, ',');
+        EXPECT_NEAR(std::stod(value), 0.1 * Real(n), 1.0e-6);
+        for (size_t k = 0; k != number_of_probes; ++k)
+        {
+            std::getline(line_stream, value, ',');
+            EXPECT_NEAR(std::stod(value), expected_densities[n][k], 1.0e-5) << "record " << n << " probe " << k;
+        }
+    }
+    EXPECT_FALSE(std::getline(in_file, line).good());
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
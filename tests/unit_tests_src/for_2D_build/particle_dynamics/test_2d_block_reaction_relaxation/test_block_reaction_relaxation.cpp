@@ -0,0 +1,112 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+/** electrophysiology parameters */
+Real c_m = 1.0;
+Real k = 8.0;
+Real a = 0.15;
+Real b = 0.0;
+Real mu_1 = 0.2;
+Real mu_2 = 0.3;
+Real epsilon = 0.04;
+Real k_a = 1.0e-4;
+Real dt = 0.01;
+int number_of_steps = 20;
+
+/** a derived model with its own active contraction stress, which is not part of the block rates of the base model */
+class LinearContractionModel : public AlievPanfilowModel
+{
+  protected:
+    virtual Real getProductionActiveContractionStress(LocalSpecies &species) override
+    {
+        return k_a_ * species[voltage_];
+    };
+    virtual Real getLossRateActiveContractionStress(LocalSpecies &species) override { return 0.5; };
+
+  public:
+    LinearContractionModel() : AlievPanfilowModel(k_a, c_m, k, a, b, mu_1, mu_2, epsilon){};
+    virtual ~LinearContractionModel(){};
+};
+
+/** the species after the forward and backward reaction relaxations of the given dynamics types */
+template <class ReactionModelType, class ReactionRelaxationForwardType, class ReactionRelaxationBackwardType>
+StdVec<StdLargeVec<Real>> relaxReactions(SharedPtr<ReactionModelType> reaction_model_ptr)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<ElectroPhysiologyParticles, MonoFieldElectroPhysiology>(
+        reaction_model_ptr, TypeIdentity<DirectionalDiffusion>(), 1.0, 0.0, Vec2d(1.0, 0.0));
+    block.generateParticles<ParticleGeneratorLattice>();
+    ElectroPhysiologyParticles &particles = *DynamicCast<ElectroPhysiologyParticles>(&block, &block.getBaseParticles());
+    StdVec<StdLargeVec<Real> *> &species = particles.ReactiveSpecies();
+    size_t total_real_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vecd &position = particles.pos_[i];
+        (*species[0])[i] = exp(-4.0 * ((position[0] - 1.0) * (position[0] - 1.0) + position[1] * position[1]));
+        (*species[1])[i] = 0.1 * position[1];
+        (*species[2])[i] = 0.0;
+    }
+
+    ReactionRelaxationForwardType reaction_relaxation_forward(block);
+    ReactionRelaxationBackwardType reaction_relaxation_backward(block);
+    for (int n = 0; n != number_of_steps; ++n)
+    {
+        reaction_relaxation_forward.exec(0.5 * dt);
+        reaction_relaxation_backward.exec(0.5 * dt);
+    }
+
+    StdVec<StdLargeVec<Real>> results;
+    for (size_t k = 0; k != species.size(); ++k)
+        results.push_back(*species[k]);
+    return results;
+}
+
+/** the block relaxations give the same species as the per-particle ones */
+template <class ReactionModelType>
+void compareBlockWithPerParticleRelaxation(SharedPtr<ReactionModelType> reaction_model_ptr)
+{
+    StdVec<StdLargeVec<Real>> per_particle_results =
+        relaxReactions<ReactionModelType,
+                       SimpleDynamics<ReactionRelaxationForward<ElectroPhysiologyParticles>>,
+                       SimpleDynamics<ReactionRelaxationBackward<ElectroPhysiologyParticles>>>(reaction_model_ptr);
+    StdVec<StdLargeVec<Real>> block_results =
+        relaxReactions<ReactionModelType,
+                       electro_physiology::ElectroPhysiologyReactionRelaxationForward,
+                       electro_physiology::ElectroPhysiologyReactionRelaxationBackward>(reaction_model_ptr);
+
+    ASSERT_EQ(per_particle_results.size(), block_results.size());
+    for (size_t k = 0; k != per_particle_results.size(); ++k)
+    {
+        ASSERT_EQ(per_particle_results[k].size(), block_results[k].size());
+        Real max_difference = 0.0;
+        for (size_t i = 0; i != per_particle_results[k].size(); ++i)
+            max_difference = SMAX(max_difference, ABS(per_particle_results[k][i] - block_results[k][i]));
+        EXPECT_LT(max_difference, 1.0e-12);
+    }
+}
+
+TEST(test_BlockReactionRelaxation, test_aliev_panfilow_model)
+{
+    compareBlockWithPerParticleRelaxation(makeShared<AlievPanfilowModel>(k_a, c_m, k, a, b, mu_1, mu_2, epsilon));
+}
+
+TEST(test_BlockReactionRelaxation, test_derived_model)
+{
+    compareBlockWithPerParticleRelaxation(makeShared<LinearContractionModel>());
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 0.5;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+
+/** the ids, the data and the configurations are consistent with the current capacity */
+void checkBufferConsistency(BaseParticles &particles, InnerRelation &inner, ImplicitInnerRelation &implicit_inner,
+                            const StdVec<Vecd> &position_by_id)
+{
+    size_t bound = particles.real_particles_bound_;
+    EXPECT_EQ(particles.total_ghost_particles_, size_t(0));
+    EXPECT_EQ(particles.pos_.size(), bound);
+    EXPECT_EQ(particles.unsorted_id_.size(), bound);
+    EXPECT_EQ(inner.inner_configuration_.size(), bound);
+    EXPECT_EQ(implicit_inner.neighbor_offset_.size(), bound + 1);
+
+    StdVec<int> id_count(bound, 0);
+    for (size_t i = 0; i != bound; ++i)
+    {
+        size_t id = particles.unsorted_id_[i];
+        ASSERT_LT(id, bound);
+        id_count[id]++;
+        EXPECT_EQ(particles.sorted_id_[id], i);
+    }
+    for (size_t id = 0; id != bound; ++id)
+        EXPECT_EQ(id_count[id], 1);
+
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        EXPECT_EQ(particles.pos_[i], position_by_id[particles.unsorted_id_[i]]);
+
+    inner.updateConfiguration();
+    implicit_inner.updateConfiguration();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        EXPECT_EQ(inner.inner_configuration_[i].current_size_, implicit_inner.NeighborCount(i));
+}
+
+TEST(test_BufferGrowth, test_grow_and_shrink)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, 2.0 * DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    particles.enableBufferGrowth(2.0, 0.25);
+    InnerRelation inner(block);
+    ImplicitInnerRelation implicit_inner(block);
+
+    size_t initial_particles = particles.total_real_particles_;
+    StdVec<Vecd> position_by_id(4 * initial_particles, Vecd::Zero());
+    for (size_t i = 0; i != initial_particles; ++i)
+        position_by_id[particles.unsorted_id_[i]] = particles.pos_[i];
+
+    /** the buffer is grown at the safe point before the cell linked list is updated */
+    block.updateCellLinkedList();
+    EXPECT_GE(Real(particles.real_particles_bound_), 2.0 * Real(initial_particles));
+    checkBufferConsistency(particles, inner, implicit_inner, position_by_id);
+
+    /** the copies are placed above the block, and the buffer is not resized within the step */
+    IndexVector source_indices;
+    for (size_t i = 0; i != initial_particles / 2; ++i)
+        source_indices.push_back(i);
+    size_t bound_before_creation = particles.real_particles_bound_;
+    size_t first_new_index = particles.total_real_particles_;
+    particles.createRealParticlesFrom(source_indices);
+    EXPECT_EQ(particles.real_particles_bound_, bound_before_creation);
+    for (size_t k = 0; k != source_indices.size(); ++k)
+    {
+        size_t index_i = first_new_index + k;
+        particles.pos_[index_i] += Vecd(0.0, DH);
+        position_by_id[particles.unsorted_id_[index_i]] = particles.pos_[index_i];
+    }
+
+    block.updateCellLinkedList();
+    size_t grown_bound = particles.real_particles_bound_;
+    EXPECT_GT(grown_bound, bound_before_creation);
+    EXPECT_GE(Real(grown_bound), 2.0 * Real(particles.total_real_particles_));
+    checkBufferConsistency(particles, inner, implicit_inner, position_by_id);
+
+    /** most particles are deleted, and the buffer is not resized within the step */
+    size_t total_created = particles.total_real_particles_;
+    size_t remaining_front = initial_particles / 5;
+    size_t remaining_back = initial_particles / 10;
+    IndexVector deleted_indices;
+    for (size_t i = remaining_front; i != total_created - remaining_back; ++i)
+        deleted_indices.push_back(i);
+    particles.switchToBufferParticles(deleted_indices);
+    EXPECT_EQ(particles.real_particles_bound_, grown_bound);
+    EXPECT_EQ(particles.total_real_particles_, remaining_front + remaining_back);
+
+    /** the shrunk capacity keeps the unsorted ids of the remaining real particles */
+    block.updateCellLinkedList();
+    EXPECT_LT(particles.real_particles_bound_, grown_bound);
+    EXPECT_EQ(particles.real_particles_bound_, total_created);
+    checkBufferConsistency(particles, inner, implicit_inner, position_by_id);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
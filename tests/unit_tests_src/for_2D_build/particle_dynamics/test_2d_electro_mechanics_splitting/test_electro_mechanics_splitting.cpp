@@ -0,0 +1,189 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real L = 1.0;
+Real H = 0.5;
+Real resolution_ref = H / 20.0;
+BoundingBox system_domain_bounds(Vec2d(-0.1, -0.1), Vec2d(L + 0.1, H + 0.1));
+/** electrophysiology parameters */
+Real diffusion_coeff = 1.0;
+Real bias_coeff = 0.0;
+Real c_m = 1.0;
+Real k = 8.0;
+Real a = 0.15;
+Real b = 0.0;
+Real mu_1 = 0.2;
+Real mu_2 = 0.3;
+Real epsilon = 0.04;
+Real k_a = 1.0e-4;
+/** muscle parameters */
+Real rho0_s = 1.06e-3;
+Real a0[4] = {Real(496.0e-6), Real(15196.0e-6), Real(3283.0e-6), Real(662.0e-6)};
+Real b0[4] = {Real(7.209), Real(20.417), Real(11.176), Real(9.466)};
+Real poisson = 0.4995;
+Real bulk_modulus = 2.0 * a0[0] * (1.0 + poisson) / (3.0 * (1.0 - 2.0 * poisson));
+Vec2d fiber_direction(1.0, 0.0);
+Vec2d sheet_direction(0.0, 1.0);
+/** coupling */
+Real coupling_interval = 0.01;
+int number_of_intervals = 5;
+
+class MuscleBlock : public MultiPolygonShape
+{
+  public:
+    explicit MuscleBlock(const std::string &shape_name) : MultiPolygonShape(shape_name)
+    {
+        std::vector<Vecd> shape;
+        shape.push_back(Vecd(0.0, 0.0));
+        shape.push_back(Vecd(0.0, H));
+        shape.push_back(Vecd(L, H));
+        shape.push_back(Vecd(L, 0.0));
+        shape.push_back(Vecd(0.0, 0.0));
+        multi_polygon_.addAPolygon(shape, ShapeBooleanOps::add);
+    }
+};
+
+class DepolarizationInitialCondition
+    : public electro_physiology::ElectroPhysiologyInitialCondition
+{
+  protected:
+    size_t voltage_;
+
+  public:
+    explicit DepolarizationInitialCondition(SPHBody &sph_body)
+        : electro_physiology::ElectroPhysiologyInitialCondition(sph_body)
+    {
+        voltage_ = particles_->diffusion_reaction_material_.AllSpeciesIndexMap()["Voltage"];
+    };
+
+    void update(size_t index_i, Real dt)
+    {
+        all_species_[voltage_][index_i] = exp(-4.0 * ((pos_[index_i][0] - 1.0) * (pos_[index_i][0] - 1.0) + pos_[index_i][1] * pos_[index_i][1]));
+    };
+};
+
+/** the voltages and the displacements after the coupling intervals, which are advanced
+ *  by the splitting with concurrent sub-problems or by the sequential electrophysiology-then-mechanics loop */
+std::pair<StdLargeVec<Real>, StdLargeVec<Vecd>> runElectroMechanics(bool use_splitting)
+{
+    /** more threads than the arenas are allowed even on a single core, so that the sub-problems run concurrently */
+    SPHSystem sph_system(system_domain_bounds, resolution_ref, 4);
+    SolidBody physiology_body(sph_system, makeShared<MuscleBlock>("PhysiologyBlock"));
+    SharedPtr<AlievPanfilowModel> muscle_reaction_model_ptr = makeShared<AlievPanfilowModel>(k_a, c_m, k, a, b, mu_1, mu_2, epsilon);
+    physiology_body.defineParticlesAndMaterial<ElectroPhysiologyParticles, MonoFieldElectroPhysiology>(
+        muscle_reaction_model_ptr, TypeIdentity<DirectionalDiffusion>(), diffusion_coeff, bias_coeff, fiber_direction);
+    physiology_body.generateParticles<ParticleGeneratorLattice>();
+
+    SolidBody mechanics_body(sph_system, makeShared<MuscleBlock>("MechanicsBlock"));
+    mechanics_body.defineParticlesAndMaterial<ElasticSolidParticles, ActiveMuscle<Muscle>>(
+        rho0_s, bulk_modulus, fiber_direction, sheet_direction, a0, b0);
+    mechanics_body.generateParticles<ParticleGeneratorLattice>();
+
+    InnerRelation physiology_inner(physiology_body);
+    InnerRelation mechanics_inner(mechanics_body);
+    ContactRelation mechanics_contact(mechanics_body, {&physiology_body});
+
+    SimpleDynamics<DepolarizationInitialCondition> initialization(physiology_body);
+    InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration_excitation(physiology_inner);
+    electro_physiology::GetElectroPhysiologyTimeStepSize get_physiology_time_step(physiology_body);
+    electro_physiology::ElectroPhysiologyDiffusionInnerRK2 diffusion_relaxation(physiology_inner);
+    electro_physiology::ElectroPhysiologyReactionRelaxationForward reaction_relaxation_forward(physiology_body);
+    electro_physiology::ElectroPhysiologyReactionRelaxationBackward reaction_relaxation_backward(physiology_body);
+
+    InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration_contraction(mechanics_inner);
+    InteractionDynamics<CorrectInterpolationKernelWeights> correct_kernel_weights_for_interpolation(mechanics_contact);
+    InterpolatingAQuantityByStencil<Real>
+        active_stress_interpolation(mechanics_contact, "ActiveContractionStress", "ActiveContractionStress");
+    ReduceDynamics<solid_dynamics::AcousticTimeStepSize> get_mechanics_time_step(mechanics_body);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> stress_relaxation_first_half(mechanics_inner);
+    Dynamics1Level<solid_dynamics::Integration2ndHalf> stress_relaxation_second_half(mechanics_inner);
+    BodyRegionByParticle muscle_holder(mechanics_body, makeShared<TransformShape<GeometricShapeBox>>(
+                                                           Transform(Vec2d(0.0, 0.5 * H)), Vec2d(0.1 * L, H), "Holder"));
+    SimpleDynamics<solid_dynamics::FixBodyPartConstraint> constraint_holder(muscle_holder);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    initialization.exec();
+    correct_configuration_excitation.exec();
+    correct_configuration_contraction.exec();
+    correct_kernel_weights_for_interpolation.exec();
+
+    /** the steps are limited by the remaining time of the coupling interval */
+    auto electro_physiology_step = [&](Real remaining_time) -> Real
+    {
+        Real dt = SMIN(get_physiology_time_step.exec(), remaining_time);
+        reaction_relaxation_forward.exec(0.5 * dt);
+        diffusion_relaxation.exec(dt);
+        reaction_relaxation_backward.exec(0.5 * dt);
+        return dt;
+    };
+    auto mechanics_step = [&](Real remaining_time) -> Real
+    {
+        Real dt_s = SMIN(get_mechanics_time_step.exec(), remaining_time);
+        stress_relaxation_first_half.exec(dt_s);
+        constraint_holder.exec(dt_s);
+        stress_relaxation_second_half.exec(dt_s);
+        return dt_s;
+    };
+
+    if (use_splitting)
+    {
+        electro_physiology::ElectroMechanicsSplitting
+            electro_mechanics_splitting(active_stress_interpolation, electro_physiology_step, mechanics_step, 2, 2);
+        for (int n = 0; n != number_of_intervals; ++n)
+            electro_mechanics_splitting.advance(coupling_interval);
+        EXPECT_GT(electro_mechanics_splitting.ElectroPhysiologySteps(), size_t(number_of_intervals));
+        EXPECT_GT(electro_mechanics_splitting.MechanicsSteps(), size_t(number_of_intervals));
+    }
+    else
+    {
+        for (int n = 0; n != number_of_intervals; ++n)
+        {
+            active_stress_interpolation.exec();
+            Real electro_physiology_time = 0.0;
+            while (coupling_interval - electro_physiology_time > TinyReal)
+                electro_physiology_time += electro_physiology_step(coupling_interval - electro_physiology_time);
+            Real mechanics_time = 0.0;
+            while (coupling_interval - mechanics_time > TinyReal)
+                mechanics_time += mechanics_step(coupling_interval - mechanics_time);
+        }
+    }
+
+    BaseParticles &physiology_particles = physiology_body.getBaseParticles();
+    StdLargeVec<Real> voltage = *physiology_particles.getVariableByName<Real>("Voltage");
+    voltage.resize(physiology_particles.total_real_particles_);
+    BaseParticles &mechanics_particles = mechanics_body.getBaseParticles();
+    StdLargeVec<Vecd> &pos0 = *mechanics_particles.getVariableByName<Vecd>("InitialPosition");
+    StdLargeVec<Vecd> displacement(mechanics_particles.total_real_particles_);
+    for (size_t i = 0; i != displacement.size(); ++i)
+        displacement[i] = mechanics_particles.pos_[i] - pos0[i];
+    return std::make_pair(voltage, displacement);
+}
+
+TEST(test_ElectroMechanicsSplitting, test_concurrent_sub_problems)
+{
+    std::pair<StdLargeVec<Real>, StdLargeVec<Vecd>> splitting_result = runElectroMechanics(true);
+    std::pair<StdLargeVec<Real>, StdLargeVec<Vecd>> sequential_result = runElectroMechanics(false);
+
+    ASSERT_EQ(splitting_result.first.size(), sequential_result.first.size());
+    for (size_t i = 0; i != splitting_result.first.size(); ++i)
+        EXPECT_NEAR(splitting_result.first[i], sequential_result.first[i], 1.0e-12);
+
+    ASSERT_EQ(splitting_result.second.size(), sequential_result.second.size());
+    Real max_displacement = 0.0;
+    for (size_t i = 0; i != splitting_result.second.size(); ++i)
+    {
+        EXPECT_NEAR((splitting_result.second[i] - sequential_result.second[i]).norm(), 0.0, 1.0e-12);
+        max_displacement = SMAX(max_displacement, splitting_result.second[i].norm());
+    }
+    /** the mechanics is driven by the mapped active stress */
+    EXPECT_GT(max_displacement, 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
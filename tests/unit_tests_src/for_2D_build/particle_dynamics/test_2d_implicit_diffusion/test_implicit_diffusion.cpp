@@ -0,0 +1,183 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real L = 1.0;
+Real H = 0.2;
+Real resolution_ref = H / 10.0;
+BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(L, H));
+Real diffusion_coeff = 1.0e-2;
+Real wave_number = 2.0 * Pi / L;
+Real end_time = 1.0;
+
+class DiffusionMaterial : public DiffusionReaction<Solid>
+{
+  public:
+    DiffusionMaterial() : DiffusionReaction<Solid>({"Phi"}, SharedPtr<NoReaction>())
+    {
+        initializeAnDiffusion<IsotropicDiffusion>("Phi", "Phi", diffusion_coeff);
+    };
+};
+using DiffusionParticles = DiffusionReactionParticles<SolidParticles, DiffusionMaterial>;
+
+/** a sine wave along the periodic length, which decays as exp(-diffusion_coeff * wave_number^2 * t) */
+class SineWaveInitialCondition
+    : public DiffusionReactionInitialCondition<DiffusionParticles>
+{
+  protected:
+    size_t phi_;
+
+  public:
+    explicit SineWaveInitialCondition(SPHBody &sph_body)
+        : DiffusionReactionInitialCondition<DiffusionParticles>(sph_body)
+    {
+        phi_ = particles_->diffusion_reaction_material_.AllSpeciesIndexMap()["Phi"];
+    };
+
+    void update(size_t index_i, Real dt)
+    {
+        all_species_[phi_][index_i] = sin(wave_number * pos_[index_i][0]);
+    };
+};
+
+using DiffusionRelaxationExplicit =
+    DiffusionRelaxationRK2<DiffusionRelaxationInner<DiffusionParticles, CorrectedKernelGradientInner>>;
+
+/** the field at the end time, by the explicit RK2 scheme
+ *  or by the implicit scheme with a time step size of the given times of the explicit one */
+StdLargeVec<Real> runDiffusion(bool use_implicit_diffusion, Real time_step_ratio, StdLargeVec<Real> &position_x)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody diffusion_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                             Transform(Vec2d(0.5 * L, 0.5 * H)), Vec2d(0.5 * L, 0.5 * H), "DiffusionBody"));
+    diffusion_body.defineParticlesAndMaterial<DiffusionParticles, DiffusionMaterial>();
+    diffusion_body.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation diffusion_body_inner(diffusion_body);
+
+    DiffusionRelaxationExplicit explicit_diffusion_relaxation(diffusion_body_inner);
+    DiffusionRelaxationImplicit<DiffusionParticles, CorrectedKernelGradientInner>
+        implicit_diffusion_relaxation(diffusion_body_inner, 1.0e-12);
+    SimpleDynamics<SineWaveInitialCondition> setup_initial_condition(diffusion_body);
+    InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration(diffusion_body_inner);
+    GetDiffusionTimeStepSize<DiffusionParticles> get_time_step_size(diffusion_body);
+    PeriodicConditionUsingCellLinkedList periodic_condition_x(diffusion_body, diffusion_body.getBodyShapeBounds(), xAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition_y(diffusion_body, diffusion_body.getBodyShapeBounds(), yAxis);
+
+    sph_system.initializeSystemCellLinkedLists();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+    sph_system.initializeSystemConfigurations();
+    correct_configuration.exec();
+    setup_initial_condition.exec();
+
+    /** the time step sizes are adjusted so that the end time is reached exactly */
+    Real dt = use_implicit_diffusion ? time_step_ratio * get_time_step_size.exec() : get_time_step_size.exec();
+    size_t number_of_steps = size_t(std::ceil(end_time / dt));
+    dt = end_time / Real(number_of_steps);
+    for (size_t n = 0; n != number_of_steps; ++n)
+        use_implicit_diffusion ? implicit_diffusion_relaxation.exec(dt) : explicit_diffusion_relaxation.exec(dt);
+
+    DiffusionParticles &particles = *DynamicCast<DiffusionParticles>(&diffusion_body, &diffusion_body.getBaseParticles());
+    size_t total_real_particles = particles.total_real_particles_;
+    position_x.resize(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        position_x[i] = particles.pos_[i][0];
+    StdLargeVec<Real> phi = *particles.getVariableByName<Real>("Phi");
+    phi.resize(total_real_particles);
+    return phi;
+}
+
+/** the maximum difference from the analytic profile with the given decay factor */
+Real differenceFromProfile(const StdLargeVec<Real> &phi, const StdLargeVec<Real> &position_x, Real decay_factor)
+{
+    Real difference = 0.0;
+    for (size_t i = 0; i != phi.size(); ++i)
+        difference = SMAX(difference, ABS(phi[i] - decay_factor * sin(wave_number * position_x[i])));
+    return difference;
+}
+
+TEST(test_DiffusionRelaxationImplicit, test_decaying_sine_wave)
+{
+    StdLargeVec<Real> position_x;
+    StdLargeVec<Real> explicit_phi = runDiffusion(false, 1.0, position_x);
+    StdLargeVec<Real> implicit_phi = runDiffusion(true, 1.0, position_x);
+    StdLargeVec<Real> large_step_implicit_phi = runDiffusion(true, 10.0, position_x);
+    ASSERT_EQ(implicit_phi.size(), explicit_phi.size());
+
+    Real analytic_decay = exp(-diffusion_coeff * wave_number * wave_number * end_time);
+    Real explicit_error = differenceFromProfile(explicit_phi, position_x, analytic_decay);
+    Real implicit_error = differenceFromProfile(implicit_phi, position_x, analytic_decay);
+    Real large_step_implicit_error = differenceFromProfile(large_step_implicit_phi, position_x, analytic_decay);
+    Real explicit_implicit_difference = 0.0;
+    for (size_t i = 0; i != explicit_phi.size(); ++i)
+        explicit_implicit_difference = SMAX(explicit_implicit_difference, ABS(implicit_phi[i] - explicit_phi[i]));
+    std::cout << "Errors from the analytic profile of the explicit, implicit and large step implicit schemes: "
+              << explicit_error << ", " << implicit_error << " and " << large_step_implicit_error
+              << ". Difference between the explicit and implicit schemes: " << explicit_implicit_difference << std::endl;
+
+    /** with the same time step size, the first-order implicit scheme is close to the explicit one */
+    EXPECT_LT(explicit_implicit_difference, 5.0e-3);
+    EXPECT_LT(explicit_error, 1.0e-2 * analytic_decay);
+    EXPECT_LT(implicit_error, 1.0e-2 * analytic_decay);
+    /** the implicit scheme is stable and accurate with large time steps */
+    EXPECT_LT(large_step_implicit_error, 3.0e-2 * analytic_decay);
+}
+
+/** the matrix is re-assembled once the configuration is updated, so that the result is the same as a new solver */
+TEST(test_DiffusionRelaxationImplicit, test_reassembly_after_configuration_update)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody diffusion_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                             Transform(Vec2d(0.5 * L, 0.5 * H)), Vec2d(0.5 * L, 0.5 * H), "DiffusionBody"));
+    diffusion_body.defineParticlesAndMaterial<DiffusionParticles, DiffusionMaterial>();
+    diffusion_body.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation diffusion_body_inner(diffusion_body);
+
+    DiffusionRelaxationImplicit<DiffusionParticles, CorrectedKernelGradientInner>
+        implicit_diffusion_relaxation(diffusion_body_inner, 1.0e-12);
+    SimpleDynamics<SineWaveInitialCondition> setup_initial_condition(diffusion_body);
+    InteractionWithUpdate<CorrectedConfigurationInner> correct_configuration(diffusion_body_inner);
+    PeriodicConditionUsingCellLinkedList periodic_condition_x(diffusion_body, diffusion_body.getBodyShapeBounds(), xAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition_y(diffusion_body, diffusion_body.getBodyShapeBounds(), yAxis);
+
+    sph_system.initializeSystemCellLinkedLists();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+    sph_system.initializeSystemConfigurations();
+    correct_configuration.exec();
+    setup_initial_condition.exec();
+    Real dt = 0.01;
+    implicit_diffusion_relaxation.exec(dt);
+
+    /** the particles are shifted slightly and the configuration is updated */
+    DiffusionParticles &particles = *DynamicCast<DiffusionParticles>(&diffusion_body, &diffusion_body.getBaseParticles());
+    size_t total_real_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        particles.pos_[i][1] += 0.1 * resolution_ref * sin(wave_number * particles.pos_[i][0]);
+    size_t configuration_update_count = diffusion_body_inner.ConfigurationUpdateCount();
+    diffusion_body.updateCellLinkedList();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+    diffusion_body_inner.updateConfiguration();
+    EXPECT_EQ(diffusion_body_inner.ConfigurationUpdateCount(), configuration_update_count + 1);
+    correct_configuration.exec();
+
+    StdLargeVec<Real> &phi = *particles.getVariableByName<Real>("Phi");
+    StdLargeVec<Real> phi_before_step = phi;
+    implicit_diffusion_relaxation.exec(dt);
+    StdLargeVec<Real> phi_reassembled = phi;
+
+    phi = phi_before_step;
+    DiffusionRelaxationImplicit<DiffusionParticles, CorrectedKernelGradientInner>
+        new_implicit_diffusion_relaxation(diffusion_body_inner, 1.0e-12);
+    new_implicit_diffusion_relaxation.exec(dt);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        EXPECT_EQ(phi_reassembled[i], phi[i]);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
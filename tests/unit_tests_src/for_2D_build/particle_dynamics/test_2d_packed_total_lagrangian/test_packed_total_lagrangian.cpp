@@ -0,0 +1,97 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.2;              /**< Block height. */
+Real resolution_ref = 0.02; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+Real rho0_s = 1.0e3;
+Real Youngs_modulus = 2.0e6;
+Real poisson = 0.3975;
+Real dt = 1.0e-5;
+size_t number_of_steps = 10;
+
+/** the state of the block after the stress relaxation */
+struct BlockState
+{
+    StdVec<Vecd> pos_, vel_;
+    StdVec<Matd> F_;
+};
+
+/** the block is deformed and relaxed for a few steps, with the given relation and dynamics */
+template <class InnerRelationType, class DeformationGradientType, class Integration1stHalfType, class Integration2ndHalfType>
+BlockState relaxDeformedBlock()
+{
+    BoundingBox system_domain_bounds(Vec2d(-DH, -DH), Vec2d(DL + DH, 2.0 * DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<ElasticSolidParticles, SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelationType block_inner(block);
+
+    InteractionWithUpdate<CorrectedConfigurationInner> corrected_configuration(block_inner);
+    InteractionDynamics<DeformationGradientType> deformation_gradient(block_inner);
+    Dynamics1Level<Integration1stHalfType> stress_relaxation_first_half(block_inner);
+    Dynamics1Level<Integration2ndHalfType> stress_relaxation_second_half(block_inner);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    corrected_configuration.exec();
+
+    ElasticSolidParticles &particles = DynamicCast<ElasticSolidParticles>(&block, block.getBaseParticles());
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Vecd pos = particles.pos_[i];
+        particles.pos_[i] += Vecd(0.02 * pos[1] * pos[0], 0.05 * sin(Pi * pos[0]) * pos[0]);
+        particles.vel_[i] = Vecd(0.0, 0.1 * pos[0] * pos[0]);
+    }
+    deformation_gradient.exec();
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        stress_relaxation_first_half.exec(dt);
+        stress_relaxation_second_half.exec(dt);
+    }
+
+    BlockState state;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        state.pos_.push_back(particles.pos_[i]);
+        state.vel_.push_back(particles.vel_[i]);
+        state.F_.push_back(particles.F_[i]);
+    }
+    return state;
+}
+
+TEST(test_PackedTotalLagrangian, test_packed_vs_generic_dynamics)
+{
+    BlockState generic = relaxDeformedBlock<
+        InnerRelation, solid_dynamics::DeformationGradientBySummation,
+        solid_dynamics::Integration1stHalfPK2, solid_dynamics::Integration2ndHalf>();
+    /** the corrected gradients are packed without an explicit call */
+    BlockState packed = relaxDeformedBlock<
+        TotalLagrangianInnerRelation, solid_dynamics::PackedDeformationGradientBySummation,
+        solid_dynamics::PackedIntegration1stHalf<solid_dynamics::Integration1stHalfPK2>,
+        solid_dynamics::PackedIntegration2ndHalf>();
+
+    ASSERT_EQ(generic.pos_.size(), packed.pos_.size());
+    Real max_vel_difference = 0.0;
+    Real max_F_difference = 0.0;
+    for (size_t i = 0; i != generic.pos_.size(); ++i)
+    {
+        EXPECT_NEAR((generic.pos_[i] - packed.pos_[i]).norm(), 0.0, 1.0e-12);
+        max_vel_difference = SMAX(max_vel_difference, (generic.vel_[i] - packed.vel_[i]).norm());
+        max_F_difference = SMAX(max_F_difference, (generic.F_[i] - packed.F_[i]).norm());
+    }
+    EXPECT_LT(max_vel_difference, 1.0e-8);
+    EXPECT_LT(max_F_difference, 1.0e-10);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
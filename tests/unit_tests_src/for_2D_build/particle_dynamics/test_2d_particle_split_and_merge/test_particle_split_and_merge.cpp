@@ -0,0 +1,138 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;                /**< Block length. */
+Real DH = 0.5;                /**< Block height. */
+Real resolution_ref = 0.025;  /**< Reference particle spacing. */
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+/** the particles are split in the region in the middle of the block,
+ *  and merged afterwards with a region away from the block */
+Vec2d split_region_halfsize = Vec2d(0.2 * DL, 0.3 * DH);
+Vec2d merge_region_translation = Vec2d(3.0 * DL, 3.0 * DH);
+
+/** exposing the merge pairs for checking */
+class SplitAndMergeInParallel : public ParticleSplitAndMergeInParallel
+{
+  public:
+    using ParticleSplitAndMergeInParallel::ParticleSplitAndMergeInParallel;
+    using ParticleSplitAndMergeInParallel::matchMergePairs;
+    StdLargeVec<size_t> &MergePartners() { return partner_; };
+};
+
+/** the criteria of the serial split */
+class SerialSplitCriteria : public ParticleSplitWithPrescribedArea
+{
+  public:
+    using ParticleSplitWithPrescribedArea::ParticleSplitWithPrescribedArea;
+    bool isSplit(size_t index_i) { return splitCriteria(index_i); };
+};
+
+/** the criteria of the serial merge, with the given partner as the only one not yet merged */
+class SerialMergeCriteria : public ParticleMergeWithPrescribedArea
+{
+  public:
+    using ParticleMergeWithPrescribedArea::ParticleMergeWithPrescribedArea;
+    bool isMergePair(size_t index_i, size_t index_j)
+    {
+        tag_merged_.assign(particles_->total_real_particles_, true);
+        tag_merged_[index_j] = false;
+        StdVec<size_t> merge_indices;
+        return mergeCriteria(index_i, merge_indices) && merge_indices[0] == index_j;
+    };
+};
+
+Real totalMass(BaseParticles &particles)
+{
+    Real total_mass = 0.0;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        total_mass += particles.mass_[i];
+    return total_mass;
+}
+
+TEST(test_ParticleSplitAndMergeInParallel, test_serial_criteria)
+{
+    BoundingBox system_domain_bounds(Vec2d(-0.1 * DL, -0.1 * DH), Vec2d(1.1 * DL, 1.1 * DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineAdaptation<ParticleSplitAndMerge>(1.3, 1.0, 1);
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+    block.generateParticles<ParticleGeneratorSplitAndMerge>();
+    AdaptiveInnerRelation block_inner(block);
+    BaseParticles &particles = block.getBaseParticles();
+    Real reference_mass = rho0_f * resolution_ref * resolution_ref;
+
+    TransformShape<GeometricShapeBox> split_region(Transform(block_translation), split_region_halfsize, "SplitRegion");
+    TransformShape<GeometricShapeBox> merge_region(Transform(merge_region_translation), split_region_halfsize, "MergeRegion");
+    SerialSplitCriteria serial_split(block, split_region, 0);
+    SerialMergeCriteria serial_merge(block_inner, merge_region);
+    SplitAndMergeInParallel parallel_split(block_inner, split_region, particles.total_real_particles_);
+    SplitAndMergeInParallel parallel_merge(block_inner, merge_region, 0);
+    block.updateCellLinkedList();
+    block_inner.updateConfiguration();
+
+    /** splitting */
+    size_t particles_before_split = particles.total_real_particles_;
+    Real mass_before_split = totalMass(particles);
+    StdVec<bool> is_split(particles_before_split);
+    size_t number_of_expected_splits = 0;
+    for (size_t i = 0; i != particles_before_split; ++i)
+    {
+        is_split[i] = serial_split.isSplit(i);
+        number_of_expected_splits += is_split[i] ? 1 : 0;
+    }
+    ASSERT_GT(number_of_expected_splits, size_t(0));
+
+    size_t number_of_splits = parallel_split.splitParticles();
+    EXPECT_EQ(number_of_splits, number_of_expected_splits);
+    EXPECT_EQ(particles.total_real_particles_, particles_before_split + number_of_splits);
+    EXPECT_NEAR(totalMass(particles), mass_before_split, 1.0e-12 * mass_before_split);
+    for (size_t i = 0; i != particles_before_split; ++i)
+        EXPECT_NEAR(particles.mass_[i], is_split[i] ? 0.5 * reference_mass : reference_mass, 1.0e-12 * reference_mass);
+    for (size_t i = particles_before_split; i != particles.total_real_particles_; ++i)
+        EXPECT_NEAR(particles.mass_[i], 0.5 * reference_mass, 1.0e-12 * reference_mass);
+
+    /** merging, with the split particles now outside the region */
+    block.updateCellLinkedList();
+    block_inner.updateConfiguration();
+    size_t particles_before_merge = particles.total_real_particles_;
+    Real mass_before_merge = totalMass(particles);
+    size_t number_of_pairs = parallel_merge.matchMergePairs();
+    ASSERT_GT(number_of_pairs, size_t(0));
+
+    StdLargeVec<size_t> &partners = parallel_merge.MergePartners();
+    size_t number_of_paired_particles = 0;
+    for (size_t i = 0; i != particles_before_merge; ++i)
+    {
+        size_t j = partners[i];
+        /** the pairs do not overlap */
+        EXPECT_EQ(partners[j], i);
+        if (j != i)
+        {
+            number_of_paired_particles++;
+            EXPECT_TRUE(serial_merge.isMergePair(i, j) || serial_merge.isMergePair(j, i))
+                << "pair " << i << " " << j;
+        }
+    }
+    EXPECT_EQ(number_of_paired_particles, 2 * number_of_pairs);
+
+    size_t number_of_merged_pairs = parallel_merge.mergeParticles();
+    EXPECT_EQ(number_of_merged_pairs, number_of_pairs);
+    EXPECT_EQ(particles.total_real_particles_, particles_before_merge - number_of_pairs);
+    EXPECT_NEAR(totalMass(particles), mass_before_merge, 1.0e-12 * mass_before_merge);
+    size_t number_of_reference_particles = 0;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        number_of_reference_particles += ABS(particles.mass_[i] - reference_mass) < 1.0e-12 * reference_mass ? 1 : 0;
+    EXPECT_EQ(number_of_reference_particles, particles_before_split - number_of_splits + number_of_pairs);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
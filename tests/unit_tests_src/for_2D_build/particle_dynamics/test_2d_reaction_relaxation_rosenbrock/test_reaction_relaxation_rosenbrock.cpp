@@ -0,0 +1,108 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+/** the decay rates, of which the fast one is stiff for the time step sizes used */
+Real k_fast = 1.0e4;
+Real k_slow = 1.0;
+Real end_time = 1.0;
+
+/**
+ * The linear decay chain A -> B -> C, i.e. dA/dt = -k_fast A,
+ * dB/dt = k_fast A - k_slow B and dC/dt = k_slow B, which has an analytic solution.
+ */
+class StiffDecayChain : public BaseReactionModel<3>
+{
+  public:
+    StiffDecayChain() : BaseReactionModel<3>({"A", "B", "C"})
+    {
+        reaction_model_ = "StiffDecayChain";
+        get_production_rates_.push_back([](LocalSpecies &species)
+                                        { return 0.0; });
+        get_production_rates_.push_back([](LocalSpecies &species)
+                                        { return k_fast * species[0]; });
+        get_production_rates_.push_back([](LocalSpecies &species)
+                                        { return k_slow * species[1]; });
+        get_loss_rates_.push_back([](LocalSpecies &species)
+                                  { return k_fast; });
+        get_loss_rates_.push_back([](LocalSpecies &species)
+                                  { return k_slow; });
+        get_loss_rates_.push_back([](LocalSpecies &species)
+                                  { return 0.0; });
+    };
+};
+
+class DecayChainMaterial : public DiffusionReaction<Solid, 3>
+{
+  public:
+    DecayChainMaterial() : DiffusionReaction<Solid, 3>({"A", "B", "C"}, makeShared<StiffDecayChain>()){};
+};
+using DecayChainParticles = DiffusionReactionParticles<SolidParticles, DecayChainMaterial>;
+
+/** the initial amount of A varies among the particles, and is scaled linearly in the solution */
+Real initialAmount(size_t index_i) { return 1.0 + 0.1 * Real(index_i % 7); }
+
+Vec3d analyticSolution(Real initial_amount, Real time)
+{
+    Real a = exp(-k_fast * time);
+    Real b = k_fast / (k_slow - k_fast) * (exp(-k_fast * time) - exp(-k_slow * time));
+    return initial_amount * Vec3d(a, b, 1.0 - a - b);
+}
+
+/** the maximum error of all species and particles at the end time */
+Real errorOfRosenbrock(Real dt)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<DecayChainParticles, DecayChainMaterial>();
+    block.generateParticles<ParticleGeneratorLattice>();
+    DecayChainParticles &particles = *DynamicCast<DecayChainParticles>(&block, &block.getBaseParticles());
+    StdVec<StdLargeVec<Real> *> &species = particles.ReactiveSpecies();
+    size_t total_real_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        (*species[0])[i] = initialAmount(i);
+        (*species[1])[i] = 0.0;
+        (*species[2])[i] = 0.0;
+    }
+
+    ReactionRelaxationRosenbrock<DecayChainParticles> reaction_relaxation(block);
+    size_t number_of_steps = size_t(std::round(end_time / dt));
+    for (size_t n = 0; n != number_of_steps; ++n)
+        reaction_relaxation.exec(dt);
+
+    Real error = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vec3d solution = analyticSolution(initialAmount(i), end_time);
+        for (size_t k = 0; k != 3; ++k)
+            error = SMAX(error, ABS((*species[k])[i] - solution[k]));
+    }
+    return error;
+}
+
+/** the time steps are 100 and 50 times of the stiff time scale,
+ *  which are still accurate and show second-order convergence */
+TEST(test_ReactionRelaxationRosenbrock, test_stiff_decay_chain)
+{
+    Real dt = 0.01;
+    Real error_coarse = errorOfRosenbrock(dt);
+    Real error_fine = errorOfRosenbrock(0.5 * dt);
+    std::cout << "Errors with time step sizes " << dt << " and " << 0.5 * dt << ": "
+              << error_coarse << " and " << error_fine << std::endl;
+    EXPECT_LT(error_coarse, 2.0e-4);
+    EXPECT_GT(error_coarse / error_fine, 3.5);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;              /**< Block length. */
+Real DH = 1.0;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Real rho0_s = 1000.0;
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+/** the left, middle and right parts of the block, each driven by a mobilized body */
+StdVec<Vec2d> part_translations = {Vec2d(0.25 * DL, 0.5 * DH), Vec2d(0.5 * DL, 0.5 * DH), Vec2d(0.75 * DL, 0.5 * DH)};
+Vec2d part_halfsize = Vec2d(0.1 * DL, 0.4 * DH);
+
+/** the forces applied together are the same as those reduced for the body parts one by one,
+ *  with the parallel and the sequenced execution policies */
+TEST(test_TotalForcesForSimBody, test_forces_on_parts)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<SolidParticles, Solid>(rho0_s);
+    block.generateParticles<ParticleGeneratorLattice>();
+    SolidParticles &particles = *DynamicCast<SolidParticles>(this, &block.getBaseParticles());
+    /** the accelerations are varied in space, so that there are torques as well */
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Vecd &position = particles.pos_[i];
+        particles.acc_[i] = Vecd(sin(3.0 * position[0]), cos(2.0 * position[1]));
+        particles.acc_prior_[i] = Vecd(position[1], -0.5 * position[0]);
+    }
+
+    StdVec<SharedPtr<SolidBodyPartForSimbody>> parts;
+    for (size_t k = 0; k != part_translations.size(); ++k)
+        parts.push_back(makeShared<SolidBodyPartForSimbody>(
+            block, makeShared<TransformShape<GeometricShapeBox>>(
+                       Transform(part_translations[k]), part_halfsize, "Part" + std::to_string(k))));
+
+    SimTK::MultibodySystem MBsystem;
+    SimTK::SimbodyMatterSubsystem matter(MBsystem);
+    SimTK::GeneralForceSubsystem forces(MBsystem);
+    StdVec<SharedPtr<SimTK::Body::Rigid>> part_infos;
+    StdVec<SharedPtr<SimTK::MobilizedBody::Planar>> part_mobods;
+    for (size_t k = 0; k != parts.size(); ++k)
+    {
+        part_infos.push_back(makeShared<SimTK::Body::Rigid>(*parts[k]->body_part_mass_properties_));
+        part_mobods.push_back(makeShared<SimTK::MobilizedBody::Planar>(
+            matter.Ground(), SimTK::Transform(SimTKVec3(part_translations[k][0], part_translations[k][1], 0.0)),
+            *part_infos[k], SimTK::Transform(SimTKVec3(0.0))));
+    }
+    SimTK::Force::DiscreteForces force_on_bodies(forces, matter);
+    SimTK::State state = MBsystem.realizeTopology();
+    SimTK::RungeKuttaMersonIntegrator integ(MBsystem);
+    integ.setAccuracy(1e-3);
+    integ.setAllowInterpolation(false);
+    integ.initialize(state);
+
+    StdVec<BodyPartByParticle *> body_parts;
+    StdVec<SimTK::MobilizedBody *> mobods;
+    for (size_t k = 0; k != parts.size(); ++k)
+    {
+        body_parts.push_back(parts[k].get());
+        mobods.push_back(part_mobods[k].get());
+    }
+    solid_dynamics::TotalForcesForSimBody<> forces_on_parts(body_parts, mobods, MBsystem, force_on_bodies, integ);
+    forces_on_parts.exec();
+    StdVec<SimTK::SpatialVec> &total_forces = forces_on_parts.TotalForces();
+    ASSERT_EQ(total_forces.size(), parts.size());
+    solid_dynamics::TotalForcesForSimBody<execution::SequencedPolicy>
+        sequenced_forces_on_parts(body_parts, mobods, MBsystem, force_on_bodies, integ);
+    sequenced_forces_on_parts.exec();
+    StdVec<SimTK::SpatialVec> &sequenced_total_forces = sequenced_forces_on_parts.TotalForces();
+
+    const SimTK::Vector_<SimTK::SpatialVec> &applied_forces = force_on_bodies.getAllBodyForces(integ.getAdvancedState());
+    for (size_t k = 0; k != parts.size(); ++k)
+    {
+        ReduceDynamics<solid_dynamics::TotalForceOnBodyPartForSimBody>
+            force_on_part(*parts[k], MBsystem, *part_mobods[k], integ);
+        SimTK::SpatialVec force = force_on_part.exec();
+        SimTK::SpatialVec applied_force = applied_forces[part_mobods[k]->getMobilizedBodyIndex()];
+        for (int n = 0; n != 2; ++n)
+            for (int d = 0; d != 3; ++d)
+            {
+                Real tolerance = 1.0e-10 * (1.0 + std::abs(force[n][d]));
+                EXPECT_NEAR(total_forces[k][n][d], force[n][d], tolerance);
+                EXPECT_NEAR(sequenced_total_forces[k][n][d], force[n][d], tolerance);
+                EXPECT_NEAR(applied_force[n][d], force[n][d], tolerance);
+            }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
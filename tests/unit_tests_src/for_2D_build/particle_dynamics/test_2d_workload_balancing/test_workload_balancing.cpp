@@ -0,0 +1,104 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;                          /**< Block length. */
+Real DH = 1.0;                          /**< Block height. */
+Real resolution_ref = 0.01;             /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+Real compression = 0.25;                /**< Ratio of the finest spacing to the reference one. */
+size_t number_of_workers = 8;
+
+/** the ratio between the largest and the average workload of the contiguous ranges given by the bounds */
+Real workloadImbalance(const StdLargeVec<size_t> &weights, const IndexVector &bounds)
+{
+    size_t total_weight = 0;
+    size_t max_weight = 0;
+    for (size_t k = 0; k != bounds.size() - 1; ++k)
+    {
+        size_t range_weight = 0;
+        for (size_t i = bounds[k]; i != bounds[k + 1]; ++i)
+            range_weight += weights[i];
+        total_weight += range_weight;
+        max_weight = SMAX(max_weight, range_weight);
+    }
+    return Real(max_weight) * Real(bounds.size() - 1) / Real(total_weight);
+}
+
+/** the particles are compressed towards the left end of the block, so that the spacing
+ *  varies from a quarter to 1.75 times of the reference one, as in a multi-resolution case,
+ *  and the ranges with equal numbers of particles have very different neighbor counts */
+TEST(test_WorkloadBalancing, test_variable_resolution)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    StdLargeVec<Vecd> &pos = particles.pos_;
+    StdLargeVec<Real> &Vol = particles.Vol_;
+    size_t total_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        Real x = pos[i][0] / DL;
+        Vol[i] *= compression + 2.0 * (1.0 - compression) * x;
+        pos[i][0] = DL * x * (compression + (1.0 - compression) * x);
+    }
+    block.setWorkloadBalancing(number_of_workers);
+    InnerRelation block_inner(block);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    StdLargeVec<size_t> weights(total_particles);
+    for (size_t i = 0; i != total_particles; ++i)
+        weights[i] = 1 + block_inner.inner_configuration_[i].current_size_;
+    IndexVector even_bounds(number_of_workers + 1);
+    for (size_t k = 0; k != number_of_workers + 1; ++k)
+        even_bounds[k] = k * total_particles / number_of_workers;
+    WorkloadBalancedRange &balanced_range = block.LoopRange();
+    ASSERT_TRUE(balanced_range.isBalanced());
+    Real even_imbalance = workloadImbalance(weights, even_bounds);
+    Real balanced_imbalance = workloadImbalance(weights, balanced_range.ChunkBounds());
+
+    /** a neighbor summation with the even and the balanced partition */
+    size_t repetitions = 20;
+    StdLargeVec<Real> even_sigma(total_particles), balanced_sigma(total_particles);
+    auto summation = [&](StdLargeVec<Real> &sigma, size_t index_i)
+    {
+        Real sigma_i = 0.0;
+        const Neighborhood &inner_neighborhood = block_inner.inner_configuration_[index_i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            sigma_i += inner_neighborhood.W_ij_[n] * Vol[inner_neighborhood.j_[n]];
+        sigma[index_i] = sigma_i;
+    };
+    TickCount t1 = TickCount::now();
+    for (size_t k = 0; k != repetitions; ++k)
+        particle_for(execution::ParallelPolicy(), total_particles,
+                     [&](size_t index_i)
+                     { summation(even_sigma, index_i); });
+    TickCount t2 = TickCount::now();
+    for (size_t k = 0; k != repetitions; ++k)
+        particle_for(execution::ParallelPolicy(), balanced_range,
+                     [&](size_t index_i)
+                     { summation(balanced_sigma, index_i); });
+    TickCount t3 = TickCount::now();
+
+    std::cout << "Workload imbalance with " << number_of_workers << " workers: even partition "
+              << even_imbalance << ", balanced partition " << balanced_imbalance << ". "
+              << "Wall time: even partition " << (t2 - t1).seconds() << " seconds, balanced partition "
+              << (t3 - t2).seconds() << " seconds." << std::endl;
+
+    EXPECT_LT(balanced_imbalance, even_imbalance);
+    EXPECT_LT(balanced_imbalance, 1.05);
+    EXPECT_EQ(even_sigma, balanced_sigma);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;                          /**< Block length. */
+Real DH = 1.0;                          /**< Block height. */
+Real resolution_ref = 0.005;            /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+
+/** compare the summations with the recomputed pair data with those with the stored ones
+ *  and report the memory footprint and the wall time of both */
+TEST(test_ImplicitInnerRelation, test_summations)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    StdLargeVec<Vecd> &pos = block.getBaseParticles().pos_;
+    for (size_t i = 0; i != pos.size(); ++i)
+        pos[i] += 0.2 * resolution_ref * Vecd::Random();
+    block.updateCellLinkedList();
+
+    InnerRelation stored_inner(block);
+    ImplicitInnerRelation implicit_inner(block);
+    stored_inner.updateConfiguration();
+    implicit_inner.updateConfiguration();
+    KernelWendlandC2 &kernel = DynamicCast<KernelWendlandC2>(this, *block.sph_adaptation_->getKernel());
+
+    size_t total_particles = pos.size();
+    StdLargeVec<Real> stored_sigma(total_particles), implicit_sigma(total_particles);
+    StdLargeVec<Vecd> stored_gradient(total_particles), implicit_gradient(total_particles);
+    TickCount t1 = TickCount::now();
+    particle_for(execution::ParallelPolicy(), total_particles,
+                 [&](size_t index_i)
+                 {
+                     Real sigma = 0.0;
+                     Vecd gradient = Vecd::Zero();
+                     const Neighborhood &inner_neighborhood = stored_inner.inner_configuration_[index_i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         sigma += inner_neighborhood.W_ij_[n];
+                         gradient += inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                     }
+                     stored_sigma[index_i] = sigma;
+                     stored_gradient[index_i] = gradient;
+                 });
+    TickCount t2 = TickCount::now();
+    particle_for(execution::ParallelPolicy(), total_particles,
+                 [&](size_t index_i)
+                 {
+                     Real sigma = 0.0;
+                     Vecd gradient = Vecd::Zero();
+                     ImplicitNeighborhood<KernelWendlandC2> inner_neighborhood = implicit_inner.getNeighborhood(index_i, kernel);
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         ImplicitNeighbor neighbor = inner_neighborhood[n];
+                         sigma += neighbor.W_ij_;
+                         gradient += neighbor.dW_ijV_j_ * neighbor.e_ij_;
+                     }
+                     implicit_sigma[index_i] = sigma;
+                     implicit_gradient[index_i] = gradient;
+                 });
+    TickCount t3 = TickCount::now();
+
+    size_t stored_bytes = 0;
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        const Neighborhood &neighborhood = stored_inner.inner_configuration_[i];
+        stored_bytes += neighborhood.allocated_size_ * (sizeof(size_t) + 3 * sizeof(NeighborReal) + sizeof(NeighborVecd));
+    }
+    std::cout << "Stored neighbors: " << stored_bytes << " bytes, " << (t2 - t1).seconds() << " seconds. "
+              << "Implicit neighbors: " << implicit_inner.MemoryFootprint() << " bytes, " << (t3 - t2).seconds() << " seconds." << std::endl;
+
+    /** the stored neighbor data are in NeighborReal, i.e. in float for the mixed-precision build,
+     *  and the gradient is a sum of the terms in the order of the inverse particle spacing */
+    Real tolerance = SMAX(1.0e-10, 10.0 * std::numeric_limits<NeighborReal>::epsilon());
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        EXPECT_EQ(implicit_inner.neighbor_offset_[i + 1] - implicit_inner.neighbor_offset_[i],
+                  stored_inner.inner_configuration_[i].current_size_);
+        EXPECT_NEAR(implicit_sigma[i], stored_sigma[i], tolerance * stored_sigma[i]);
+        EXPECT_LE((implicit_gradient[i] - stored_gradient[i]).norm(), 1.0e2 * tolerance * (stored_gradient[i].norm() + 1.0 / resolution_ref));
+    }
+}
+
+/** the density summation with the implicit relation gives the same density as that with the stored configuration */
+TEST(test_ImplicitInnerRelation, test_density_summation)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, 10.0 * resolution_ref);
+    FluidBody stored_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                           Transform(block_translation), block_halfsize, "StoredBlock"));
+    stored_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    stored_block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody implicit_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                             Transform(block_translation), block_halfsize, "ImplicitBlock"));
+    implicit_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    implicit_block.generateParticles<ParticleGeneratorLattice>();
+    StdLargeVec<Vecd> &stored_pos = stored_block.getBaseParticles().pos_;
+    StdLargeVec<Vecd> &implicit_pos = implicit_block.getBaseParticles().pos_;
+    ASSERT_EQ(stored_pos.size(), implicit_pos.size());
+    for (size_t i = 0; i != stored_pos.size(); ++i)
+    {
+        stored_pos[i] += 2.0 * resolution_ref * Vecd(sin(7.0 * stored_pos[i][1]), cos(5.0 * stored_pos[i][0]));
+        implicit_pos[i] = stored_pos[i];
+    }
+    InnerRelation stored_inner(stored_block);
+    ImplicitInnerRelation implicit_inner(implicit_block);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> stored_density_summation(stored_inner);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationImplicitInner<KernelWendlandC2>>
+        implicit_density_summation(implicit_inner);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    StdLargeVec<Real> &stored_rho = stored_block.getBaseParticles().rho_;
+    StdLargeVec<Real> &implicit_rho = implicit_block.getBaseParticles().rho_;
+    stored_density_summation.exec();
+    implicit_density_summation.exec();
+
+    Real tolerance = SMAX(1.0e-10, 10.0 * std::numeric_limits<NeighborReal>::epsilon());
+    for (size_t i = 0; i != stored_rho.size(); ++i)
+        EXPECT_NEAR(implicit_rho[i], stored_rho[i], tolerance * stored_rho[i]);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+/** the displacement of all particles in each step, by which they cross the periodic bounds in both directions */
+Vecd displacement = Vecd(0.45, -0.3) * resolution_ref;
+size_t number_of_steps = 40;
+
+/** the neighbors of each particle, sorted by the neighbor index */
+using NeighborLists = StdVec<StdVec<std::pair<size_t, Real>>>;
+
+NeighborLists sortedNeighborLists(InnerRelation &inner_relation, size_t total_real_particles)
+{
+    NeighborLists neighbor_lists(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Neighborhood &neighborhood = inner_relation.inner_configuration_[i];
+        for (size_t n = 0; n != neighborhood.current_size_; ++n)
+            neighbor_lists[i].push_back(std::make_pair(neighborhood.j_[n], Real(neighborhood.r_ij_[n])));
+        std::sort(neighbor_lists[i].begin(), neighbor_lists[i].end());
+    }
+    return neighbor_lists;
+}
+
+/** the periodic images are inserted into the cell linked list after it is updated */
+void updateCellLinkedList(RealBody &body, PeriodicConditionUsingCellLinkedList &periodic_condition_x,
+                          PeriodicConditionUsingCellLinkedList &periodic_condition_y)
+{
+    periodic_condition_x.bounding_.exec();
+    periodic_condition_y.bounding_.exec();
+    body.updateCellLinkedList();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+}
+
+/** the periodic images are found by the neighbor search directly */
+void updateCellLinkedList(RealBody &body, PeriodicConditionUsingVirtualCellOffset &periodic_condition_x,
+                          PeriodicConditionUsingVirtualCellOffset &periodic_condition_y)
+{
+    periodic_condition_x.bounding_.exec();
+    periodic_condition_y.bounding_.exec();
+    body.updateCellLinkedList();
+}
+
+/** the neighbor lists and positions at each step, with periodic conditions in both directions */
+template <class PeriodicConditionType>
+StdVec<NeighborLists> periodicNeighborLists(StdVec<StdLargeVec<Vecd>> &positions, Real &cutoff_radius)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation block_inner(block);
+    cutoff_radius = block.sph_adaptation_->getKernel()->CutOffRadius();
+    PeriodicConditionType periodic_condition_x(block, block.getBodyShapeBounds(), xAxis);
+    PeriodicConditionType periodic_condition_y(block, block.getBodyShapeBounds(), yAxis);
+
+    BaseParticles &particles = block.getBaseParticles();
+    StdLargeVec<Vecd> &pos = particles.pos_;
+    size_t total_real_particles = particles.total_real_particles_;
+    /** the perturbations are the same for both periodic conditions
+     *  and avoid the neighbors exactly at the cutoff radius */
+    for (size_t i = 0; i != total_real_particles; ++i)
+        pos[i] += 0.2 * resolution_ref * Vecd(sin(12.9898 * Real(i)), cos(78.233 * Real(i)));
+
+    StdVec<NeighborLists> neighbor_lists;
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        for (size_t i = 0; i != total_real_particles; ++i)
+            pos[i] += step == 0 ? Vecd::Zero() : displacement;
+        updateCellLinkedList(block, periodic_condition_x, periodic_condition_y);
+        block_inner.updateConfiguration();
+        positions.push_back(pos);
+        neighbor_lists.push_back(sortedNeighborLists(block_inner, total_real_particles));
+    }
+    return neighbor_lists;
+}
+
+/** the neighbor lists and positions at each step, with the periodic condition using ghost particles in both directions */
+StdVec<NeighborLists> ghostNeighborLists(StdVec<StdLargeVec<Vecd>> &positions)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation block_inner(block);
+    MultiAxisPeriodicConditionUsingGhostParticles periodic_condition(block, block.getBodyShapeBounds(), {xAxis, yAxis});
+
+    BaseParticles &particles = block.getBaseParticles();
+    StdLargeVec<Vecd> &pos = particles.pos_;
+    size_t total_real_particles = particles.total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        pos[i] += 0.2 * resolution_ref * Vecd(sin(12.9898 * Real(i)), cos(78.233 * Real(i)));
+
+    StdVec<NeighborLists> neighbor_lists;
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        for (size_t i = 0; i != total_real_particles; ++i)
+            pos[i] += step == 0 ? Vecd::Zero() : displacement;
+        periodic_condition.bounding_.exec();
+        block.updateCellLinkedList();
+        periodic_condition.ghost_creation_.exec();
+        periodic_condition.ghost_update_.exec();
+        block_inner.updateConfiguration();
+        positions.push_back(pos);
+        neighbor_lists.push_back(sortedNeighborLists(block_inner, total_real_particles));
+    }
+    return neighbor_lists;
+}
+
+/** the distance to the nearest periodic image */
+Real periodicDistance(const Vecd &pos_i, const Vecd &pos_j)
+{
+    Vecd displacement = pos_i - pos_j;
+    displacement[0] -= DL * std::round(displacement[0] / DL);
+    displacement[1] -= DH * std::round(displacement[1] / DH);
+    return displacement.norm();
+}
+
+TEST(test_PeriodicNeighborSearch, test_virtual_cell_offset)
+{
+    StdVec<StdLargeVec<Vecd>> positions, reference_positions;
+    Real cutoff_radius = 0.0;
+    StdVec<NeighborLists> neighbor_lists =
+        periodicNeighborLists<PeriodicConditionUsingVirtualCellOffset>(positions, cutoff_radius);
+    StdVec<NeighborLists> reference_neighbor_lists =
+        periodicNeighborLists<PeriodicConditionUsingCellLinkedList>(reference_positions, cutoff_radius);
+
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        ASSERT_EQ(neighbor_lists[step].size(), reference_neighbor_lists[step].size());
+        size_t total_real_particles = neighbor_lists[step].size();
+        size_t neighbors_across_bounds = 0;
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Vecd &pos_i = positions[step][i];
+            /** both periodic conditions wrap the particles in the same way */
+            EXPECT_LT((pos_i - reference_positions[step][i]).norm(), 1.0e-12);
+            EXPECT_TRUE(pos_i[0] >= 0.0 && pos_i[0] <= DL && pos_i[1] >= 0.0 && pos_i[1] <= DH);
+
+            StdVec<std::pair<size_t, Real>> &neighbors = neighbor_lists[step][i];
+            StdVec<std::pair<size_t, Real>> &reference_neighbors = reference_neighbor_lists[step][i];
+            ASSERT_EQ(neighbors.size(), reference_neighbors.size()) << "step " << step << " particle " << i;
+            for (size_t n = 0; n != neighbors.size(); ++n)
+            {
+                size_t j = neighbors[n].first;
+                EXPECT_EQ(j, reference_neighbors[n].first);
+                EXPECT_NEAR(neighbors[n].second, reference_neighbors[n].second, 1.0e-6 * resolution_ref);
+                EXPECT_NEAR(neighbors[n].second, periodicDistance(pos_i, positions[step][j]), 1.0e-6 * resolution_ref);
+                neighbors_across_bounds += (pos_i - positions[step][j]).norm() > cutoff_radius ? 1 : 0;
+            }
+
+            /** all neighbors within the cutoff radius by the nearest periodic images */
+            size_t number_of_neighbors = 0;
+            for (size_t j = 0; j != total_real_particles; ++j)
+                number_of_neighbors += j != i && periodicDistance(pos_i, positions[step][j]) < cutoff_radius ? 1 : 0;
+            EXPECT_EQ(neighbors.size(), number_of_neighbors) << "step " << step << " particle " << i;
+        }
+        EXPECT_GT(neighbors_across_bounds, size_t(0));
+    }
+}
+
+TEST(test_PeriodicNeighborSearch, test_multi_axis_ghost_particles)
+{
+    StdVec<StdLargeVec<Vecd>> positions, reference_positions;
+    Real cutoff_radius = 0.0;
+    StdVec<NeighborLists> neighbor_lists = ghostNeighborLists(positions);
+    StdVec<NeighborLists> reference_neighbor_lists =
+        periodicNeighborLists<PeriodicConditionUsingCellLinkedList>(reference_positions, cutoff_radius);
+
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        ASSERT_EQ(neighbor_lists[step].size(), reference_neighbor_lists[step].size());
+        size_t total_real_particles = neighbor_lists[step].size();
+        size_t corner_ghost_neighbors = 0;
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Vecd &pos_i = positions[step][i];
+            EXPECT_LT((pos_i - reference_positions[step][i]).norm(), 1.0e-12);
+
+            /** the neighbors are the ghosts across the bounds, also those at the corners, so that only the distances are compared */
+            StdVec<std::pair<size_t, Real>> &neighbors = neighbor_lists[step][i];
+            StdVec<std::pair<size_t, Real>> &reference_neighbors = reference_neighbor_lists[step][i];
+            ASSERT_EQ(neighbors.size(), reference_neighbors.size()) << "step " << step << " particle " << i;
+            StdVec<Real> distances, reference_distances;
+            for (size_t n = 0; n != neighbors.size(); ++n)
+            {
+                size_t j = neighbors[n].first;
+                Vecd &pos_j = positions[step][j];
+                distances.push_back(neighbors[n].second);
+                reference_distances.push_back(reference_neighbors[n].second);
+                EXPECT_NEAR(neighbors[n].second, (pos_i - pos_j).norm(), 1.0e-6 * resolution_ref);
+                bool is_outside_x = pos_j[0] < 0.0 || pos_j[0] > DL;
+                bool is_outside_y = pos_j[1] < 0.0 || pos_j[1] > DH;
+                corner_ghost_neighbors += is_outside_x && is_outside_y ? 1 : 0;
+            }
+            std::sort(distances.begin(), distances.end());
+            std::sort(reference_distances.begin(), reference_distances.end());
+            for (size_t n = 0; n != distances.size(); ++n)
+                EXPECT_NEAR(distances[n], reference_distances[n], 1.0e-6 * resolution_ref);
+        }
+        EXPECT_GT(corner_ghost_neighbors, size_t(0));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
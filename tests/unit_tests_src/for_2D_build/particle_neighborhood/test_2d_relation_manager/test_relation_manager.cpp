@@ -0,0 +1,95 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;              /**< Block length. */
+Real DH = 1.0;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+Vec2d plate_halfsize = Vec2d(0.4, 0.3);
+/** the positions of the left side of the plate, by which the plate is partly overlapping,
+ *  inside or away from the extended bounds of the block */
+StdVec<Real> plate_left_positions = {1.8, 0.6, 3.2, 1.0, 1.8, 0.2, 0.6, 3.2};
+
+/** the neighbors within the cutoff radius, counted by brute force */
+size_t countNeighbors(const Vecd &pos_i, StdLargeVec<Vecd> &pos, size_t total_real_particles, Real cutoff_radius)
+{
+    size_t count = 0;
+    for (size_t j = 0; j != total_real_particles; ++j)
+        if ((pos_i - pos[j]).norm() < cutoff_radius)
+            count++;
+    return count;
+}
+
+/** the configurations are updated alternately by the relation manager and by the contact relation itself,
+ *  i.e. with and without the broad phase, while the contact body moves */
+TEST(test_RelationManager, test_alternating_updates)
+{
+    BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(4.5, 1.5));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(Vec2d(plate_left_positions[0] + plate_halfsize[0], 0.5 * DH)), plate_halfsize, "Plate"));
+    plate.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    plate.generateParticles<ParticleGeneratorLattice>();
+
+    BaseParticles &block_particles = block.getBaseParticles();
+    BaseParticles &plate_particles = plate.getBaseParticles();
+    StdLargeVec<Vecd> &block_pos = block_particles.pos_;
+    StdLargeVec<Vecd> &plate_pos = plate_particles.pos_;
+    /** the perturbations avoid the neighbors exactly at the cutoff radius */
+    for (size_t i = 0; i != block_particles.total_real_particles_; ++i)
+        block_pos[i] += 0.2 * resolution_ref * Vecd::Random();
+    for (size_t i = 0; i != plate_particles.total_real_particles_; ++i)
+        plate_pos[i] += 0.2 * resolution_ref * Vecd::Random();
+
+    InnerRelation block_inner(block);
+    ContactRelation block_contact(block, {&plate});
+    RelationManager block_relations({&block_inner, &block_contact});
+    Real cutoff_radius = block.sph_adaptation_->getKernel()->CutOffRadius();
+
+    for (size_t step = 0; step != plate_left_positions.size(); ++step)
+    {
+        Real shift = plate_left_positions[step] - plate_left_positions[step == 0 ? 0 : step - 1];
+        for (size_t i = 0; i != plate_particles.total_real_particles_; ++i)
+            plate_pos[i][0] += shift;
+        block.updateCellLinkedList();
+        plate.updateCellLinkedList();
+
+        if (step % 2 == 0)
+        {
+            block_inner.updateConfiguration();
+            block_contact.updateConfiguration();
+        }
+        else
+        {
+            block_relations.updateConfigurations();
+        }
+
+        size_t total_contact_neighbors = 0;
+        for (size_t i = 0; i != block_particles.total_real_particles_; ++i)
+        {
+            size_t contact_neighbors = countNeighbors(block_pos[i], plate_pos, plate_particles.total_real_particles_, cutoff_radius);
+            EXPECT_EQ(block_contact.contact_configuration_[0][i].current_size_, contact_neighbors)
+                << "step " << step << " particle " << i;
+            /** the particle itself is not an inner neighbor */
+            size_t inner_neighbors = countNeighbors(block_pos[i], block_pos, block_particles.total_real_particles_, cutoff_radius) - 1;
+            EXPECT_EQ(block_inner.inner_configuration_[i].current_size_, inner_neighbors)
+                << "step " << step << " particle " << i;
+            total_contact_neighbors += contact_neighbors;
+        }
+        /** the plate is away from the block only at the given position */
+        EXPECT_EQ(total_contact_neighbors == 0, plate_left_positions[step] > DL + cutoff_radius);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;                          /**< Block length. */
+Real DH = 1.0;                          /**< Block height. */
+Real resolution_ref = 0.005;            /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+
+/** compare the neighbors found by the stencil search with those by the particle search and report the rebuild time */
+TEST(test_StencilNeighborSearch, test_inner_relation)
+{
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(DL, DH));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    /** perturbed positions so that the distances are not on the lattice */
+    StdLargeVec<Vecd> &pos = block.getBaseParticles().pos_;
+    for (size_t i = 0; i != pos.size(); ++i)
+        pos[i] += 0.2 * resolution_ref * Vecd::Random();
+    block.updateCellLinkedList();
+
+    InnerRelation particle_search_inner(block);
+    InnerRelation stencil_search_inner(block);
+    stencil_search_inner.useStencilSearch();
+    size_t number_of_rebuilds = 10;
+    TickCount t1 = TickCount::now();
+    for (size_t k = 0; k != number_of_rebuilds; ++k)
+        particle_search_inner.updateConfiguration();
+    TickCount t2 = TickCount::now();
+    for (size_t k = 0; k != number_of_rebuilds; ++k)
+        stencil_search_inner.updateConfiguration();
+    TickCount t3 = TickCount::now();
+    std::cout << "Inner relation rebuild: particle search " << (t2 - t1).seconds()
+              << " seconds, stencil search " << (t3 - t2).seconds() << " seconds." << std::endl;
+
+    /** the neighbor data are stored in NeighborReal, i.e. in float for the mixed-precision build */
+    Real tolerance = SMAX(1.0e-12, 10.0 * std::numeric_limits<NeighborReal>::epsilon());
+    for (size_t i = 0; i != pos.size(); ++i)
+    {
+        Neighborhood &expected = particle_search_inner.inner_configuration_[i];
+        Neighborhood &result = stencil_search_inner.inner_configuration_[i];
+        ASSERT_EQ(result.current_size_, expected.current_size_);
+        for (size_t n = 0; n != expected.current_size_; ++n)
+        {
+            EXPECT_EQ(result.j_[n], expected.j_[n]);
+            EXPECT_NEAR(result.W_ij_[n], expected.W_ij_[n], tolerance * expected.W_ij_[n]);
+            EXPECT_NEAR(result.dW_ijV_j_[n], expected.dW_ijV_j_[n], tolerance * std::abs(expected.dW_ijV_j_[n]));
+            EXPECT_NEAR(result.r_ij_[n], expected.r_ij_[n], tolerance * resolution_ref);
+            EXPECT_LE((result.e_ij_[n] - expected.e_ij_[n]).norm(), tolerance);
+        }
+    }
+}
+
+/** the periodic images are inserted into the cell linked list after it is updated */
+void updateCellLinkedList(RealBody &body, PeriodicConditionUsingCellLinkedList &periodic_condition_x,
+                          PeriodicConditionUsingCellLinkedList &periodic_condition_y)
+{
+    periodic_condition_x.bounding_.exec();
+    periodic_condition_y.bounding_.exec();
+    body.updateCellLinkedList();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+}
+
+/** the periodic images are found by the neighbor search directly */
+void updateCellLinkedList(RealBody &body, PeriodicConditionUsingVirtualCellOffset &periodic_condition_x,
+                          PeriodicConditionUsingVirtualCellOffset &periodic_condition_y)
+{
+    periodic_condition_x.bounding_.exec();
+    periodic_condition_y.bounding_.exec();
+    body.updateCellLinkedList();
+}
+
+/** the particles move across the periodic bounds in both directions, and the stencil cell data,
+ *  which are copied once for each update of the cell linked list, give the same neighbors as the particle search */
+template <class PeriodicConditionType>
+void testPeriodicStencilSearch()
+{
+    Real periodic_resolution_ref = 0.05;
+    Vecd displacement = Vecd(0.45, -0.3) * periodic_resolution_ref;
+    size_t number_of_steps = 20;
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), periodic_resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation particle_search_inner(block);
+    InnerRelation stencil_search_inner(block);
+    stencil_search_inner.useStencilSearch();
+    PeriodicConditionType periodic_condition_x(block, block.getBodyShapeBounds(), xAxis);
+    PeriodicConditionType periodic_condition_y(block, block.getBodyShapeBounds(), yAxis);
+
+    StdLargeVec<Vecd> &pos = block.getBaseParticles().pos_;
+    size_t total_real_particles = block.getBaseParticles().total_real_particles_;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        pos[i] += 0.2 * periodic_resolution_ref * Vecd::Random();
+
+    Real tolerance = SMAX(1.0e-12, 10.0 * std::numeric_limits<NeighborReal>::epsilon());
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        for (size_t i = 0; i != total_real_particles; ++i)
+            pos[i] += displacement;
+        updateCellLinkedList(block, periodic_condition_x, periodic_condition_y);
+        particle_search_inner.updateConfiguration();
+        /** the second search reuses the stencil cell data of the first one */
+        stencil_search_inner.updateConfiguration();
+        stencil_search_inner.updateConfiguration();
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Neighborhood &expected = particle_search_inner.inner_configuration_[i];
+            Neighborhood &result = stencil_search_inner.inner_configuration_[i];
+            ASSERT_EQ(result.current_size_, expected.current_size_) << "step " << step << " particle " << i;
+            for (size_t n = 0; n != expected.current_size_; ++n)
+            {
+                EXPECT_EQ(result.j_[n], expected.j_[n]);
+                EXPECT_NEAR(result.r_ij_[n], expected.r_ij_[n], tolerance * periodic_resolution_ref);
+            }
+        }
+    }
+}
+
+TEST(test_StencilNeighborSearch, test_periodic_cell_linked_list)
+{
+    testPeriodicStencilSearch<PeriodicConditionUsingCellLinkedList>();
+}
+
+TEST(test_StencilNeighborSearch, test_periodic_virtual_cell_offset)
+{
+    testPeriodicStencilSearch<PeriodicConditionUsingVirtualCellOffset>();
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+/** the plate overlaps the right part of the block */
+Vec2d plate_halfsize = Vec2d(0.3, 0.3);
+Vec2d plate_translation = Vec2d(DL, 0.5 * DH);
+
+/** the contact neighbors and their kernel values are the same as evaluated directly by the kernel */
+template <class KernelType, typename... ConstructorArgs>
+void testContactNeighbors(ConstructorArgs &&...args)
+{
+    BoundingBox system_domain_bounds(Vec2d(-0.5, -0.5), Vec2d(2.0, 1.0));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.sph_adaptation_->resetKernel<KernelType>(args...);
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    FluidBody plate(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(plate_translation), plate_halfsize, "Plate"));
+    plate.sph_adaptation_->resetKernel<KernelType>(args...);
+    plate.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    plate.generateParticles<ParticleGeneratorLattice>();
+
+    BaseParticles &block_particles = block.getBaseParticles();
+    BaseParticles &plate_particles = plate.getBaseParticles();
+    /** the perturbations avoid the neighbors exactly at the cutoff radius */
+    for (size_t i = 0; i != block_particles.total_real_particles_; ++i)
+        block_particles.pos_[i] += 0.2 * resolution_ref * Vecd::Random();
+    for (size_t i = 0; i != plate_particles.total_real_particles_; ++i)
+        plate_particles.pos_[i] += 0.2 * resolution_ref * Vecd::Random();
+
+    ContactRelation block_contact(block, {&plate});
+    sph_system.initializeSystemCellLinkedLists();
+    block_contact.updateConfiguration();
+
+    Kernel &kernel = *plate.sph_adaptation_->getKernel();
+    Real cutoff_radius = kernel.CutOffRadius();
+    Real tolerance = 1.0e-10 * kernel.W0(Vec2d(Vec2d::Zero()));
+    size_t total_contact_neighbors = 0;
+    for (size_t i = 0; i != block_particles.total_real_particles_; ++i)
+    {
+        Neighborhood &neighborhood = block_contact.contact_configuration_[0][i];
+        size_t contact_neighbors = 0;
+        for (size_t j = 0; j != plate_particles.total_real_particles_; ++j)
+            if ((block_particles.pos_[i] - plate_particles.pos_[j]).norm() < cutoff_radius)
+                contact_neighbors++;
+        EXPECT_EQ(neighborhood.current_size_, contact_neighbors) << "particle " << i;
+        total_contact_neighbors += neighborhood.current_size_;
+
+        for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        {
+            size_t index_j = neighborhood.j_[n];
+            Vecd displacement = block_particles.pos_[i] - plate_particles.pos_[index_j];
+            Real distance = displacement.norm();
+            EXPECT_NEAR(neighborhood.r_ij_[n], distance, 1.0e-12 * resolution_ref);
+            EXPECT_NEAR(neighborhood.W_ij_[n], kernel.W(distance, displacement), tolerance);
+            EXPECT_NEAR(neighborhood.dW_ijV_j_[n], kernel.dW(distance, displacement) * plate_particles.Vol_[index_j],
+                        tolerance * resolution_ref);
+        }
+    }
+    EXPECT_GT(total_contact_neighbors, size_t(0));
+}
+
+TEST(test_TypedContactRelation, test_KernelWendlandC2)
+{
+    testContactNeighbors<KernelWendlandC2>();
+}
+
+TEST(test_TypedContactRelation, test_KernelCubicBSpline)
+{
+    testContactNeighbors<KernelCubicBSpline>();
+}
+
+/** a kernel without the typed neighbor builder, for which the generic one is used */
+TEST(test_TypedContactRelation, test_KernelTabulated)
+{
+    testContactNeighbors<KernelTabulated<KernelWendlandC2>>(20);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
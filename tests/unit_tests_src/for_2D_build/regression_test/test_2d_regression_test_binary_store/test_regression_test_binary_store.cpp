@@ -0,0 +1,122 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;              /**< Block length. */
+Real DH = 0.5;              /**< Block height. */
+Real resolution_ref = 0.05; /**< Reference particle spacing. */
+Vec2d block_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+Vec2d block_translation = block_halfsize;
+size_t number_of_records = 50;
+size_t number_of_runs = 3;
+size_t number_of_reductions = 0;
+
+/** the density summation, which counts the reductions */
+class CountedDensitySummation : public QuantitySummation<Real>
+{
+  public:
+    explicit CountedDensitySummation(SPHBody &sph_body) : QuantitySummation<Real>(sph_body, "Density"){};
+    virtual ~CountedDensitySummation(){};
+
+    virtual void setupDynamics(Real dt = 0.0) override { number_of_reductions++; };
+};
+
+/** the uniform density of a record, which differs slightly among the runs */
+Real recordDensity(size_t record, size_t run)
+{
+    return 1.0 + 0.1 * sin(0.3 * Real(record)) + 1.0e-4 * Real(run);
+}
+
+/** one run records the observed and the summed density and updates the data base,
+ *  or tests the result against the data base; the time-averaged mean values of this run are returned */
+StdVec<Real> runCase(size_t run, bool is_test)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), resolution_ref);
+    IOEnvironment io_environment(sph_system);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    ObserverBody probes(sph_system, "Probes");
+    probes.generateParticles<ObserverParticleGenerator>(StdVec<Vecd>{Vecd(0.3, 0.2), Vecd(0.6, 0.3)});
+    ContactRelation probes_contact(probes, {&block});
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    RegressionTestBinaryStore<ObservedQuantityRecording<Real>>
+        write_probe_density("Density", io_environment, probes_contact);
+    RegressionTestBinaryStore<ReducedQuantityRecording<ReduceDynamics<CountedDensitySummation>>>
+        write_total_density(io_environment, block);
+
+    BaseParticles &particles = block.getBaseParticles();
+    size_t total_real_particles = particles.total_real_particles_;
+    StdVec<Real> meanvalue(3, 0.0);
+    for (size_t n = 0; n != number_of_records; ++n)
+    {
+        GlobalStaticVariables::physical_time_ = 0.1 * Real(n);
+        for (size_t i = 0; i != total_real_particles; ++i)
+            particles.rho_[i] = recordDensity(n, run);
+        write_probe_density.writeToFile(n);
+        write_total_density.writeToFile(n);
+        meanvalue[0] += (*write_probe_density.getObservedQuantity())[0] / Real(number_of_records);
+        meanvalue[1] += (*write_probe_density.getObservedQuantity())[1] / Real(number_of_records);
+        meanvalue[2] += Real(total_real_particles) * recordDensity(n, run) / Real(number_of_records);
+    }
+
+    if (is_test)
+    {
+        write_probe_density.testResultByTimeAverage();
+        write_total_density.testResultByTimeAverage();
+    }
+    else
+    {
+        write_probe_density.generateDataBaseByTimeAverage(0.1, 0.1);
+        write_total_density.generateDataBaseByTimeAverage(0.1, 0.1);
+    }
+    return meanvalue;
+}
+
+TEST(test_RegressionTestBinaryStore, test_time_average)
+{
+    fs::remove_all("./input");
+    StdVec<Real> expected_meanvalue(3, 0.0);
+    for (size_t run = 0; run != number_of_runs; ++run)
+    {
+        StdVec<Real> meanvalue = runCase(run, false);
+        for (size_t k = 0; k != meanvalue.size(); ++k)
+            expected_meanvalue[k] += meanvalue[k] / Real(number_of_runs);
+    }
+    /** the reduced quantity is stored without another reduction */
+    EXPECT_EQ(number_of_reductions, number_of_runs * number_of_records);
+
+    for (size_t run = 0; run != number_of_runs; ++run)
+        EXPECT_TRUE(fs::exists("./input/Block_DensitySummation_Run_" + std::to_string(run) + "_result.bin"));
+    std::ifstream runtimes_file("./input/Block_DensitySummation_binary_runtimes.dat");
+    std::string converged;
+    int number_of_run = 0;
+    runtimes_file >> converged >> number_of_run;
+    EXPECT_EQ(converged, "false");
+    EXPECT_EQ(number_of_run, int(number_of_runs) + 1);
+
+    /** the data base is the average of the time-averaged mean values of all runs */
+    BinaryObservationReader probe_database("./input/Probes_Density_time_averaged_mean_variance.bin");
+    BinaryObservationReader total_database("./input/Block_DensitySummation_time_averaged_mean_variance.bin");
+    ASSERT_EQ(probe_database.NumberOfObservations(), size_t(2));
+    ASSERT_EQ(total_database.NumberOfObservations(), size_t(1));
+    StdVec<Real> probe_mean, total_mean;
+    ASSERT_TRUE(probe_database.readRecord(probe_mean));
+    ASSERT_TRUE(total_database.readRecord(total_mean));
+    EXPECT_NEAR(probe_mean[1], expected_meanvalue[0], 1.0e-10 * expected_meanvalue[0]);
+    EXPECT_NEAR(probe_mean[2], expected_meanvalue[1], 1.0e-10 * expected_meanvalue[1]);
+    EXPECT_NEAR(total_mean[1], expected_meanvalue[2], 1.0e-10 * expected_meanvalue[2]);
+
+    /** a run with the same records as the first one passes the test */
+    runCase(0, true);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
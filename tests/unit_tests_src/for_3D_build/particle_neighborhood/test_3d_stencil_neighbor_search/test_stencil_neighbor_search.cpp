@@ -0,0 +1,64 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 2.0;                          /**< Block length. */
+Real DH = 1.0;                          /**< Block height. */
+Real DW = 0.5;                          /**< Block width. */
+Real resolution_ref = 0.02;             /**< Reference particle spacing. */
+Vec3d block_halfsize = Vec3d(0.5 * DL, 0.5 * DH, 0.5 * DW);
+Vec3d block_translation = block_halfsize;
+
+/** compare the neighbors found by the stencil search with those by the particle search and report the rebuild time */
+TEST(test_StencilNeighborSearch, test_inner_relation)
+{
+    BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DH, DW));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(
+                                    Transform(block_translation), block_halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    block.generateParticles<ParticleGeneratorLattice>();
+    /** perturbed positions so that the distances are not on the lattice */
+    StdLargeVec<Vecd> &pos = block.getBaseParticles().pos_;
+    for (size_t i = 0; i != pos.size(); ++i)
+        pos[i] += 0.2 * resolution_ref * Vecd::Random();
+    block.updateCellLinkedList();
+
+    InnerRelation particle_search_inner(block);
+    InnerRelation stencil_search_inner(block);
+    stencil_search_inner.useStencilSearch();
+    size_t number_of_rebuilds = 10;
+    TickCount t1 = TickCount::now();
+    for (size_t k = 0; k != number_of_rebuilds; ++k)
+        particle_search_inner.updateConfiguration();
+    TickCount t2 = TickCount::now();
+    for (size_t k = 0; k != number_of_rebuilds; ++k)
+        stencil_search_inner.updateConfiguration();
+    TickCount t3 = TickCount::now();
+    std::cout << "Inner relation rebuild: particle search " << (t2 - t1).seconds()
+              << " seconds, stencil search " << (t3 - t2).seconds() << " seconds." << std::endl;
+
+    /** the neighbor data are stored in NeighborReal, i.e. in float for the mixed-precision build */
+    Real tolerance = SMAX(1.0e-12, 10.0 * std::numeric_limits<NeighborReal>::epsilon());
+    for (size_t i = 0; i != pos.size(); ++i)
+    {
+        Neighborhood &expected = particle_search_inner.inner_configuration_[i];
+        Neighborhood &result = stencil_search_inner.inner_configuration_[i];
+        ASSERT_EQ(result.current_size_, expected.current_size_);
+        for (size_t n = 0; n != expected.current_size_; ++n)
+        {
+            EXPECT_EQ(result.j_[n], expected.j_[n]);
+            EXPECT_NEAR(result.W_ij_[n], expected.W_ij_[n], tolerance * expected.W_ij_[n]);
+            EXPECT_NEAR(result.dW_ijV_j_[n], expected.dW_ijV_j_[n], tolerance * std::abs(expected.dW_ijV_j_[n]));
+            EXPECT_NEAR(result.r_ij_[n], expected.r_ij_[n], tolerance * resolution_ref);
+            EXPECT_LE((result.e_ij_[n] - expected.e_ij_[n]).norm(), tolerance);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
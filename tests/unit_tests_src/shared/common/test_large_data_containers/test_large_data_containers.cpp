@@ -0,0 +1,60 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+
+/** the large data are zero initialized and grow across the threshold from small data */
+TEST(test_large_data_containers, test_first_touch_allocation)
+{
+    LargeDataAllocation::parallel_first_touch_ = true;
+    LargeDataAllocation::use_huge_pages_ = true;
+
+    StdLargeVec<Real> data(10, 1.0);
+    size_t large_size = 4 * LargeDataAllocation::large_data_bytes_ / sizeof(Real) + 3;
+    data.resize(large_size, 0.0);
+    EXPECT_EQ(data[9], 1.0);
+    EXPECT_EQ(data[10], 0.0);
+    EXPECT_EQ(data[large_size - 1], 0.0);
+    data.resize(10 * large_size, 2.0);
+    EXPECT_EQ(data[0], 1.0);
+    EXPECT_EQ(data.back(), 2.0);
+
+    /** all pages of the large data are touched at allocation */
+    NumaTopology numa_topology;
+    StdVec<std::pair<void *, size_t>> regions;
+    regions.push_back(std::make_pair(data.data(), data.capacity() * sizeof(Real)));
+    StdVec<size_t> bytes_on_nodes = memoryPlacementOnNodes(numa_topology, regions);
+    if (!bytes_on_nodes.empty())
+    {
+        EXPECT_EQ(bytes_on_nodes.size(), numa_topology.number_of_nodes_ + 1);
+        EXPECT_EQ(bytes_on_nodes.back(), size_t(0));
+    }
+
+    LargeDataAllocation::parallel_first_touch_ = false;
+    LargeDataAllocation::use_huge_pages_ = false;
+}
+
+/** the NUMA-aware mode is set back when the system is destroyed */
+TEST(test_large_data_containers, test_numa_awareness_reset)
+{
+    {
+        SPHSystem sph_system(BoundingBox(Vecd::Zero(), Vecd::Ones()), 0.1);
+        sph_system.setNumaAwareness(true, true);
+        EXPECT_TRUE(LargeDataAllocation::parallel_first_touch_);
+        EXPECT_TRUE(LargeDataAllocation::use_huge_pages_);
+
+        size_t large_size = 4 * LargeDataAllocation::large_data_bytes_ / sizeof(Real);
+        StdLargeVec<Real> data(large_size, 1.0);
+        Real sum = particle_reduce(execution::ParallelPolicy(), large_size, Real(0), ReduceSum<Real>(),
+                                   [&](size_t i) -> Real
+                                   { return data[i]; });
+        EXPECT_EQ(sum, Real(large_size));
+    }
+    EXPECT_FALSE(LargeDataAllocation::parallel_first_touch_);
+    EXPECT_FALSE(LargeDataAllocation::use_huge_pages_);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
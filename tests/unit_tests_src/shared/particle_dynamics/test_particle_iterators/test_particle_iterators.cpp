@@ -0,0 +1,88 @@
+#include "base_local_dynamics.h"
+#include "particle_iterators.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(particle_iterators, particle_scan)
+{
+    StdLargeVec<size_t> input(1000, 1);
+    StdLargeVec<size_t> output(input.size());
+    EXPECT_EQ(input.size(), particle_scan(par, input, output));
+    for (size_t i = 0; i != output.size(); ++i)
+    {
+        EXPECT_EQ(i, output[i]);
+    }
+
+    /** a shorter output is enlarged, and a longer one keeps its extra entries */
+    StdLargeVec<size_t> sequenced_output;
+    EXPECT_EQ(input.size(), particle_scan(seq, input, sequenced_output));
+    EXPECT_EQ(output, sequenced_output);
+    StdLargeVec<size_t> row_offsets(input.size() + 1, input.size());
+    EXPECT_EQ(input.size(), particle_scan(par, input, row_offsets));
+    EXPECT_EQ(input.size() + 1, row_offsets.size());
+    EXPECT_EQ(input.size(), row_offsets.back());
+}
+
+TEST(particle_iterators, particle_compact)
+{
+    StdLargeVec<size_t> marks(1000, 0);
+    for (size_t i = 0; i < marks.size(); i += 3)
+    {
+        marks[i] = 1;
+    }
+
+    StdLargeVec<size_t> offsets;
+    IndexVector sequenced_compacted, parallel_compacted;
+    particle_compact(seq, marks, offsets, sequenced_compacted,
+                     [&](size_t i)
+                     { return i; });
+    particle_compact(par, marks, offsets, parallel_compacted,
+                     [&](size_t i)
+                     { return i; });
+
+    EXPECT_EQ(size_t(334), parallel_compacted.size());
+    EXPECT_EQ(sequenced_compacted, parallel_compacted);
+    for (size_t k = 0; k != parallel_compacted.size(); ++k)
+    {
+        EXPECT_EQ(3 * k, parallel_compacted[k]);
+    }
+}
+
+TEST(particle_iterators, workload_balanced_range)
+{
+    size_t total_real_particles = 1000;
+    WorkloadBalancedRange balanced_range;
+    balanced_range.setTotalRealParticles(total_real_particles);
+    EXPECT_FALSE(balanced_range.isBalanced());
+
+    IndexVector &chunk_bounds = balanced_range.ChunkBounds();
+    chunk_bounds = {0, 10, 100, 101, 600, 1000};
+    EXPECT_TRUE(balanced_range.isBalanced());
+
+    StdLargeVec<size_t> visits(total_real_particles, 0);
+    particle_for(par, balanced_range,
+                 [&](size_t i)
+                 { visits[i] += 1; });
+    EXPECT_EQ(visits, StdLargeVec<size_t>(total_real_particles, 1));
+    size_t sum = particle_reduce(par, balanced_range, size_t(0), ReduceSum<size_t>(),
+                                 [&](size_t i) -> size_t
+                                 { return i; });
+    EXPECT_EQ(total_real_particles * (total_real_particles - 1) / 2, sum);
+
+    /** the outdated chunks are not used after the number of particles is changed */
+    total_real_particles = 500;
+    EXPECT_FALSE(balanced_range.isBalanced());
+    sum = particle_reduce(par, balanced_range, size_t(0), ReduceSum<size_t>(),
+                          [&](size_t i) -> size_t
+                          { return i; });
+    EXPECT_EQ(total_real_particles * (total_real_particles - 1) / 2, sum);
+}
+
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
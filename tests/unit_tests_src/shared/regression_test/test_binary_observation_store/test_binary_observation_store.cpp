@@ -0,0 +1,121 @@
+#include "binary_observation_store.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** observation series with a phase shift and different lengths */
+void writeStore(const std::string &file_name, size_t number_of_records, Real phase)
+{
+    size_t number_of_observations = 3;
+    BinaryObservationWriter store(file_name, number_of_observations, 2);
+    for (size_t n = 0; n != number_of_records; ++n)
+    {
+        Real time = Real(n) * 0.01;
+        StdVec<Real> values;
+        for (size_t i = 0; i != number_of_observations; ++i)
+        {
+            values.push_back(sin(10.0 * time + phase + Real(i)));
+            values.push_back(cos(5.0 * time + Real(i)));
+        }
+        store.appendRecord(time, values);
+    }
+}
+
+/** dynamic time warping with the full matrix and the same locality constraint */
+Real fullDTWDistance(const BiVector<Real> &a, const BiVector<Real> &b, size_t offset, int window_size)
+{
+    int a_length = a.size();
+    int b_length = b.size();
+    window_size = SMAX(window_size, ABS(a_length - b_length));
+    BiVector<Real> distance(a_length, StdVec<Real>(b_length, Infinity));
+    for (int i = 0; i != a_length; ++i)
+        for (int j = SMAX(0, i - window_size); j <= SMIN(b_length - 1, i + window_size); ++j)
+        {
+            Real p_norm = sqrt(pow(a[i][offset] - b[j][offset], 2) + pow(a[i][offset + 1] - b[j][offset + 1], 2));
+            Real previous = 0.0;
+            if (i != 0 || j != 0)
+            {
+                previous = Infinity;
+                if (i > 0)
+                    previous = SMIN(previous, distance[i - 1][j]);
+                if (j > 0)
+                    previous = SMIN(previous, distance[i][j - 1]);
+                if (i > 0 && j > 0)
+                    previous = SMIN(previous, distance[i - 1][j - 1]);
+            }
+            distance[i][j] = p_norm + previous;
+        }
+    return distance[a_length - 1][b_length - 1];
+}
+
+BiVector<Real> readAllRecords(BinaryObservationReader &store)
+{
+    BiVector<Real> records(store.NumberOfRecords());
+    store.rewind();
+    for (size_t n = 0; n != records.size(); ++n)
+        store.readRecord(records[n]);
+    return records;
+}
+
+TEST(test_BinaryObservationStore, test_StreamingDTWDistance)
+{
+    writeStore("store_a.bin", 200, 0.0);
+    writeStore("store_b.bin", 190, 0.1);
+    BinaryObservationReader store_a("store_a.bin");
+    BinaryObservationReader store_b("store_b.bin");
+    EXPECT_EQ(store_a.NumberOfRecords(), 200);
+    EXPECT_EQ(store_b.NumberOfRecords(), 190);
+
+    StdVec<Real> dtw_distance = streamingDTWDistance(store_a, store_b, 5);
+    BiVector<Real> records_a = readAllRecords(store_a);
+    BiVector<Real> records_b = readAllRecords(store_b);
+    for (size_t i = 0; i != store_a.NumberOfObservations(); ++i)
+        EXPECT_NEAR(dtw_distance[i], fullDTWDistance(records_a, records_b, 1 + 2 * i, 5), 1.0e-10);
+}
+
+TEST(test_BinaryObservationStore, test_StreamingAverages)
+{
+    writeStore("store_a.bin", 200, 0.0);
+    writeStore("store_b.bin", 190, 0.1);
+    BinaryObservationReader store_a("store_a.bin");
+    BinaryObservationReader store_b("store_b.bin");
+
+    StdVec<Real> meanvalue, variance;
+    streamingTimeAverage(store_a, 0.5, meanvalue, variance);
+    BiVector<Real> records_a = readAllRecords(store_a);
+    for (size_t k = 0; k != meanvalue.size(); ++k)
+    {
+        Real sum = 0.0, squared_sum = 0.0;
+        size_t count = 0;
+        for (size_t n = 0; n != records_a.size(); ++n)
+            if (records_a[n][0] >= 0.5)
+            {
+                sum += records_a[n][k + 1];
+                squared_sum += pow(records_a[n][k + 1], 2);
+                count++;
+            }
+        Real mean = sum / Real(count);
+        EXPECT_NEAR(meanvalue[k], mean, 1.0e-12);
+        EXPECT_NEAR(variance[k], squared_sum / Real(count) - mean * mean, 1.0e-12);
+    }
+
+    {
+        BinaryObservationWriter ensemble_mean("ensemble_mean.bin", 3, 2);
+        BinaryObservationWriter ensemble_variance("ensemble_variance.bin", 3, 2);
+        streamingEnsembleAverage({&store_a, &store_b}, ensemble_mean, ensemble_variance);
+    }
+    BinaryObservationReader ensemble_mean("ensemble_mean.bin");
+    EXPECT_EQ(ensemble_mean.NumberOfRecords(), 190);
+    StdVec<Real> record, record_a, record_b;
+    ensemble_mean.readRecord(100, record);
+    store_a.readRecord(100, record_a);
+    store_b.readRecord(100, record_b);
+    for (size_t k = 1; k != record.size(); ++k)
+        EXPECT_NEAR(record[k], 0.5 * (record_a[k] + record_b[k]), 1.0e-12);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** distances within the cut-off radius */
+StdLargeVec<Real> generateDistances(Kernel &kernel, size_t number_of_pairs)
+{
+    StdLargeVec<Real> distances(number_of_pairs);
+    for (size_t n = 0; n != number_of_pairs; ++n)
+        distances[n] = 0.5 * (Real(rand()) / Real(RAND_MAX)) * kernel.CutOffRadius();
+    return distances;
+}
+
+/** the combined evaluation shares the computation, so that it differs from the separated one by round-off */
+void testAnalyticKernel(Kernel &kernel)
+{
+    StdLargeVec<Real> distances = generateDistances(kernel, 10000);
+    Real tolerance = 10.0 * std::numeric_limits<Real>::epsilon() * kernel.W0(ZeroVecd);
+    for (size_t n = 0; n != distances.size(); ++n)
+    {
+        Real W_ij, dW_ij;
+        kernel.WdW(distances[n], ZeroVecd, W_ij, dW_ij);
+        EXPECT_NEAR(W_ij, kernel.W(distances[n], ZeroVecd), tolerance);
+        EXPECT_NEAR(dW_ij, kernel.dW(distances[n], ZeroVecd), tolerance);
+    }
+}
+
+TEST(test_FusedKernelEvaluation, test_AnalyticKernel)
+{
+    KernelWendlandC2 wendland_kernel(1.0);
+    testAnalyticKernel(wendland_kernel);
+    KernelCubicBSpline cubic_spline_kernel(1.0);
+    testAnalyticKernel(cubic_spline_kernel);
+}
+
+TEST(test_FusedKernelEvaluation, test_TabulatedKernel)
+{
+    KernelTabulated<KernelWendlandC2> kernel(1.0, 100);
+    KernelWendlandC2 original_kernel(1.0);
+    size_t number_of_pairs = 1000000;
+    StdLargeVec<Real> distances = generateDistances(kernel, number_of_pairs);
+    StdLargeVec<Real> W(number_of_pairs), dW(number_of_pairs), block_W(number_of_pairs), block_dW(number_of_pairs);
+
+    TickCount t1 = TickCount::now();
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        W[n] = kernel.W(distances[n], ZeroVecd);
+        dW[n] = kernel.dW(distances[n], ZeroVecd);
+    }
+    TickCount t2 = TickCount::now();
+    kernel.WdW(number_of_pairs, distances.data(), block_W.data(), block_dW.data(), ZeroVecd);
+    TickCount t3 = TickCount::now();
+    std::cout << "Separated evaluation " << (t2 - t1).seconds()
+              << " seconds, fused block evaluation " << (t3 - t2).seconds() << " seconds." << std::endl;
+
+    Real W0 = kernel.W0(ZeroVecd);
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        Real W_ij, dW_ij;
+        kernel.WdW(distances[n], ZeroVecd, W_ij, dW_ij);
+        /** all evaluations use the same table */
+        EXPECT_EQ(W_ij, block_W[n]);
+        EXPECT_EQ(dW_ij, block_dW[n]);
+        EXPECT_EQ(W_ij, W[n]);
+        EXPECT_EQ(dW_ij, dW[n]);
+        EXPECT_NEAR(W_ij, original_kernel.W(distances[n], ZeroVecd), 1.0e-4 * W0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
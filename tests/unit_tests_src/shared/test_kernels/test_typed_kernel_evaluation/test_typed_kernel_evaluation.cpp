@@ -0,0 +1,69 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** the typed kernel evaluation gives the same values as the virtual one */
+template <class KernelType>
+void testTypedKernelEvaluation()
+{
+    KernelType typed_kernel(1.0);
+    Kernel *kernel = &typed_kernel;
+    size_t number_of_pairs = 10000;
+    StdLargeVec<Vecd> displacements(number_of_pairs);
+    StdLargeVec<Real> distances(number_of_pairs);
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        displacements[n] = Vecd::Random();
+        distances[n] = SMIN(displacements[n].norm(), kernel->CutOffRadius());
+    }
+
+    StdLargeVec<Real> W(number_of_pairs), dW(number_of_pairs), typed_W(number_of_pairs), typed_dW(number_of_pairs);
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        W[n] = kernel->W(distances[n], displacements[n]);
+        dW[n] = kernel->dW(distances[n], displacements[n]);
+    }
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        typed_W[n] = typed_kernel.template typedW<KernelType>(distances[n], displacements[n]);
+        typed_dW[n] = typed_kernel.template typeddW<KernelType>(distances[n], displacements[n]);
+    }
+
+    for (size_t n = 0; n != number_of_pairs; ++n)
+    {
+        EXPECT_EQ(W[n], typed_W[n]);
+        EXPECT_EQ(dW[n], typed_dW[n]);
+    }
+}
+
+TEST(test_TypedKernelEvaluation, test_KernelWendlandC2)
+{
+    testTypedKernelEvaluation<KernelWendlandC2>();
+}
+
+TEST(test_TypedKernelEvaluation, test_KernelCubicBSpline)
+{
+    testTypedKernelEvaluation<KernelCubicBSpline>();
+}
+
+TEST(test_TypedKernelEvaluation, test_VariableSmoothingLength)
+{
+    Real h_ratio = 2.0;
+    Real q = 0.5;
+    KernelWendlandC2 kernel(1.0);
+    Vecd displacement = Vecd::Zero();
+    displacement[0] = q / h_ratio;
+    EXPECT_DOUBLE_EQ(kernel.W(h_ratio, q / h_ratio, displacement),
+                     kernel.W(q, displacement) * pow(h_ratio, Dimensions));
+
+    kernel.reduceOnce();
+    EXPECT_DOUBLE_EQ(kernel.W(h_ratio, q / h_ratio, displacement),
+                     kernel.W(q, displacement) * pow(h_ratio, Dimensions - 1));
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -506,7 +506,7 @@ void NeighborBuilderInFVM::initializeRelation(Neighborhood &neighborhood, Real &
     neighborhood.j_[current_size] = j_index;
     neighborhood.dW_ijV_j_[current_size] = dW_ijV_j;
     neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = interface_normal_direction;
+    neighborhood.e_ij_.assign(current_size, interface_normal_direction);
 }
 //=================================================================================================//
 InnerRelationInFVM::InnerRelationInFVM(RealBody &real_body, vector<vector<vector<size_t>>> data_inpute, vector<vector<Real>> nodes_coordinates)
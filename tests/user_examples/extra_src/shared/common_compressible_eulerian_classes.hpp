@@ -29,7 +29,7 @@ void BaseIntegration1stHalf<RiemannSolverType>::interaction(size_t index_i, Real
     {
         size_t index_j = inner_neighborhood.j_[n];
         Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
 
         CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], E_[index_j]);
         CompressibleFluidStarState interface_state = riemann_solver_.getInterfaceState(state_i, state_j, e_ij);
@@ -61,7 +61,7 @@ void BaseIntegration2ndHalf<RiemannSolverType>::interaction(size_t index_i, Real
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
         size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
         Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
 
         CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], E_[index_j]);
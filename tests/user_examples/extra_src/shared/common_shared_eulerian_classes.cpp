@@ -46,7 +46,7 @@ void KernelGradientWithCorrectionInner::update(size_t index_i, Real dt)
         {
             inner_neighborhood.dW_ijV_j_[n] = kernel_gradient_with_B.norm();
         }
-        inner_neighborhood.e_ij_[n] = kernel_gradient_with_B / inner_neighborhood.dW_ijV_j_[n];
+        inner_neighborhood.e_ij_.assign(n, kernel_gradient_with_B / inner_neighborhood.dW_ijV_j_[n]);
         inner_neighborhood.r_ij_[n] = r_ji.dot(inner_neighborhood.e_ij_[n]);
     }
 }
@@ -96,7 +96,7 @@ void KernelGradientWithCorrectionComplex::update(size_t index_i, Real dt)
             {
                 contact_neighborhood.dW_ijV_j_[n] = kernel_gradient_with_B.norm();
             }
-            contact_neighborhood.e_ij_[n] = kernel_gradient_with_B / contact_neighborhood.dW_ijV_j_[n];
+            contact_neighborhood.e_ij_.assign(n, kernel_gradient_with_B / contact_neighborhood.dW_ijV_j_[n]);
             contact_neighborhood.r_ij_[n] = r_ji.dot(contact_neighborhood.e_ij_[n]);
         }
     }
@@ -85,7 +85,7 @@ void BaseIntegration1stHalf<RiemannSolverType>::interaction(size_t index_i, Real
     {
         size_t index_j = inner_neighborhood.j_[n];
         Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
 
         FluidState state_j(rho_[index_j], vel_[index_j], p_[index_j]);
         FluidStarState interface_state = riemann_solver_.getInterfaceState(state_i, state_j, e_ij);
@@ -119,7 +119,7 @@ void BaseIntegration1stHalfWithWall<BaseIntegration1stHalfType>::interaction(siz
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
 
             Vecd vel_in_wall = -state_i.vel_;
@@ -148,7 +148,7 @@ void BaseIntegration2ndHalf<RiemannSolverType>::interaction(size_t index_i, Real
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
         size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
         Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
 
         FluidState state_j(rho_[index_j], vel_[index_j], p_[index_j]);
@@ -181,7 +181,7 @@ void BaseIntegration2ndHalfWithWall<BaseIntegration2ndHalfType>::interaction(siz
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
 
             Vecd vel_in_wall = -state_i.vel_;
@@ -27,7 +27,7 @@ void BaseShearStressRelaxation1stHalfWithWall<BaseShearStressRelaxation1stHalfTy
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real r_ij = wall_neighborhood.r_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Vecd nablaW_ijV_j = wall_neighborhood.dW_ijV_j_[n] * wall_neighborhood.e_ij_[n];
@@ -58,7 +58,7 @@ void BaseShearStressRelaxation2ndHalfWithWall<BaseShearStressRelaxation2ndHalfTy
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd &e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd &e_ij = wall_neighborhood.e_ij_[n];
             Real r_ij = wall_neighborhood.r_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Vecd nablaW_ijV_j = wall_neighborhood.dW_ijV_j_[n] * wall_neighborhood.e_ij_[n];
@@ -95,7 +95,7 @@ void BaseStressRelaxation1stHalfWithWall<BaseStressRelaxation1stHalfType>::inter
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd& e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd& e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Real r_ij = wall_neighborhood.r_ij_[n];
 
@@ -129,7 +129,7 @@ void BaseStressRelaxation2ndHalfWithWall<BaseStressRelaxation2ndHalfType>::inter
         for (size_t n = 0; n != wall_neighborhood.current_size_; ++n)
         {
             size_t index_j = wall_neighborhood.j_[n];
-            Vecd& e_ij = wall_neighborhood.e_ij_[n];
+            const Vecd& e_ij = wall_neighborhood.e_ij_[n];
             Real dW_ijV_j = wall_neighborhood.dW_ijV_j_[n];
             Vecd nablaW_ijV_j = wall_neighborhood.dW_ijV_j_[n] * wall_neighborhood.e_ij_[n];
             Vecd vel_in_wall = 1.9 * vel_ave_k[index_j] - 0.9 *vel_i;
@@ -193,7 +193,7 @@ namespace SPH
                 size_t index_j = inner_neighborhood.j_[n];
                 Real r_ij = inner_neighborhood.r_ij_[n];
                 Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
-                Vecd& e_ij = inner_neighborhood.e_ij_[n];
+                const Vecd& e_ij = inner_neighborhood.e_ij_[n];
                 Real eta_ij = 2 * (0.7*(Real)Dimensions+2.1) * (vel_[index_i] - vel_[index_j]).dot(e_ij) / (r_ij + TinyReal);
                 acceleration += eta_ij * dW_ijV_j * e_ij;
             }
@@ -221,7 +221,7 @@ namespace SPH
             {
                 size_t index_j = inner_neighborhood.j_[n];
                 Real dW_ijV_j_ = inner_neighborhood.dW_ijV_j_[n];
-                Vecd& e_ij = inner_neighborhood.e_ij_[n];
+                const Vecd& e_ij = inner_neighborhood.e_ij_[n];
 
                 //Matd velocity_gradient_ij = - (vel_[index_i] - vel_[index_j]) * nablaW_ijV_j.transpose();
                 Vecd v_ij = vel_[index_i] - vel_[index_j];